@@ -0,0 +1,29 @@
+#include "MicroBenchmark.h"
+#include <src/utils/Utils.h>
+#include <openssl/evp.h>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    void Base64Benchmark()
+    {
+        const int count = 20000;
+        std::string src;
+        for (int i = 0; i < 1024; i++) {
+            src.push_back(static_cast<char>(i * 131 + 7));
+        }
+        std::string reference(4 * ((src.size() + 2) / 3) + 1, '\0');
+        const std::string encoded = Base64Encode(src);
+
+        Measure("EVP_EncodeBlock (1KB)", count, [&](int) {
+            return static_cast<size_t>(EVP_EncodeBlock(reinterpret_cast<unsigned char *>(&reference[0]),
+                reinterpret_cast<const unsigned char *>(src.data()), static_cast<int>(src.size())));
+        });
+        Measure("Base64Encode (1KB)", count, [&](int) { return Base64Encode(src).size(); });
+        Measure("Base64Decode (1KB)", count, [&](int) { return Base64Decode(encoded).size(); });
+    }
+
+    BenchmarkRegistrar base64Registrar("base64", Base64Benchmark);
+}
@@ -19,6 +19,7 @@ std::string Config::OssCfgFile = "oss.ini";
 std::string Config::Command = "";
 std::string Config::BaseLocalFile = "";
 std::string Config::BaseRemoteKey = "";
+std::string Config::Benchmark = "";
 
 int Config::PartSize = 100 * 1024 * 1024;
 int Config::Parallel = 5;
@@ -76,11 +77,11 @@ void Config::PrintHelp()
     std::cout << "                      [-k REMOTEKEY] [-p PARALLEL]      \n";
     std::cout << "                      [-m MULTITHREAD] [-partsize PARTSIZE]      \n";
     std::cout << "                      [-loop LOOPTIMES] [--persistent]      \n";
-    std::cout << "                      [--differentsource]      \n";
+    std::cout << "                      [--differentsource] [-bench NAME]      \n";
     std::cout << "Optional arguments:      \n";
     std::cout << "  -h, --help          show this help mestd::coutage and exit.           \n";
     std::cout << "  -v                  show program's version number and exit.    \n";
-    std::cout << "  -c COMMAND          Command Type : upload(up), upload_resumable(upr), upload_async(upa), download(dn), download_async(dna) .  \n";
+    std::cout << "  -c COMMAND          Command Type : upload(up), upload_resumable(upr), upload_async(upa), download(dn), download_async(dna), micro(mb) .  \n";
     std::cout << "  -b BUCKETNAME       bucket name.                \n";
     std::cout << "  -f LOCALFILE        local filename to transfer.                \n";
     std::cout << "  -k REMOTEKEY        remote object key.                         \n";
@@ -91,6 +92,7 @@ void Config::PrintHelp()
     std::cout << "  --persistent        Whether run the command persistantly.      \n";
     std::cout << "  --differentsource   Whether transfer from different source files.  \n";
     std::cout << "  -limit SPEED        Whether to limit the upload or download speed, in kB/s.  \n";
+    std::cout << "  -bench NAME         only run the micro benchmarks whose name contains NAME, needs no oss.ini.  \n";
 
 
     std::cout << "\nExamples :  \n";
@@ -109,6 +111,8 @@ void Config::PrintHelp()
     std::cout << "    cpp-sdk-ptest -c download_async -f mylocalfilename -k myobjectkeyname \n";
     std::cout << "    cpp-sdk-ptest -c dna -f mylocalfilename -k myobjectkeyname -m 5 \n";
     std::cout << "    cpp-sdk-ptest -c dn -f mylocalfilename -k myobjectkeyname -m 5 \n";
+    std::cout << "    cpp-sdk-ptest -c micro \n";
+    std::cout << "    cpp-sdk-ptest -c mb -bench sign \n";
 }
 
 void Config::PrintCfgInfo()
@@ -181,6 +185,10 @@ int Config::ParseArg(int argc, char **argv)
                 {
                     Config::Command = "download_async";
                 }
+                else if (Config::Command == "mb")
+                {
+                    Config::Command = "micro";
+                }
                 i++;
             }
             else if (!strcmp("-b", argv[i])) {
@@ -224,6 +232,10 @@ int Config::ParseArg(int argc, char **argv)
                 Config::SpeedKBPerSec = std::atoi(argv[i + 1]);
                 i++;
             }
+            else if (!strcmp("-bench", argv[i])) {
+                Config::Benchmark = argv[i + 1];
+                i++;
+            }
         }
         i++;
     };
@@ -27,6 +27,7 @@ namespace PTest
         static std::string Command;
         static std::string BaseLocalFile;
         static std::string BaseRemoteKey;
+        static std::string Benchmark;
 
         static int PartSize;
         static int Parallel;
@@ -0,0 +1,88 @@
+#include "MicroBenchmark.h"
+#include <alibabacloud/oss/http/HttpType.h>
+#include <src/http/CurlHeaderList.h>
+#include <curl/curl.h>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    HeaderCollection RequestHeaders(int extra)
+    {
+        HeaderCollection headers;
+        headers["Content-Type"] = "application/octet-stream";
+        headers["Date"] = "Thu, 01 Jan 2026 00:00:00 GMT";
+        headers["Authorization"] = "OSS ak:c2lnbmF0dXJlLXZhbHVlLTAxMjM0NTY3ODk=";
+        headers["x-oss-date"] = "20260101T000000Z";
+        for (int i = 0; i < extra; i++) {
+            headers["x-oss-meta-key" + std::to_string(i)] = "value-" + std::to_string(i);
+        }
+        return headers;
+    }
+
+    //the request setup on a reused handle, as it was and as it is now
+    void CurlHandleBenchmark()
+    {
+        const int count = 100000;
+        const auto headers = RequestHeaders(4);
+        const std::string url = "http://bucket.oss-cn-hangzhou.aliyuncs.com/object-key";
+        CURL *curl = curl_easy_init();
+        if (curl == nullptr) {
+            return;
+        }
+        int data = 0;
+
+        Measure("reset and set all options", count, [&](int) {
+            curl_easy_reset(curl);
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1);
+            curl_easy_setopt(curl, CURLOPT_NETRC, CURL_NETRC_IGNORED);
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 0L);
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 10L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+
+            curl_slist *list = nullptr;
+            for (const auto &p : headers) {
+                std::string str = p.first;
+                str.append(": ").append(p.second);
+                list = curl_slist_append(list, str.c_str());
+            }
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(curl, CURLOPT_USERAGENT, "aliyun-sdk-cpp");
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+            curl_easy_setopt(curl, CURLOPT_HEADERDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_READDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+            curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+            curl_slist_free_all(list);
+            return static_cast<size_t>(1);
+        }, true);
+
+        CurlHeaderList arena;
+        Measure("per-request options only", count, [&](int) {
+            curl_slist *list = arena.build(headers);
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+            curl_easy_setopt(curl, CURLOPT_HEADERDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_READDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &data);
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+            curl_easy_setopt(curl, CURLOPT_VERBOSE, 0L);
+            return static_cast<size_t>(1);
+        }, true);
+        curl_easy_cleanup(curl);
+    }
+
+    BenchmarkRegistrar curlHandleRegistrar("curlhandle", CurlHandleBenchmark);
+}
@@ -0,0 +1,94 @@
+#include "MicroBenchmark.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace AlibabaCloud::OSS::PTest;
+
+volatile size_t AlibabaCloud::OSS::PTest::BenchmarkSink = 0;
+
+namespace
+{
+    std::vector<std::pair<std::string, BenchmarkFunc>> &Benchmarks()
+    {
+        static std::vector<std::pair<std::string, BenchmarkFunc>> benchmarks;
+        return benchmarks;
+    }
+
+    thread_local bool countAllocs = false;
+    thread_local int64_t allocCount = 0;
+}
+
+void *operator new(std::size_t size)
+{
+    if (countAllocs) {
+        allocCount++;
+    }
+    for (;;) {
+        void *ptr = std::malloc(size ? size : 1);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            //built with -fno-exceptions, there is no bad_alloc to throw
+            std::abort();
+        }
+        handler();
+    }
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char *name, BenchmarkFunc func)
+{
+    Benchmarks().push_back(std::make_pair(std::string(name), func));
+}
+
+void AlibabaCloud::OSS::PTest::StartCountingAllocs()
+{
+    allocCount = 0;
+    countAllocs = true;
+}
+
+int64_t AlibabaCloud::OSS::PTest::StopCountingAllocs()
+{
+    countAllocs = false;
+    return allocCount;
+}
+
+void AlibabaCloud::OSS::PTest::ReportBenchmark(const std::string &label, int count,
+    std::chrono::steady_clock::duration elapsed, int64_t allocs)
+{
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count;
+    std::cout << "  " << std::left << std::setw(40) << label << std::right
+        << std::fixed << std::setprecision(1) << std::setw(12) << ns << " ns/op";
+    if (allocs >= 0) {
+        std::cout << std::setw(10) << static_cast<double>(allocs) / count << " allocs/op";
+    }
+    std::cout << std::endl;
+}
+
+int AlibabaCloud::OSS::PTest::RunMicroBenchmarks(const std::string &filter)
+{
+    int ran = 0;
+    for (const auto &bench : Benchmarks()) {
+        if (!filter.empty() && bench.first.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::cout << bench.first << std::endl;
+        bench.second();
+        ran++;
+    }
+    if (ran == 0) {
+        std::cout << "No micro benchmark matches " << filter << std::endl;
+        return 1;
+    }
+    return 0;
+}
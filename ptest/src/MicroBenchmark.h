@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+namespace PTest
+{
+    /*
+    * Offline timing loops over the SDK's per-request code paths, run by "-c micro".
+    * Nothing is sent, so no oss.ini is needed.
+    */
+    typedef void(*BenchmarkFunc)();
+
+    //registers a benchmark from a static initializer in its own file
+    class BenchmarkRegistrar
+    {
+    public:
+        BenchmarkRegistrar(const char *name, BenchmarkFunc func);
+    };
+
+    //runs the benchmarks whose name contains filter, all of them if it is empty
+    int RunMicroBenchmarks(const std::string &filter);
+
+    //counts the allocations made by the calling thread, operator new is replaced in this binary
+    void StartCountingAllocs();
+    int64_t StopCountingAllocs();
+
+    void ReportBenchmark(const std::string &label, int count,
+        std::chrono::steady_clock::duration elapsed, int64_t allocs);
+
+    extern volatile size_t BenchmarkSink;
+
+    //calls fn(i) count times and prints ns/op, and allocs/op when countAllocs is set
+    template<typename Func>
+    void Measure(const std::string &label, int count, Func fn, bool countAllocs = false)
+    {
+        size_t sink = 0;
+        if (countAllocs) {
+            StartCountingAllocs();
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            sink += fn(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        int64_t allocs = countAllocs ? StopCountingAllocs() : -1;
+        BenchmarkSink = sink;
+        ReportBenchmark(label, count, elapsed, allocs);
+    }
+}
+}
+}
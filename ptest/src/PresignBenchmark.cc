@@ -0,0 +1,38 @@
+#include "MicroBenchmark.h"
+#include <alibabacloud/oss/OssClient.h>
+#include <vector>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    void PresignBenchmark()
+    {
+        const int count = 500;
+        const int rounds = 20;
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (int i = 0; i < count; i++) {
+            keys.push_back("photos/2026/10/img-" + std::to_string(i) + ".jpg");
+        }
+        OssClient client("oss-cn-hangzhou.aliyuncs.com", "ak", "sk", ClientConfiguration());
+
+        Measure("GeneratePresignedUrl (per url)", count, [&](int i) {
+            return client.GeneratePresignedUrl("bucket", keys[i], 1700000000).result().size();
+        });
+
+        //one batch call covers every key, so it is timed per round and reported per url
+        size_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++) {
+            auto outcome = client.GeneratePresignedUrls("bucket", keys, 1700000000);
+            sink += outcome.result().Count();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        BenchmarkSink = sink;
+        ReportBenchmark("GeneratePresignedUrls (per url)", count * rounds, elapsed, -1);
+    }
+
+    BenchmarkRegistrar presignRegistrar("presign", PresignBenchmark);
+}
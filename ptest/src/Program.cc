@@ -2,6 +2,7 @@
 #include <alibabacloud/oss/client/RateLimiter.h>
 #include <iostream>
 #include "Config.h"
+#include "MicroBenchmark.h"
 #include <fstream>
 #include <future>
 #include <thread>
@@ -496,6 +497,13 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    if (Config::Command == "micro") {
+        AlibabaCloud::OSS::InitializeSdk();
+        int ret = RunMicroBenchmarks(Config::Benchmark);
+        AlibabaCloud::OSS::ShutdownSdk();
+        return ret;
+    }
+
     if (Config::LoadCfgFile() != 0) {
         return 0;
     }
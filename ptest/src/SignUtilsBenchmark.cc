@@ -0,0 +1,102 @@
+#include "MicroBenchmark.h"
+#include <src/utils/SignUtils.h>
+#include <src/utils/Utils.h>
+#include <alibabacloud/oss/http/HttpType.h>
+#include <sstream>
+#include <set>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    //the stringstream based canonicalizer SignUtils used to be
+    std::string ReferenceBuild(const std::string &method, const std::string &resource, const std::string &date,
+        const HeaderCollection &headers, const ParameterCollection &parameters)
+    {
+        static const std::set<std::string> toSign =
+        {
+            "acl", "location", "bucketInfo", "stat", "referer", "cors", "website", "restore",
+            "logging", "symlink", "qos", "uploadId", "uploads", "partNumber",
+            "response-content-type", "response-content-language", "response-expires",
+            "response-cache-control", "response-content-disposition", "response-content-encoding",
+            "append", "position", "lifecycle", "delete", "live", "status", "comp", "vod",
+            "startTime", "endTime", "x-oss-process", "security-token", "objectMeta"
+        };
+        std::stringstream ss;
+        ss << method << "\n";
+        if (headers.find(Http::CONTENT_MD5) != headers.end()) {
+            ss << headers.at(Http::CONTENT_MD5);
+        }
+        ss << "\n";
+        if (headers.find(Http::CONTENT_TYPE) != headers.end()) {
+            ss << headers.at(Http::CONTENT_TYPE);
+        }
+        ss << "\n" << date << "\n";
+        for (const auto &header : headers) {
+            std::string lower = Trim(ToLower(header.first.c_str()).c_str());
+            if (lower.compare(0, 6, "x-oss-", 6) == 0) {
+                ss << lower << ":" << Trim(header.second.c_str()) << "\n";
+            }
+        }
+        ss << resource;
+        char separator = '?';
+        for (auto const& param : parameters) {
+            if (toSign.find(param.first) == toSign.end()) {
+                continue;
+            }
+            ss << separator << param.first;
+            if (!param.second.empty()) {
+                ss << "=" << param.second;
+            }
+            separator = '&';
+        }
+        return ss.str();
+    }
+
+    HeaderCollection SampleHeaders()
+    {
+        HeaderCollection headers;
+        headers[Http::CONTENT_MD5] = "eB5eJF1ptWaXm4bijSPyxw==";
+        headers[Http::CONTENT_TYPE] = "text/html";
+        headers[Http::DATE] = "Thu, 17 Nov 2005 18:49:58 GMT";
+        headers["X-OSS-Meta-Author"] = " foo@bar.com ";
+        headers["x-oss-magic"] = "abracadabra";
+        headers["x-oss"] = "not an oss header";
+        headers["X-Oss-Security-Token"] = "token";
+        headers["Host"] = "bucket.oss-cn-hangzhou.aliyuncs.com";
+        return headers;
+    }
+
+    ParameterCollection SampleParameters()
+    {
+        ParameterCollection parameters;
+        parameters["acl"] = "";
+        parameters["uploadId"] = "0004B9895DBBB6EC98E36";
+        parameters["partNumber"] = "1";
+        parameters["response-content-type"] = "text/plain";
+        parameters["max-keys"] = "100";
+        parameters["x-oss-process"] = "image/resize,w_100";
+        parameters["Acl"] = "";
+        return parameters;
+    }
+
+    void CanonicalBenchmark()
+    {
+        const int count = 50000;
+        auto headers = SampleHeaders();
+        auto parameters = SampleParameters();
+        const std::string date = "Thu, 17 Nov 2005 18:49:58 GMT";
+
+        Measure("stringstream", count, [&](int) {
+            return ReferenceBuild("PUT", "/bucket/key", date, headers, parameters).size();
+        }, true);
+        Measure("SignUtils", count, [&](int) {
+            SignUtils signUtils("1.0");
+            signUtils.build("PUT", "/bucket/key", date, headers, parameters);
+            return signUtils.CanonicalString().size();
+        }, true);
+    }
+
+    BenchmarkRegistrar canonicalRegistrar("canonical", CanonicalBenchmark);
+}
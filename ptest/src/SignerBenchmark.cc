@@ -0,0 +1,35 @@
+#include "MicroBenchmark.h"
+#include <src/auth/HmacSha1Signer.h>
+#include <openssl/hmac.h>
+#include <openssl/evp.h>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    //what HmacSha1Signer did before it kept a per-thread HMAC context
+    std::string OneShotSign(const std::string &src, const std::string &secret)
+    {
+        unsigned char md[EVP_MAX_MD_SIZE];
+        unsigned int mdLen = EVP_MAX_MD_SIZE;
+        HMAC(EVP_sha1(), secret.c_str(), static_cast<int>(secret.size()),
+            reinterpret_cast<const unsigned char*>(src.c_str()), src.size(), md, &mdLen);
+        char encodedData[100];
+        EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encodedData), md, mdLen);
+        return encodedData;
+    }
+
+    void SignBenchmark()
+    {
+        const int count = 100000;
+        const std::string secret = "ThisIsASecretKeyForBenchmark0123";
+        const std::string src = "GET\n\n\nThu, 01 Jan 2026 00:00:00 GMT\nx-oss-date:20260101\n/bucket/object-key";
+        HmacSha1Signer signer;
+
+        Measure("one-shot HMAC", count, [&](int) { return OneShotSign(src, secret).size(); });
+        Measure("HmacSha1Signer", count, [&](int) { return signer.generate(src, secret).size(); });
+    }
+
+    BenchmarkRegistrar signRegistrar("sign", SignBenchmark);
+}
@@ -0,0 +1,47 @@
+#include "MicroBenchmark.h"
+#include <src/utils/Utils.h>
+#include <cctype>
+#include <sstream>
+
+using namespace AlibabaCloud::OSS;
+using namespace AlibabaCloud::OSS::PTest;
+
+namespace
+{
+    //the stringstream based encoder UrlEncode used to be
+    std::string ReferenceUrlEncode(const std::string &src)
+    {
+        std::stringstream dest;
+        static const char *hex = "0123456789ABCDEF";
+        for (size_t i = 0; i < src.size(); i++) {
+            unsigned char c = src[i];
+            if (isalnum(c) || (c == '-') || (c == '_') || (c == '.') || (c == '~')) {
+                dest << c;
+            } else {
+                dest << '%' << hex[c >> 4] << hex[c & 15];
+            }
+        }
+        return dest.str();
+    }
+
+    void UrlCodecBenchmark()
+    {
+        const int count = 20000;
+        std::string plain;
+        std::string mixed;
+        for (int i = 0; i < 16; i++) {
+            plain.append("photos/2026/october/holiday-trip/IMG_").append(std::to_string(1000 + i)).append(".jpeg");
+            mixed.append("\xe7\x85\xa7\xe7\x89\x87/2026 10/\xe6\x97\x85\xe8\xa1\x8c (").append(std::to_string(i)).append(").jpeg");
+        }
+
+        for (auto const &src : { plain, mixed }) {
+            const std::string suffix = std::string(" (") + std::to_string(src.size()) + " bytes key)";
+            const std::string encoded = UrlEncode(src);
+            Measure("stringstream encode" + suffix, count, [&](int) { return ReferenceUrlEncode(src).size(); });
+            Measure("UrlEncode" + suffix, count, [&](int) { return UrlEncode(src).size(); });
+            Measure("UrlDecode" + suffix, count, [&](int) { return UrlDecode(encoded).size(); });
+        }
+    }
+
+    BenchmarkRegistrar urlCodecRegistrar("urlcodec", UrlCodecBenchmark);
+}
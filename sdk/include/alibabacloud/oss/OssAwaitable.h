@@ -0,0 +1,123 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/CancellationToken.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * co_await support for the OssClient Async APIs, only available when the
+    * application is built as C++20. The SDK itself stays C++11.
+    *
+    *   auto outcome = co_await Await(client, &OssClient::HeadObjectAsync, HeadObjectRequest(bucket, key));
+    *
+    * The request is issued on the client's executor and the coroutine is resumed
+    * on the SDK thread which completes it, or handed to the scheduler if one is given,
+    * so no thread waits for the response.
+    *
+    * With a cancellation token, cancel() aborts the request and the coroutine is resumed
+    * with the "ClientError:100004" outcome, as soon as the transfer, the retry wait or
+    * the queued task notices it.
+    */
+    template<typename Request, typename Outcome>
+    class OssAwaitable
+    {
+    public:
+        using Handler = std::function<void(const OssClient*, const Request&, const Outcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+        using AsyncCall = void (OssClient::*)(const Request&, const Handler&, const std::shared_ptr<const AsyncCallerContext>&) const;
+        using Scheduler = std::function<void(std::coroutine_handle<>)>;
+
+        OssAwaitable(const OssClient &client, AsyncCall call, const Request &request,
+            const Scheduler &scheduler, const std::shared_ptr<const AsyncCallerContext> &context) :
+            client_(&client),
+            call_(call),
+            request_(request),
+            scheduler_(scheduler),
+            context_(context)
+        {
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            //the awaiter may be gone as soon as the handle is resumed, so the handler owns the scheduler
+            auto scheduler = scheduler_;
+            Outcome *outcome = &outcome_;
+            (client_->*call_)(request_, [outcome, handle, scheduler](const OssClient*, const Request&,
+                const Outcome &result, const std::shared_ptr<const AsyncCallerContext>&)
+            {
+                *outcome = result;
+                if (scheduler) {
+                    scheduler(handle);
+                }
+                else {
+                    handle.resume();
+                }
+            }, context_);
+        }
+
+        Outcome await_resume() { return std::move(outcome_); }
+
+        void setCancellationToken(const std::shared_ptr<CancellationToken> &token)
+        {
+            request_.setCancellationToken(token);
+        }
+
+    private:
+        const OssClient *client_;
+        AsyncCall call_;
+        Request request_;
+        Scheduler scheduler_;
+        std::shared_ptr<const AsyncCallerContext> context_;
+        Outcome outcome_;
+    };
+
+    template<typename Request, typename Outcome>
+    OssAwaitable<Request, Outcome> Await(const OssClient &client,
+        void (OssClient::*call)(const Request&, const std::function<void(const OssClient*, const Request&, const Outcome&, const std::shared_ptr<const AsyncCallerContext>&)>&, const std::shared_ptr<const AsyncCallerContext>&) const,
+        const Request &request,
+        const typename OssAwaitable<Request, Outcome>::Scheduler &scheduler = nullptr,
+        const std::shared_ptr<const AsyncCallerContext> &context = nullptr)
+    {
+        return OssAwaitable<Request, Outcome>(client, call, request, scheduler, context);
+    }
+
+    template<typename Request, typename Outcome>
+    OssAwaitable<Request, Outcome> Await(const OssClient &client,
+        void (OssClient::*call)(const Request&, const std::function<void(const OssClient*, const Request&, const Outcome&, const std::shared_ptr<const AsyncCallerContext>&)>&, const std::shared_ptr<const AsyncCallerContext>&) const,
+        const Request &request,
+        const std::shared_ptr<CancellationToken> &token,
+        const typename OssAwaitable<Request, Outcome>::Scheduler &scheduler = nullptr,
+        const std::shared_ptr<const AsyncCallerContext> &context = nullptr)
+    {
+        OssAwaitable<Request, Outcome> awaitable(client, call, request, scheduler, context);
+        awaitable.setCancellationToken(token);
+        return awaitable;
+    }
+}
+}
+#endif
@@ -36,6 +36,8 @@ namespace OSS
     /*Log*/
     void ALIBABACLOUD_OSS_EXPORT SetLogLevel(LogLevel level);
     void ALIBABACLOUD_OSS_EXPORT SetLogCallback(LogCallback callback);
+    /*The callback is called on a background thread, wait until the pending records are delivered*/
+    void ALIBABACLOUD_OSS_EXPORT FlushLog();
 
     /*Utils*/
     std::string ALIBABACLOUD_OSS_EXPORT ComputeContentMD5(const char *data, size_t size);
@@ -48,6 +50,8 @@ namespace OSS
     std::string ALIBABACLOUD_OSS_EXPORT Base64Encode(const char* src, int len);
     std::string ALIBABACLOUD_OSS_EXPORT Base64EncodeUrlSafe(const std::string& src);
     std::string ALIBABACLOUD_OSS_EXPORT Base64EncodeUrlSafe(const char* src, int len);
+    std::string ALIBABACLOUD_OSS_EXPORT Base64Decode(const std::string& src);
+    std::string ALIBABACLOUD_OSS_EXPORT Base64DecodeUrlSafe(const std::string& src);
     std::string ALIBABACLOUD_OSS_EXPORT ToGmtTime(std::time_t& t);
     std::string ALIBABACLOUD_OSS_EXPORT ToUtcTime(std::time_t& t);
     uint64_t    ALIBABACLOUD_OSS_EXPORT ComputeCRC64(uint64_t crc, void* buf, size_t len);
@@ -60,12 +64,78 @@ namespace OSS
     using PutObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const PutObjectRequest&, const PutObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
     using UploadPartAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const UploadPartRequest&, const PutObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
     using UploadPartCopyAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const UploadPartCopyRequest&, const UploadPartCopyOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using ListBucketsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const ListBucketsRequest&, const ListBucketsOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using CreateBucketAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const CreateBucketRequest&, const CreateBucketOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketAclAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketAclRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketLoggingAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketLoggingRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketWebsiteAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketWebsiteRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketRefererAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketRefererRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketLifecycleAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketLifecycleRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketCorsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketCorsRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetBucketStorageCapacityAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetBucketStorageCapacityRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteBucketAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteBucketRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteBucketLoggingAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteBucketLoggingRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteBucketWebsiteAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteBucketWebsiteRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteBucketLifecycleAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteBucketLifecycleRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteBucketCorsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteBucketCorsRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketAclAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketAclRequest&, const GetBucketAclOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketLocationAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketLocationRequest&, const GetBucketLocationOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketInfoAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketInfoRequest&, const GetBucketInfoOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketLoggingAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketLoggingRequest&, const GetBucketLoggingOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketWebsiteAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketWebsiteRequest&, const GetBucketWebsiteOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketRefererAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketRefererRequest&, const GetBucketRefererOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketLifecycleAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketLifecycleRequest&, const GetBucketLifecycleOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketStatAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketStatRequest&, const GetBucketStatOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketCorsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketCorsRequest&, const GetBucketCorsOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetBucketStorageCapacityAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetBucketStorageCapacityRequest&, const GetBucketStorageCapacityOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteObjectRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using DeleteObjectsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const DeleteObjectsRequest&, const DeleteObjecstOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using HeadObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const HeadObjectRequest&, const ObjectMetaDataOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetObjectMetaAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetObjectMetaRequest&, const ObjectMetaDataOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using AppendObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const AppendObjectRequest&, const AppendObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using CopyObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const CopyObjectRequest&, const CopyObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using RestoreObjectAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const RestoreObjectRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using SetObjectAclAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const SetObjectAclRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetObjectAclAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetObjectAclRequest&, const GetObjectAclOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using CreateSymlinkAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const CreateSymlinkRequest&, const CreateSymlinkOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetSymlinkAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetSymlinkRequest&, const GetSymlinkOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using InitiateMultipartUploadAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const InitiateMultipartUploadRequest&, const InitiateMultipartUploadOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using CompleteMultipartUploadAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const CompleteMultipartUploadRequest&, const CompleteMultipartUploadOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using AbortMultipartUploadAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const AbortMultipartUploadRequest&, const VoidOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using ListMultipartUploadsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const ListMultipartUploadsRequest&, const ListMultipartUploadsOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using ListPartsAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const ListPartsRequest&, const ListPartsOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using GetObjectByUrlAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const GetObjectByUrlRequest&, const GetObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
+    using PutObjectByUrlAsyncHandler = std::function<void(const AlibabaCloud::OSS::OssClient*, const PutObjectByUrlRequest&, const PutObjectOutcome&, const std::shared_ptr<const AsyncCallerContext>&)>;
 
     /*Callable*/
     using ListObjectOutcomeCallable = std::future<ListObjectOutcome>;
     using GetObjectOutcomeCallable  = std::future<GetObjectOutcome>;
     using PutObjectOutcomeCallable  = std::future<PutObjectOutcome>;
     using UploadPartCopyOutcomeCallable = std::future<UploadPartCopyOutcome>;
+    using ListBucketsOutcomeCallable = std::future<ListBucketsOutcome>;
+    using CreateBucketOutcomeCallable = std::future<CreateBucketOutcome>;
+    using VoidOutcomeCallable = std::future<VoidOutcome>;
+    using GetBucketAclOutcomeCallable = std::future<GetBucketAclOutcome>;
+    using GetBucketLocationOutcomeCallable = std::future<GetBucketLocationOutcome>;
+    using GetBucketInfoOutcomeCallable = std::future<GetBucketInfoOutcome>;
+    using GetBucketLoggingOutcomeCallable = std::future<GetBucketLoggingOutcome>;
+    using GetBucketWebsiteOutcomeCallable = std::future<GetBucketWebsiteOutcome>;
+    using GetBucketRefererOutcomeCallable = std::future<GetBucketRefererOutcome>;
+    using GetBucketLifecycleOutcomeCallable = std::future<GetBucketLifecycleOutcome>;
+    using GetBucketStatOutcomeCallable = std::future<GetBucketStatOutcome>;
+    using GetBucketCorsOutcomeCallable = std::future<GetBucketCorsOutcome>;
+    using GetBucketStorageCapacityOutcomeCallable = std::future<GetBucketStorageCapacityOutcome>;
+    using DeleteObjecstOutcomeCallable = std::future<DeleteObjecstOutcome>;
+    using ObjectMetaDataOutcomeCallable = std::future<ObjectMetaDataOutcome>;
+    using AppendObjectOutcomeCallable = std::future<AppendObjectOutcome>;
+    using CopyObjectOutcomeCallable = std::future<CopyObjectOutcome>;
+    using GetObjectAclOutcomeCallable = std::future<GetObjectAclOutcome>;
+    using CreateSymlinkOutcomeCallable = std::future<CreateSymlinkOutcome>;
+    using GetSymlinkOutcomeCallable = std::future<GetSymlinkOutcome>;
+    using InitiateMultipartUploadOutcomeCallable = std::future<InitiateMultipartUploadOutcome>;
+    using CompleteMultipartUploadOutcomeCallable = std::future<CompleteMultipartUploadOutcome>;
+    using ListMultipartUploadsOutcomeCallable = std::future<ListMultipartUploadsOutcome>;
+    using ListPartsOutcomeCallable = std::future<ListPartsOutcome>;
 
     class OssClientImpl;
     class ALIBABACLOUD_OSS_EXPORT OssClient
@@ -179,6 +249,8 @@ namespace OSS
         StringOutcome GeneratePresignedUrl(const std::string& bucket, const std::string& key) const;
         StringOutcome GeneratePresignedUrl(const std::string& bucket, const std::string& key, int64_t expires) const;
         StringOutcome GeneratePresignedUrl(const std::string& bucket, const std::string& key, int64_t expires, Http::Method method) const;
+        PresignedUrlListOutcome GeneratePresignedUrls(const std::string& bucket, const std::vector<std::string>& keys, int64_t expires) const;
+        PresignedUrlListOutcome GeneratePresignedUrls(const std::string& bucket, const std::vector<std::string>& keys, int64_t expires, Http::Method method) const;
         GetObjectOutcome GetObjectByUrl(const GetObjectByUrlRequest& request) const;
         GetObjectOutcome GetObjectByUrl(const std::string& url) const;
         GetObjectOutcome GetObjectByUrl(const std::string& url, const std::string& file) const;
@@ -195,18 +267,102 @@ namespace OSS
         /*Live Channel*/
 
         /*Aysnc APIs*/
+        void ListBucketsAsync(const ListBucketsRequest& request, const ListBucketsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void CreateBucketAsync(const CreateBucketRequest& request, const CreateBucketAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
         void ListObjectsAsync(const ListObjectsRequest& request, const ListObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketAclAsync(const SetBucketAclRequest& request, const SetBucketAclAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketLoggingAsync(const SetBucketLoggingRequest& request, const SetBucketLoggingAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketWebsiteAsync(const SetBucketWebsiteRequest& request, const SetBucketWebsiteAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketRefererAsync(const SetBucketRefererRequest& request, const SetBucketRefererAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketLifecycleAsync(const SetBucketLifecycleRequest& request, const SetBucketLifecycleAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketCorsAsync(const SetBucketCorsRequest& request, const SetBucketCorsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetBucketStorageCapacityAsync(const SetBucketStorageCapacityRequest& request, const SetBucketStorageCapacityAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteBucketAsync(const DeleteBucketRequest& request, const DeleteBucketAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteBucketLoggingAsync(const DeleteBucketLoggingRequest& request, const DeleteBucketLoggingAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteBucketWebsiteAsync(const DeleteBucketWebsiteRequest& request, const DeleteBucketWebsiteAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteBucketLifecycleAsync(const DeleteBucketLifecycleRequest& request, const DeleteBucketLifecycleAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteBucketCorsAsync(const DeleteBucketCorsRequest& request, const DeleteBucketCorsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketAclAsync(const GetBucketAclRequest& request, const GetBucketAclAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketLocationAsync(const GetBucketLocationRequest& request, const GetBucketLocationAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketInfoAsync(const GetBucketInfoRequest& request, const GetBucketInfoAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketLoggingAsync(const GetBucketLoggingRequest& request, const GetBucketLoggingAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketWebsiteAsync(const GetBucketWebsiteRequest& request, const GetBucketWebsiteAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketRefererAsync(const GetBucketRefererRequest& request, const GetBucketRefererAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketLifecycleAsync(const GetBucketLifecycleRequest& request, const GetBucketLifecycleAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketStatAsync(const GetBucketStatRequest& request, const GetBucketStatAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketCorsAsync(const GetBucketCorsRequest& request, const GetBucketCorsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetBucketStorageCapacityAsync(const GetBucketStorageCapacityRequest& request, const GetBucketStorageCapacityAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
         void GetObjectAsync(const GetObjectRequest& request, const GetObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
         void PutObjectAsync(const PutObjectRequest& request, const PutObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteObjectAsync(const DeleteObjectRequest& request, const DeleteObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void DeleteObjectsAsync(const DeleteObjectsRequest& request, const DeleteObjectsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void HeadObjectAsync(const HeadObjectRequest& request, const HeadObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetObjectMetaAsync(const GetObjectMetaRequest& request, const GetObjectMetaAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void AppendObjectAsync(const AppendObjectRequest& request, const AppendObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void CopyObjectAsync(const CopyObjectRequest& request, const CopyObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void RestoreObjectAsync(const RestoreObjectRequest& request, const RestoreObjectAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void SetObjectAclAsync(const SetObjectAclRequest& request, const SetObjectAclAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetObjectAclAsync(const GetObjectAclRequest& request, const GetObjectAclAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void CreateSymlinkAsync(const CreateSymlinkRequest& request, const CreateSymlinkAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetSymlinkAsync(const GetSymlinkRequest& request, const GetSymlinkAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void InitiateMultipartUploadAsync(const InitiateMultipartUploadRequest& request, const InitiateMultipartUploadAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
         void UploadPartAsync(const UploadPartRequest& request, const UploadPartAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
         void UploadPartCopyAsync(const UploadPartCopyRequest& request, const UploadPartCopyAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void CompleteMultipartUploadAsync(const CompleteMultipartUploadRequest& request, const CompleteMultipartUploadAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void AbortMultipartUploadAsync(const AbortMultipartUploadRequest& request, const AbortMultipartUploadAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void ListMultipartUploadsAsync(const ListMultipartUploadsRequest& request, const ListMultipartUploadsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void ListPartsAsync(const ListPartsRequest& request, const ListPartsAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void GetObjectByUrlAsync(const GetObjectByUrlRequest& request, const GetObjectByUrlAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
+        void PutObjectByUrlAsync(const PutObjectByUrlRequest& request, const PutObjectByUrlAsyncHandler& handler, const std::shared_ptr<const AsyncCallerContext>& context = nullptr) const;
 
         /*Callable APIs*/
+        ListBucketsOutcomeCallable ListBucketsCallable(const ListBucketsRequest& request) const;
+        CreateBucketOutcomeCallable CreateBucketCallable(const CreateBucketRequest& request) const;
         ListObjectOutcomeCallable ListObjectsCallable(const ListObjectsRequest& request) const;
+        VoidOutcomeCallable SetBucketAclCallable(const SetBucketAclRequest& request) const;
+        VoidOutcomeCallable SetBucketLoggingCallable(const SetBucketLoggingRequest& request) const;
+        VoidOutcomeCallable SetBucketWebsiteCallable(const SetBucketWebsiteRequest& request) const;
+        VoidOutcomeCallable SetBucketRefererCallable(const SetBucketRefererRequest& request) const;
+        VoidOutcomeCallable SetBucketLifecycleCallable(const SetBucketLifecycleRequest& request) const;
+        VoidOutcomeCallable SetBucketCorsCallable(const SetBucketCorsRequest& request) const;
+        VoidOutcomeCallable SetBucketStorageCapacityCallable(const SetBucketStorageCapacityRequest& request) const;
+        VoidOutcomeCallable DeleteBucketCallable(const DeleteBucketRequest& request) const;
+        VoidOutcomeCallable DeleteBucketLoggingCallable(const DeleteBucketLoggingRequest& request) const;
+        VoidOutcomeCallable DeleteBucketWebsiteCallable(const DeleteBucketWebsiteRequest& request) const;
+        VoidOutcomeCallable DeleteBucketLifecycleCallable(const DeleteBucketLifecycleRequest& request) const;
+        VoidOutcomeCallable DeleteBucketCorsCallable(const DeleteBucketCorsRequest& request) const;
+        GetBucketAclOutcomeCallable GetBucketAclCallable(const GetBucketAclRequest& request) const;
+        GetBucketLocationOutcomeCallable GetBucketLocationCallable(const GetBucketLocationRequest& request) const;
+        GetBucketInfoOutcomeCallable GetBucketInfoCallable(const GetBucketInfoRequest& request) const;
+        GetBucketLoggingOutcomeCallable GetBucketLoggingCallable(const GetBucketLoggingRequest& request) const;
+        GetBucketWebsiteOutcomeCallable GetBucketWebsiteCallable(const GetBucketWebsiteRequest& request) const;
+        GetBucketRefererOutcomeCallable GetBucketRefererCallable(const GetBucketRefererRequest& request) const;
+        GetBucketLifecycleOutcomeCallable GetBucketLifecycleCallable(const GetBucketLifecycleRequest& request) const;
+        GetBucketStatOutcomeCallable GetBucketStatCallable(const GetBucketStatRequest& request) const;
+        GetBucketCorsOutcomeCallable GetBucketCorsCallable(const GetBucketCorsRequest& request) const;
+        GetBucketStorageCapacityOutcomeCallable GetBucketStorageCapacityCallable(const GetBucketStorageCapacityRequest& request) const;
         GetObjectOutcomeCallable GetObjectCallable(const GetObjectRequest& request) const;
         PutObjectOutcomeCallable PutObjectCallable(const PutObjectRequest& request) const;
+        VoidOutcomeCallable DeleteObjectCallable(const DeleteObjectRequest& request) const;
+        DeleteObjecstOutcomeCallable DeleteObjectsCallable(const DeleteObjectsRequest& request) const;
+        ObjectMetaDataOutcomeCallable HeadObjectCallable(const HeadObjectRequest& request) const;
+        ObjectMetaDataOutcomeCallable GetObjectMetaCallable(const GetObjectMetaRequest& request) const;
+        AppendObjectOutcomeCallable AppendObjectCallable(const AppendObjectRequest& request) const;
+        CopyObjectOutcomeCallable CopyObjectCallable(const CopyObjectRequest& request) const;
+        VoidOutcomeCallable RestoreObjectCallable(const RestoreObjectRequest& request) const;
+        VoidOutcomeCallable SetObjectAclCallable(const SetObjectAclRequest& request) const;
+        GetObjectAclOutcomeCallable GetObjectAclCallable(const GetObjectAclRequest& request) const;
+        CreateSymlinkOutcomeCallable CreateSymlinkCallable(const CreateSymlinkRequest& request) const;
+        GetSymlinkOutcomeCallable GetSymlinkCallable(const GetSymlinkRequest& request) const;
+        InitiateMultipartUploadOutcomeCallable InitiateMultipartUploadCallable(const InitiateMultipartUploadRequest& request) const;
         PutObjectOutcomeCallable UploadPartCallable(const UploadPartRequest& request) const;
         UploadPartCopyOutcomeCallable UploadPartCopyCallable(const UploadPartCopyRequest& request) const;
+        CompleteMultipartUploadOutcomeCallable CompleteMultipartUploadCallable(const CompleteMultipartUploadRequest& request) const;
+        VoidOutcomeCallable AbortMultipartUploadCallable(const AbortMultipartUploadRequest& request) const;
+        ListMultipartUploadsOutcomeCallable ListMultipartUploadsCallable(const ListMultipartUploadsRequest& request) const;
+        ListPartsOutcomeCallable ListPartsCallable(const ListPartsRequest& request) const;
+        GetObjectOutcomeCallable GetObjectByUrlCallable(const GetObjectByUrlRequest& request) const;
+        PutObjectOutcomeCallable PutObjectByUrlCallable(const PutObjectByUrlRequest& request) const;
 
         /*Extended APIs*/
         bool DoesBucketExist(const std::string& bucket) const;
@@ -71,6 +71,7 @@
 #include <alibabacloud/oss/model/HeadObjectRequest.h>
 #include <alibabacloud/oss/model/GetObjectMetaRequest.h>
 #include <alibabacloud/oss/model/GeneratePresignedUrlRequest.h>
+#include <alibabacloud/oss/model/PresignedUrlList.h>
 #include <alibabacloud/oss/model/GetObjectByUrlRequest.h>
 #include <alibabacloud/oss/model/PutObjectByUrlRequest.h>
 #include <alibabacloud/oss/model/GetObjectAclRequest.h>
@@ -140,5 +141,8 @@ namespace OSS
     using CompleteMultipartUploadOutcome = Outcome<OssError, CompleteMultipartUploadResult>;
     using ListMultipartUploadsOutcome = Outcome<OssError, ListMultipartUploadsResult>;
     using ListPartsOutcome = Outcome<OssError, ListPartsResult>;
+
+    /*presigned url*/
+    using PresignedUrlListOutcome = Outcome<OssError, PresignedUrlList>;
 }
 }
@@ -18,8 +18,10 @@
 
 #include <memory>
 #include <iostream>
+#include <chrono>
 #include <alibabacloud/oss/Export.h>
 #include <alibabacloud/oss/Types.h>
+#include <alibabacloud/oss/client/Tracer.h>
 
 namespace AlibabaCloud
 {
@@ -29,6 +31,8 @@ namespace OSS
     const int REQUEST_FLAG_PARAM_IN_PATH = (1 << 1);
     const int REQUEST_FLAG_CHECK_CRC64   = (1 << 2);
 
+    class CancellationToken;
+
     class ALIBABACLOUD_OSS_EXPORT ServiceRequest
     {
     public:
@@ -47,6 +51,18 @@ namespace OSS
         
         const AlibabaCloud::OSS::TransferProgress& TransferProgress() const;
         void setTransferProgress(const AlibabaCloud::OSS::TransferProgress& arg);
+
+        const std::shared_ptr<AlibabaCloud::OSS::CancellationToken>& CancellationToken() const;
+        void setCancellationToken(const std::shared_ptr<AlibabaCloud::OSS::CancellationToken>& token);
+
+        /*the request, retries included, fails once the deadline has passed*/
+        const std::chrono::steady_clock::time_point& Deadline() const;
+        void setDeadline(const std::chrono::steady_clock::time_point& deadline);
+        bool hasDeadline() const;
+
+        /*the parent of the request's spans when the client has a tracer*/
+        const SpanContext& TraceContext() const;
+        void setTraceContext(const SpanContext& context);
     protected:
         ServiceRequest();
         void setPath(const std::string &path);
@@ -55,6 +71,9 @@ namespace OSS
         std::string path_;
         IOStreamFactory responseStreamFactory_;
         AlibabaCloud::OSS::TransferProgress transferProgress_;
+        std::shared_ptr<AlibabaCloud::OSS::CancellationToken> cancellationToken_;
+        std::chrono::steady_clock::time_point deadline_;
+        SpanContext traceContext_;
     };
 }
 }
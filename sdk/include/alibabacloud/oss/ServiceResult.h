@@ -19,6 +19,7 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <utility>
 
 namespace AlibabaCloud
 {
@@ -38,6 +39,7 @@ namespace OSS
         void setRequestId(const std::string& requestId) {requestId_ = requestId;}
         void setPlayload(const std::shared_ptr<std::iostream>& payload) {payload_ = payload;}
         void setHeaderCollection(const HeaderCollection& values) { headerCollection_ = values;}
+        void setHeaderCollection(HeaderCollection&& values) { headerCollection_ = std::move(values);}
         void setResponseCode(const int code) { responseCode_ = code;} 
     private:
         std::string requestId_;
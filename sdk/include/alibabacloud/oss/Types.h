@@ -23,6 +23,7 @@
 #include <memory>
 #include <functional>
 #include <alibabacloud/oss/Export.h>
+#include <alibabacloud/oss/utils/HeaderCollection.h>
 
 namespace AlibabaCloud
 {
@@ -99,8 +100,11 @@ namespace OSS
             while (first1 != last1) {
                 if (first2 == last2)
                     return false;
-                auto first1_ch = ::tolower(*first1);
-                auto first2_ch = ::tolower(*first2);
+                //ascii only, as ::tolower in the C locale, without a call per char
+                unsigned char first1_ch = static_cast<unsigned char>(*first1);
+                unsigned char first2_ch = static_cast<unsigned char>(*first2);
+                if (first1_ch >= 'A' && first1_ch <= 'Z') first1_ch += 'a' - 'A';
+                if (first2_ch >= 'A' && first2_ch <= 'Z') first2_ch += 'a' - 'A';
                 if (first1_ch != first2_ch) {
                     return (first1_ch < first2_ch);
                 }
@@ -119,7 +123,6 @@ namespace OSS
 
     using RefererList = std::vector<std::string>;
     using MetaData = std::map<std::string, std::string, caseInsensitiveLess>;
-    using HeaderCollection = std::map<std::string, std::string, caseInsensitiveLess>;
     using ParameterCollection = std::map<std::string, std::string, caseSensitiveLess>;
     using IOStreamFactory = std::function< std::shared_ptr<std::iostream>(void)>;
 
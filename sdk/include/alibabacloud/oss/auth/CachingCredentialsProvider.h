@@ -0,0 +1,84 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ctime>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+#include <alibabacloud/oss/auth/CredentialsProvider.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * Fetches temporary credentials (e.g. STS tokens) and refreshes them from a
+    * background thread before they expire, so getCredentials never waits on a fetch.
+    * The current credentials are an immutable snapshot swapped with the shared_ptr
+    * atomic functions, which guard the pointer copy with a short internal lock.
+    */
+    class ALIBABACLOUD_OSS_EXPORT CachingCredentialsProvider : public CredentialsProvider
+    {
+    public:
+        /*
+        * Returns false on failure, otherwise fills the credentials
+        * and their expiration in seconds since the epoch.
+        */
+        using CredentialsFetcher = std::function<bool(Credentials &credentials, std::time_t &expiration)>;
+
+        /*
+        * fetcher        : called once from the constructor, then from the refresh thread.
+        * refreshAheadSec: how long before the expiration the credentials are refreshed.
+        * maxJitterSec   : a random extra advance, so clients do not refresh all at once.
+        * retryDelaySec  : wait between failed fetches.
+        */
+        CachingCredentialsProvider(const CredentialsFetcher &fetcher, long refreshAheadSec = 300,
+            long maxJitterSec = 60, long retryDelaySec = 5);
+        ~CachingCredentialsProvider();
+
+        virtual Credentials getCredentials() override;
+        virtual std::shared_ptr<const Credentials> getCredentialsSnapshot() override;
+        std::time_t Expiration() const;
+
+        /*
+        * Fetches from an ECS RAM role style metadata url, which returns the json
+        * {"Code":"Success","AccessKeyId":..,"AccessKeySecret":..,"SecurityToken":..,"Expiration":"2017-11-01T05:20:01Z"}
+        */
+        static CredentialsFetcher MetadataUrlFetcher(const std::string &url, long timeoutMs = 5000);
+    private:
+        CachingCredentialsProvider(const CachingCredentialsProvider&) = delete;
+        CachingCredentialsProvider& operator = (const CachingCredentialsProvider&) = delete;
+        bool refresh();
+        long nextRefreshDelaySec();
+        void refreshLoop();
+
+        CredentialsFetcher fetcher_;
+        long refreshAheadSec_;
+        long maxJitterSec_;
+        long retryDelaySec_;
+        std::shared_ptr<const Credentials> credentials_;
+        std::time_t expiration_;
+        bool lastFetchFailed_;
+        bool stopped_;
+        mutable std::mutex lock_;
+        std::condition_variable cv_;
+        std::thread thread_;
+    };
+}
+}
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <memory>
 #include "Credentials.h"
 
 namespace AlibabaCloud
@@ -27,6 +28,11 @@ namespace OSS
         CredentialsProvider() = default;
         virtual ~CredentialsProvider() = default;
         virtual Credentials getCredentials() = 0;
+        /*providers which keep an immutable copy can hand it out without copying*/
+        virtual std::shared_ptr<const Credentials> getCredentialsSnapshot()
+        {
+            return std::make_shared<const Credentials>(getCredentials());
+        }
     private:
 
     };
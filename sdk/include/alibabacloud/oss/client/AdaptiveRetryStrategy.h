@@ -0,0 +1,90 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <alibabacloud/oss/client/RetryStrategy.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * A retry strategy for brownouts, shared by all the threads of a client.
+    * backoff         : exponential backoff with decorrelated jitter.
+    * retry budget    : each failure costs one token and each success gives back tokenRatio,
+    *                   retries stop while the tokens are at or below half of maxTokens.
+    * circuit breaker : per endpoint, opens when the failure ratio in the window crosses
+    *                   the threshold, requests then fail fast with ERROR_CIRCUIT_BREAKER_OPEN
+    *                   until openMs elapsed and a single probe request succeeds. A cancelled
+    *                   or timed out probe leaves it open for another openMs.
+    * Only server errors(5xx) and network errors count as failures.
+    */
+    class ALIBABACLOUD_OSS_EXPORT AdaptiveRetryStrategy : public RetryStrategy
+    {
+    public:
+        AdaptiveRetryStrategy(long maxRetries = 3, long baseDelayMs = 100, long maxDelayMs = 20000);
+        virtual ~AdaptiveRetryStrategy();
+
+        /*set before the strategy is shared by clients*/
+        void setRetryBudget(double maxTokens, double tokenRatio);
+        void setCircuitBreaker(double failureRatio, long minimumRequests, long windowMs, long openMs);
+
+        virtual bool shouldRetry(const Error& error, long attemptedRetries) const override;
+        virtual long calcDealyTimeMs(const Error& error, long attemptedRetries) const override;
+        virtual bool allowRequest(const std::string& endpoint) const override;
+        virtual void onRequestSuccess(const std::string& endpoint) const override;
+        virtual void onRequestFailure(const std::string& endpoint, const Error& error) const override;
+        virtual void onRequestAborted(const std::string& endpoint) const override;
+
+        double RetryTokens() const;
+        bool IsCircuitOpen(const std::string& endpoint) const;
+
+        static bool IsRetryableError(const Error& error);
+    private:
+        enum class CircuitState { Closed, Open, HalfOpen };
+        struct Circuit {
+            CircuitState state;
+            long long windowStartMs;
+            long requests;
+            long failures;
+            long long openUntilMs;
+            bool probing;
+        };
+        Circuit& circuit(const std::string& endpoint) const;
+        void resetWindow(Circuit& c, long long nowMs) const;
+
+        long maxRetries_;
+        long baseDelayMs_;
+        long maxDelayMs_;
+
+        double maxTokens_;
+        double tokenRatio_;
+        mutable double tokens_;
+
+        double failureRatio_;
+        long minimumRequests_;
+        long windowMs_;
+        long openMs_;
+
+        mutable std::mutex lock_;
+        mutable std::map<std::string, Circuit> circuits_;
+    };
+}
+}
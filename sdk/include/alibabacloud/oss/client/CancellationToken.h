@@ -0,0 +1,45 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * Shared by the requests it is set on, see ServiceRequest::setCancellationToken.
+    * cancel() aborts their transfers in flight, wakes their retry waits
+    * and fails the ones not started yet.
+    */
+    class ALIBABACLOUD_OSS_EXPORT CancellationToken
+    {
+    public:
+        CancellationToken();
+        ~CancellationToken();
+
+        void cancel();
+        bool isCancelled() const;
+    private:
+        CancellationToken(const CancellationToken&) = delete;
+        CancellationToken& operator = (const CancellationToken&) = delete;
+        std::atomic<bool> cancelled_;
+    };
+}
+}
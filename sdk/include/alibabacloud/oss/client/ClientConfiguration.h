@@ -26,6 +26,11 @@ namespace OSS
 {
     class RetryStrategy;
     class RateLimiter;
+    class HedgePolicy;
+    class EndpointBalancer;
+    class TraceSampler;
+    class MetricsRegistry;
+    class Tracer;
     class ALIBABACLOUD_OSS_EXPORT ClientConfiguration
     {
     public:
@@ -45,6 +50,43 @@ namespace OSS
         */
         unsigned maxConnections;
         /**
+        * How long a request waits for a free connection when all maxConnections are busy.
+        * Default 0, no limit besides the request deadline.
+        */
+        long connectionAcquireTimeoutMs;
+        /**
+        * Connections opened in the background when the client is created, so the first requests
+        * skip DNS, TCP and TLS. A warm-up which fails is retried until the pool has this many.
+        * Default 0, connections are opened on demand.
+        */
+        unsigned warmupConnections;
+        /**
+        * The bucket whose host the warm-up connects to. Default empty, the endpoint itself.
+        */
+        std::string warmupBucket;
+        /**
+        * Connections idle for longer than this are closed in the background, never below warmupConnections.
+        * Default 0, idle connections are kept.
+        */
+        long idleConnectionTimeoutMs;
+        /**
+        * Seconds a connection is idle before TCP keep-alive probes, and between the probes.
+        * Default 60 and 30, 0 disables the probes.
+        */
+        long tcpKeepAliveIdleSec;
+        long tcpKeepAliveIntervalSec;
+        /**
+        * Send the requests as HTTP/2 streams multiplexed over a few connections per host. Default false.
+        * https endpoints negotiate it and fall back to HTTP/1.1. http endpoints must accept HTTP/2
+        * without an upgrade, and stay on HTTP/1.1 with libcurl before 8.0.
+        * maxConnections then caps the concurrent streams rather than the connections.
+        */
+        bool enableHttp2;
+        /**
+        * The connections per host the HTTP/2 streams are spread over. Default 1.
+        */
+        unsigned http2ConnectionsPerHost;
+        /**
         * Socket read timeouts. Default 3000 ms. 
         */
         long requestTimeoutMs;
@@ -104,6 +146,33 @@ namespace OSS
         * Rate limit data download speed.
         */
         std::shared_ptr<RateLimiter> recvRateLimiter;
+        /**
+        * Hedge slow HEAD and small ranged GET requests. Default nullptr, hedging is disabled.
+        */
+        std::shared_ptr<HedgePolicy> hedgePolicy;
+        /**
+        * Spread the requests over the endpoints of the balancer instead of the one the client
+        * is created with, which is still used for the presigned urls. Default nullptr.
+        */
+        std::shared_ptr<EndpointBalancer> endpointBalancer;
+        /**
+        * Reuse the signature of an identical canonical string signed by the same thread,
+        * e.g. retried HEADs within the same second. Default false.
+        */
+        bool enableSignatureCache;
+        /**
+        * Capture the curl verbose output of sampled requests and emit it only for the
+        * slow or failed ones. Default nullptr, every request is traced when the log level is LogInfo or above.
+        */
+        std::shared_ptr<TraceSampler> traceSampler;
+        /**
+        * Where the client records its request, retry, transfer and pool metrics. Default nullptr, no metrics.
+        */
+        std::shared_ptr<MetricsRegistry> metricsRegistry;
+        /**
+        * Report the requests, their attempts and phases as spans. Default nullptr, no tracing.
+        */
+        std::shared_ptr<Tracer> tracer;
     };
 }
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <alibabacloud/oss/client/Error.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * Spreads the requests of a client over several endpoints serving the same buckets,
+    * e.g. a few VIPs or the internal and the accelerated endpoint, shared by all the threads of a client.
+    * routing  : power of two choices, of two random endpoints the one with the lower
+    *            EWMA latency * (requests in flight + 1) / (1 - EWMA error rate) is used.
+    *            The latency is the time to the first response byte of an attempt.
+    * ejection : an endpoint failing ejectFailures times in a row is left out for ejectMs,
+    *            unless every endpoint is left out.
+    * failover : a retry of a request other than POST goes to another endpoint.
+    * Only server errors(5xx) and network errors count as failures.
+    */
+    class ALIBABACLOUD_OSS_EXPORT EndpointBalancer
+    {
+    public:
+        struct EndpointState
+        {
+            std::string endpoint;
+            double latencyMs;
+            double errorRate;
+            long inFlight;
+            bool ejected;
+        };
+
+        EndpointBalancer(const std::vector<std::string>& endpoints, long ejectFailures = 3, long ejectMs = 10000);
+        virtual ~EndpointBalancer();
+
+        /*the endpoint for the next attempt, avoid is only used when there is another one*/
+        std::string pickEndpoint(const std::string& avoid = std::string()) const;
+        /*the same, avoiding each of the given endpoints while there is another one*/
+        std::string pickEndpoint(const std::vector<std::string>& avoid) const;
+        void onRequestStart(const std::string& endpoint) const;
+        void onRequestSuccess(const std::string& endpoint, long long latencyUs) const;
+        void onRequestFailure(const std::string& endpoint, long long latencyUs, const Error& error) const;
+
+        const std::vector<std::string>& Endpoints() const { return endpoints_; }
+        std::vector<EndpointState> States() const;
+
+        static bool IsEndpointFailure(const Error& error);
+    private:
+        struct Stats {
+            double latencyUs;
+            bool sampled;
+            double errorRate;
+            long inFlight;
+            long consecutiveFailures;
+            long long ejectedUntilMs;
+        };
+        std::string pick(const std::string* avoid, size_t avoidCount) const;
+        Stats* stats(const std::string& endpoint) const;
+        void record(Stats& s, long long latencyUs, bool failed) const;
+        double cost(const Stats& s, double defaultLatencyUs) const;
+
+        std::vector<std::string> endpoints_;
+        long ejectFailures_;
+        long ejectMs_;
+
+        mutable std::mutex lock_;
+        mutable std::vector<Stats> stats_;
+    };
+}
+}
@@ -34,6 +34,10 @@ namespace OSS
     const int ERROR_CLIENT_BASE      = 100000;
     const int ERROR_CRC_INCONSISTENT = ERROR_CLIENT_BASE + 1;
     const int ERROR_REQUEST_DISABLE  = ERROR_CLIENT_BASE + 2;
+    const int ERROR_CIRCUIT_BREAKER_OPEN = ERROR_CLIENT_BASE + 3;
+    const int ERROR_REQUEST_CANCELLED = ERROR_CLIENT_BASE + 4;
+    const int ERROR_REQUEST_DEADLINE_EXCEEDED = ERROR_CLIENT_BASE + 5;
+    const int ERROR_CONNECTION_POOL_TIMEOUT = ERROR_CLIENT_BASE + 6;
 
     const int ERROR_CURL_BASE = 200000;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * Hedging for HEAD and small ranged GET requests. If no response byte has arrived
+    * after hedgeDelayMs(), a duplicate request is sent on another connection,
+    * the first one to respond wins and the other one is cancelled.
+    * The delay follows a percentile of the recent time-to-first-byte,
+    * and the duplicates are capped by a token budget.
+    * A GET is hedged only with a closed range of at most maxHedgeBytes, so a slow
+    * first byte of a large download or a listing never starts a second one.
+    */
+    class ALIBABACLOUD_OSS_EXPORT HedgePolicy
+    {
+    public:
+        /*
+        * percentile    : the percentile of recent first byte latency used as the hedge delay, (0, 100).
+        * minDelayMs    : lower bound of the hedge delay.
+        * maxDelayMs    : upper bound of the hedge delay, also used until enough samples are collected.
+        * budgetPercent : extra requests allowed, in percent of the hedgeable requests.
+        * windowSize    : how many recent latency samples are kept.
+        */
+        HedgePolicy(double percentile = 95.0, long minDelayMs = 5, long maxDelayMs = 1000,
+            double budgetPercent = 5.0, size_t windowSize = 256);
+        virtual ~HedgePolicy();
+
+        /*set before the policy is shared by clients, default 1 MB, 0 hedges no GET*/
+        void setMaxHedgeBytes(int64_t maxHedgeBytes);
+        bool isHedgeableRange(const std::string& range) const;
+
+        long hedgeDelayMs();
+        void recordLatency(long latencyMs);
+        bool acquireHedge();
+
+        double Percentile() const { return percentile_; }
+        long MinDelayMs() const { return minDelayMs_; }
+        long MaxDelayMs() const { return maxDelayMs_; }
+        double BudgetPercent() const { return budgetPercent_; }
+        int64_t MaxHedgeBytes() const { return maxHedgeBytes_; }
+    private:
+        void updateDelay();
+
+        double percentile_;
+        long minDelayMs_;
+        long maxDelayMs_;
+        double budgetPercent_;
+        int64_t maxHedgeBytes_;
+        std::mutex lock_;
+        std::vector<long> window_;
+        size_t windowPos_;
+        size_t samples_;
+        long delayMs_;
+        double tokens_;
+    };
+}
+}
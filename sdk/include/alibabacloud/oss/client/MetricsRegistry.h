@@ -0,0 +1,149 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * A counter split over cache-line sized shards, each thread adds to its own shard.
+    */
+    class ALIBABACLOUD_OSS_EXPORT MetricsCounter
+    {
+    public:
+        MetricsCounter();
+        void add(uint64_t value = 1);
+        uint64_t value() const;
+    private:
+        static const size_t ShardCount = 16;
+        struct Shard
+        {
+            std::atomic<uint64_t> value;
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+        Shard shards_[ShardCount];
+    };
+
+    struct ALIBABACLOUD_OSS_EXPORT HistogramSnapshot
+    {
+        std::string name;
+        uint64_t count;
+        uint64_t sum;
+        /*non-cumulative counts, bucket i holds the values up to MetricsHistogram::BucketUpperBound(i)*/
+        std::vector<uint64_t> buckets;
+        /*upper bound of the bucket holding the percentile, p in [0, 100]*/
+        uint64_t percentile(double p) const;
+    };
+
+    /*
+    * A log-linear histogram of non-negative integer values, e.g. latency in microseconds.
+    * Values below 16 are exact, above that every power of two is split in 8 buckets,
+    * so a value is off by at most 12.5%.
+    */
+    class ALIBABACLOUD_OSS_EXPORT MetricsHistogram
+    {
+    public:
+        static const size_t BucketCount = 16 + 60 * 8;
+
+        MetricsHistogram();
+        void record(uint64_t value);
+        void snapshot(HistogramSnapshot &snapshot) const;
+
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketUpperBound(size_t index);
+    private:
+        std::atomic<uint64_t> buckets_[BucketCount];
+        MetricsCounter sum_;
+    };
+
+    struct ALIBABACLOUD_OSS_EXPORT MetricsSnapshot
+    {
+        std::vector<std::pair<std::string, uint64_t>> counters;
+        std::vector<std::pair<std::string, int64_t>> gauges;
+        std::vector<HistogramSnapshot> histograms;
+    };
+
+    class ALIBABACLOUD_OSS_EXPORT MetricsExporter
+    {
+    public:
+        virtual ~MetricsExporter();
+        virtual void exportMetrics(const MetricsSnapshot &snapshot) = 0;
+    };
+
+    /*
+    * Renders a snapshot in the Prometheus text exposition format.
+    * Histograms are rendered with a fixed set of bounds, one per power of two
+    * from 2^MinBoundBit - 1 to 2^MaxBoundBit - 1 (15us to about 19 hours), empty or not.
+    */
+    class ALIBABACLOUD_OSS_EXPORT PrometheusTextExporter : public MetricsExporter
+    {
+    public:
+        static const int MinBoundBit = 4;
+        static const int MaxBoundBit = 36;
+
+        void exportMetrics(const MetricsSnapshot &snapshot) override;
+        const std::string &Text() const { return text_; }
+    private:
+        std::string text_;
+    };
+
+    /*
+    * Metrics shared by the clients configured with it. The names follow Prometheus,
+    * labels are part of the name, e.g. oss_requests_total{method="GET"}.
+    * Counters and histograms live as long as the registry, so the pointers returned
+    * can be kept and updated without a lookup. Gauges are sampled when a snapshot is
+    * taken, the gauges registered under the same name are summed.
+    */
+    class ALIBABACLOUD_OSS_EXPORT MetricsRegistry
+    {
+    public:
+        using Gauge = std::function<int64_t()>;
+
+        MetricsRegistry();
+        ~MetricsRegistry();
+
+        MetricsCounter *counter(const std::string &name);
+        MetricsHistogram *histogram(const std::string &name);
+        uint64_t addGauge(const std::string &name, const Gauge &gauge);
+        void removeGauge(uint64_t id);
+
+        MetricsSnapshot snapshot() const;
+        void exportTo(MetricsExporter &exporter) const;
+    private:
+        MetricsRegistry(const MetricsRegistry &) = delete;
+        MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+        mutable std::mutex lock_;
+        std::map<std::string, std::unique_ptr<MetricsCounter>> counters_;
+        std::map<std::string, std::unique_ptr<MetricsHistogram>> histograms_;
+        std::map<uint64_t, std::pair<std::string, Gauge>> gauges_;
+        uint64_t nextGaugeId_;
+    };
+}
+}
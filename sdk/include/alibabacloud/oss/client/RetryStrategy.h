@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <string>
 #include <alibabacloud/oss/client/Error.h>
 
 namespace AlibabaCloud
@@ -28,6 +29,13 @@ namespace OSS
         virtual ~RetryStrategy() {}
         virtual bool shouldRetry(const Error& error, long attemptedRetries) const = 0;
         virtual long calcDealyTimeMs(const Error& error, long attemptedRetries) const = 0;
+        /*called before every attempt, return false to fail the request without sending it*/
+        virtual bool allowRequest(const std::string& /*endpoint*/) const { return true; }
+        /*called after every attempt with its result*/
+        virtual void onRequestSuccess(const std::string& /*endpoint*/) const {}
+        virtual void onRequestFailure(const std::string& /*endpoint*/, const Error& /*error*/) const {}
+        /*called instead when the attempt was cancelled or ran past its deadline, it says nothing of the endpoint*/
+        virtual void onRequestAborted(const std::string& /*endpoint*/) const {}
     };
 } 
 }
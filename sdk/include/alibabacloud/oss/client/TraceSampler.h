@@ -0,0 +1,74 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <alibabacloud/oss/Export.h>
+#include <alibabacloud/oss/http/HttpType.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * Sampled wire-level tracing. A sampled request captures the curl verbose
+    * output (info text and the headers sent and received) into a buffer of its own,
+    * the buffer is emitted only if shouldEmit() holds when the request completes.
+    * The credential headers and the signing query parameters of presigned urls are
+    * masked in the trace and in Sample::url.
+    * Requests which are not sampled pay nothing.
+    */
+    class ALIBABACLOUD_OSS_EXPORT TraceSampler
+    {
+    public:
+        struct Sample
+        {
+            Http::Method method;
+            std::string url;
+            /*http status code, or ERROR_CURL_BASE + CURLcode if the transfer failed*/
+            long statusCode;
+            long latencyMs;
+        };
+
+        /*
+        * sampleRate         : fraction of the requests captured, [0, 1].
+        * latencyThresholdMs : emit the captured requests which take at least this long, negative to disable.
+        * minStatusCode      : emit the captured requests whose status is at least this, 0 to disable.
+        */
+        TraceSampler(double sampleRate = 1.0, long latencyThresholdMs = 1000, long minStatusCode = 500);
+        virtual ~TraceSampler();
+
+        /*called before the request is sent*/
+        virtual bool shouldCapture();
+        /*called when a captured request completes*/
+        virtual bool shouldEmit(const Sample &sample);
+        /*the default writes the trace to the SDK log at LogWarn, in records of at most 2KB*/
+        virtual void emit(const Sample &sample, const std::string &trace);
+
+        double SampleRate() const { return sampleRate_; }
+        long LatencyThresholdMs() const { return latencyThresholdMs_; }
+        long MinStatusCode() const { return minStatusCode_; }
+    private:
+        double sampleRate_;
+        long latencyThresholdMs_;
+        long minStatusCode_;
+        std::atomic<uint64_t> requests_;
+    };
+}
+}
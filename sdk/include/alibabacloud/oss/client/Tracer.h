@@ -0,0 +1,81 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * The identity of a span as defined by W3C trace context.
+    */
+    struct ALIBABACLOUD_OSS_EXPORT SpanContext
+    {
+        SpanContext() : traceFlags(0) {}
+
+        /*32 lower case hex digits*/
+        std::string traceId;
+        /*16 lower case hex digits*/
+        std::string spanId;
+        uint8_t traceFlags;
+
+        bool isValid() const;
+        /*00-<trace-id>-<span-id>-<trace-flags>*/
+        std::string toTraceParent() const;
+        static bool FromTraceParent(const std::string &traceParent, SpanContext &context);
+    };
+
+    class ALIBABACLOUD_OSS_EXPORT Span
+    {
+    public:
+        virtual ~Span();
+        virtual const SpanContext &context() const = 0;
+        virtual void setAttribute(const std::string &key, const std::string &value) = 0;
+        virtual void end(std::chrono::steady_clock::time_point endTime) = 0;
+    };
+
+    /*
+    * Tracing hooks of the client. A request gets an "oss.request" span, a child of the
+    * request's TraceContext() if one is set. Every attempt gets an "oss.attempt" span
+    * with the "oss.sign", "oss.pool_wait" and "oss.transfer" phases as children, and the
+    * backoff between attempts is an "oss.retry_wait" span.
+    * The phase spans are reported once the attempt is over, with their own start time.
+    * Without a tracer nothing of this is done.
+    */
+    class ALIBABACLOUD_OSS_EXPORT Tracer
+    {
+    public:
+        /*propagateTraceParent : send the attempt's span context in the traceparent header*/
+        explicit Tracer(bool propagateTraceParent = false);
+        virtual ~Tracer();
+
+        /*the parent is not valid for a root span*/
+        virtual std::shared_ptr<Span> startSpan(const std::string &name, const SpanContext &parent,
+            std::chrono::steady_clock::time_point startTime) = 0;
+
+        bool PropagateTraceParent() const { return propagateTraceParent_; }
+    private:
+        bool propagateTraceParent_;
+    };
+}
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    class OssClientImpl;
+    /*
+    * The urls of a GeneratePresignedUrls call, kept back to back in one buffer.
+    * Each url is nul terminated, so UrlData(i) can be passed on as a C string
+    * without a copy.
+    */
+    class ALIBABACLOUD_OSS_EXPORT PresignedUrlList
+    {
+    public:
+        PresignedUrlList() = default;
+        size_t Count() const { return offsets_.size(); }
+        const char* UrlData(size_t index) const { return buffer_.data() + offsets_[index].first; }
+        size_t UrlLength(size_t index) const { return offsets_[index].second; }
+        std::string Url(size_t index) const { return buffer_.substr(offsets_[index].first, offsets_[index].second); }
+        const std::string& Buffer() const { return buffer_; }
+    private:
+        friend class OssClientImpl;
+        std::string buffer_;
+        std::vector<std::pair<size_t, size_t>> offsets_;
+    };
+}
+}
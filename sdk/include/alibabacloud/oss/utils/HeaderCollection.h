@@ -0,0 +1,109 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+#include <alibabacloud/oss/Export.h>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * The headers of a request or a response.
+    * Kept as one sorted vector instead of a node per header, a lookup is a case insensitive
+    * binary search. Each entry carries a case insensitive hash of its name, so telling a hit
+    * from the next name compares integers before any string.
+    * It keeps the parts of the std::map interface the SDK uses and iterates in the same
+    * case insensitive order. Names must not be changed through an iterator.
+    */
+    class ALIBABACLOUD_OSS_EXPORT HeaderCollection
+    {
+    public:
+        using key_type = std::string;
+        using mapped_type = std::string;
+        using value_type = std::pair<std::string, std::string>;
+        using size_type = size_t;
+
+        struct Entry : public value_type
+        {
+            Entry(value_type &&value, uint32_t h) : value_type(std::move(value)), hash(h) {}
+            uint32_t hash;
+        };
+        using iterator = std::vector<Entry>::iterator;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        HeaderCollection() = default;
+        HeaderCollection(std::initializer_list<value_type> values);
+        template<typename InputIt>
+        HeaderCollection(InputIt first, InputIt last) { insert(first, last); }
+
+        iterator begin() { return entries_.begin(); }
+        iterator end() { return entries_.end(); }
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.end(); }
+        const_iterator cbegin() const { return entries_.cbegin(); }
+        const_iterator cend() const { return entries_.cend(); }
+        bool empty() const { return entries_.empty(); }
+        size_type size() const { return entries_.size(); }
+        void clear() { entries_.clear(); }
+        void reserve(size_type n) { entries_.reserve(n); }
+
+        iterator find(const std::string &name);
+        const_iterator find(const std::string &name) const;
+        size_type count(const std::string &name) const { return find(name) != end() ? 1 : 0; }
+        //empty if there is no such header
+        const std::string &at(const std::string &name) const;
+        std::string &operator[](const std::string &name);
+        std::string &operator[](std::string &&name);
+
+        //like std::map, an existing header is kept
+        std::pair<iterator, bool> insert(const value_type &value);
+        std::pair<iterator, bool> insert(value_type &&value);
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first) {
+                insert(value_type(first->first, first->second));
+            }
+        }
+        template<typename K, typename V>
+        std::pair<iterator, bool> emplace(K &&name, V &&value)
+        {
+            return insert(value_type(std::forward<K>(name), std::forward<V>(value)));
+        }
+
+        size_type erase(const std::string &name);
+        iterator erase(const_iterator pos);
+
+        bool operator==(const HeaderCollection &other) const;
+        bool operator!=(const HeaderCollection &other) const { return !(*this == other); }
+
+        static uint32_t Hash(const char *name, size_t len);
+    private:
+        size_t lowerBound(const std::string &name) const;
+        bool matches(size_t index, const std::string &name, uint32_t hash) const;
+        size_t indexOf(const std::string &name, uint32_t hash) const;
+        std::pair<iterator, bool> insertNew(value_type &&value, uint32_t hash, size_t index);
+        std::vector<Entry> entries_;
+    };
+}
+}
@@ -60,6 +60,11 @@ void AlibabaCloud::OSS::SetLogCallback(LogCallback callback)
 {
     SetLogCallbackInner(callback);
 }
+
+void AlibabaCloud::OSS::FlushLog()
+{
+    FlushLogInner();
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 uint64_t AlibabaCloud::OSS::ComputeCRC64(uint64_t crc, void *buf, size_t len)
@@ -528,6 +533,16 @@ StringOutcome OssClient::GeneratePresignedUrl(const std::string &bucket, const s
     return GeneratePresignedUrl(request);
 }
 
+PresignedUrlListOutcome OssClient::GeneratePresignedUrls(const std::string &bucket, const std::vector<std::string> &keys, int64_t expires) const
+{
+    return GeneratePresignedUrls(bucket, keys, expires, Http::Method::Get);
+}
+
+PresignedUrlListOutcome OssClient::GeneratePresignedUrls(const std::string &bucket, const std::vector<std::string> &keys, int64_t expires, Http::Method method) const
+{
+    return client_->GeneratePresignedUrls(bucket, keys, expires, method);
+}
+
 GetObjectOutcome OssClient::GetObjectByUrl(const GetObjectByUrlRequest &request) const
 {
     return client_->GetObjectByUrl(request);
@@ -608,112 +623,500 @@ ListPartsOutcome OssClient::ListParts(const ListPartsRequest &request) const
 }
 
 /*Aysnc APIs*/
-void OssClient::ListObjectsAsync(const ListObjectsRequest &request, const ListObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+template<typename Request, typename Outcome, typename Handler>
+static void AsyncCall(const OssClient *client, OssClientImpl *impl, Outcome(OssClient::*op)(const Request &) const,
+    const Request &request, const Handler &handler, const std::shared_ptr<const AsyncCallerContext>& context)
 {
-    auto fn = [this, request, handler, context]()
+    auto fn = [client, op, request, handler, context]()
     {
-        handler(this, request, client_->ListObjects(request), context);
+        handler(client, request, (client->*op)(request), context);
     };
 
-    client_->asyncExecute(new Runnable(fn));
+    impl->asyncExecute(new Runnable(fn));
 }
 
-void OssClient::GetObjectAsync(const GetObjectRequest &request, const GetObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+template<typename Request, typename Outcome>
+static std::future<Outcome> CallableCall(const OssClient *client, OssClientImpl *impl, Outcome(OssClient::*op)(const Request &) const,
+    const Request &request)
 {
-    auto fn = [this, request, handler, context]()
+    auto task = std::make_shared<std::packaged_task<Outcome()>>(
+        [client, op, request]()
     {
-        handler(this, request, client_->GetObject(request), context);
-    };
+        return (client->*op)(request);
+    });
+    impl->asyncExecute(new Runnable([task]() { (*task)(); }));
+    return task->get_future();
+}
+
+void OssClient::ListBucketsAsync(const ListBucketsRequest &request, const ListBucketsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<ListBucketsRequest, ListBucketsOutcome>(this, client_, &OssClient::ListBuckets, request, handler, context);
+}
+
+void OssClient::CreateBucketAsync(const CreateBucketRequest &request, const CreateBucketAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<CreateBucketRequest, CreateBucketOutcome>(this, client_, &OssClient::CreateBucket, request, handler, context);
+}
+
+void OssClient::ListObjectsAsync(const ListObjectsRequest &request, const ListObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<ListObjectsRequest, ListObjectOutcome>(this, client_, &OssClient::ListObjects, request, handler, context);
+}
+
+void OssClient::SetBucketAclAsync(const SetBucketAclRequest &request, const SetBucketAclAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketAclRequest, VoidOutcome>(this, client_, &OssClient::SetBucketAcl, request, handler, context);
+}
+
+void OssClient::SetBucketLoggingAsync(const SetBucketLoggingRequest &request, const SetBucketLoggingAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketLoggingRequest, VoidOutcome>(this, client_, &OssClient::SetBucketLogging, request, handler, context);
+}
+
+void OssClient::SetBucketWebsiteAsync(const SetBucketWebsiteRequest &request, const SetBucketWebsiteAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketWebsiteRequest, VoidOutcome>(this, client_, &OssClient::SetBucketWebsite, request, handler, context);
+}
+
+void OssClient::SetBucketRefererAsync(const SetBucketRefererRequest &request, const SetBucketRefererAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketRefererRequest, VoidOutcome>(this, client_, &OssClient::SetBucketReferer, request, handler, context);
+}
 
-    client_->asyncExecute(new Runnable(fn));
+void OssClient::SetBucketLifecycleAsync(const SetBucketLifecycleRequest &request, const SetBucketLifecycleAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketLifecycleRequest, VoidOutcome>(this, client_, &OssClient::SetBucketLifecycle, request, handler, context);
+}
+
+void OssClient::SetBucketCorsAsync(const SetBucketCorsRequest &request, const SetBucketCorsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketCorsRequest, VoidOutcome>(this, client_, &OssClient::SetBucketCors, request, handler, context);
+}
+
+void OssClient::SetBucketStorageCapacityAsync(const SetBucketStorageCapacityRequest &request, const SetBucketStorageCapacityAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetBucketStorageCapacityRequest, VoidOutcome>(this, client_, &OssClient::SetBucketStorageCapacity, request, handler, context);
+}
+
+void OssClient::DeleteBucketAsync(const DeleteBucketRequest &request, const DeleteBucketAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteBucketRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucket, request, handler, context);
+}
+
+void OssClient::DeleteBucketLoggingAsync(const DeleteBucketLoggingRequest &request, const DeleteBucketLoggingAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteBucketLoggingRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketLogging, request, handler, context);
+}
+
+void OssClient::DeleteBucketWebsiteAsync(const DeleteBucketWebsiteRequest &request, const DeleteBucketWebsiteAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteBucketWebsiteRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketWebsite, request, handler, context);
+}
+
+void OssClient::DeleteBucketLifecycleAsync(const DeleteBucketLifecycleRequest &request, const DeleteBucketLifecycleAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteBucketLifecycleRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketLifecycle, request, handler, context);
+}
+
+void OssClient::DeleteBucketCorsAsync(const DeleteBucketCorsRequest &request, const DeleteBucketCorsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteBucketCorsRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketCors, request, handler, context);
+}
+
+void OssClient::GetBucketAclAsync(const GetBucketAclRequest &request, const GetBucketAclAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketAclRequest, GetBucketAclOutcome>(this, client_, &OssClient::GetBucketAcl, request, handler, context);
+}
+
+void OssClient::GetBucketLocationAsync(const GetBucketLocationRequest &request, const GetBucketLocationAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketLocationRequest, GetBucketLocationOutcome>(this, client_, &OssClient::GetBucketLocation, request, handler, context);
+}
+
+void OssClient::GetBucketInfoAsync(const GetBucketInfoRequest &request, const GetBucketInfoAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketInfoRequest, GetBucketInfoOutcome>(this, client_, &OssClient::GetBucketInfo, request, handler, context);
+}
+
+void OssClient::GetBucketLoggingAsync(const GetBucketLoggingRequest &request, const GetBucketLoggingAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketLoggingRequest, GetBucketLoggingOutcome>(this, client_, &OssClient::GetBucketLogging, request, handler, context);
+}
+
+void OssClient::GetBucketWebsiteAsync(const GetBucketWebsiteRequest &request, const GetBucketWebsiteAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketWebsiteRequest, GetBucketWebsiteOutcome>(this, client_, &OssClient::GetBucketWebsite, request, handler, context);
+}
+
+void OssClient::GetBucketRefererAsync(const GetBucketRefererRequest &request, const GetBucketRefererAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketRefererRequest, GetBucketRefererOutcome>(this, client_, &OssClient::GetBucketReferer, request, handler, context);
+}
+
+void OssClient::GetBucketLifecycleAsync(const GetBucketLifecycleRequest &request, const GetBucketLifecycleAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketLifecycleRequest, GetBucketLifecycleOutcome>(this, client_, &OssClient::GetBucketLifecycle, request, handler, context);
+}
+
+void OssClient::GetBucketStatAsync(const GetBucketStatRequest &request, const GetBucketStatAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketStatRequest, GetBucketStatOutcome>(this, client_, &OssClient::GetBucketStat, request, handler, context);
+}
+
+void OssClient::GetBucketCorsAsync(const GetBucketCorsRequest &request, const GetBucketCorsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketCorsRequest, GetBucketCorsOutcome>(this, client_, &OssClient::GetBucketCors, request, handler, context);
+}
+
+void OssClient::GetBucketStorageCapacityAsync(const GetBucketStorageCapacityRequest &request, const GetBucketStorageCapacityAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetBucketStorageCapacityRequest, GetBucketStorageCapacityOutcome>(this, client_, &OssClient::GetBucketStorageCapacity, request, handler, context);
+}
+
+void OssClient::GetObjectAsync(const GetObjectRequest &request, const GetObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetObjectRequest, GetObjectOutcome>(this, client_, &OssClient::GetObject, request, handler, context);
 }
 
 void OssClient::PutObjectAsync(const PutObjectRequest &request, const PutObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
 {
-    auto fn = [this, request, handler, context]()
-    {
-        handler(this, request, client_->PutObject(request), context);
-    };
+    AsyncCall<PutObjectRequest, PutObjectOutcome>(this, client_, &OssClient::PutObject, request, handler, context);
+}
 
-    client_->asyncExecute(new Runnable(fn));
+void OssClient::DeleteObjectAsync(const DeleteObjectRequest &request, const DeleteObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<DeleteObjectRequest, VoidOutcome>(this, client_, &OssClient::DeleteObject, request, handler, context);
 }
 
-void OssClient::UploadPartAsync(const UploadPartRequest &request, const UploadPartAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+void OssClient::DeleteObjectsAsync(const DeleteObjectsRequest &request, const DeleteObjectsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
 {
-    auto fn = [this, request, handler, context]()
-    {
-        handler(this, request, client_->UploadPart(request), context);
-    };
+    AsyncCall<DeleteObjectsRequest, DeleteObjecstOutcome>(this, client_, &OssClient::DeleteObjects, request, handler, context);
+}
+
+void OssClient::HeadObjectAsync(const HeadObjectRequest &request, const HeadObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<HeadObjectRequest, ObjectMetaDataOutcome>(this, client_, &OssClient::HeadObject, request, handler, context);
+}
+
+void OssClient::GetObjectMetaAsync(const GetObjectMetaRequest &request, const GetObjectMetaAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetObjectMetaRequest, ObjectMetaDataOutcome>(this, client_, &OssClient::GetObjectMeta, request, handler, context);
+}
 
-    client_->asyncExecute(new Runnable(fn));
+void OssClient::AppendObjectAsync(const AppendObjectRequest &request, const AppendObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<AppendObjectRequest, AppendObjectOutcome>(this, client_, &OssClient::AppendObject, request, handler, context);
+}
+
+void OssClient::CopyObjectAsync(const CopyObjectRequest &request, const CopyObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<CopyObjectRequest, CopyObjectOutcome>(this, client_, &OssClient::CopyObject, request, handler, context);
+}
+
+void OssClient::RestoreObjectAsync(const RestoreObjectRequest &request, const RestoreObjectAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<RestoreObjectRequest, VoidOutcome>(this, client_, &OssClient::RestoreObject, request, handler, context);
+}
+
+void OssClient::SetObjectAclAsync(const SetObjectAclRequest &request, const SetObjectAclAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<SetObjectAclRequest, VoidOutcome>(this, client_, &OssClient::SetObjectAcl, request, handler, context);
+}
+
+void OssClient::GetObjectAclAsync(const GetObjectAclRequest &request, const GetObjectAclAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetObjectAclRequest, GetObjectAclOutcome>(this, client_, &OssClient::GetObjectAcl, request, handler, context);
+}
+
+void OssClient::CreateSymlinkAsync(const CreateSymlinkRequest &request, const CreateSymlinkAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<CreateSymlinkRequest, CreateSymlinkOutcome>(this, client_, &OssClient::CreateSymlink, request, handler, context);
+}
+
+void OssClient::GetSymlinkAsync(const GetSymlinkRequest &request, const GetSymlinkAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetSymlinkRequest, GetSymlinkOutcome>(this, client_, &OssClient::GetSymlink, request, handler, context);
+}
+
+void OssClient::InitiateMultipartUploadAsync(const InitiateMultipartUploadRequest &request, const InitiateMultipartUploadAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<InitiateMultipartUploadRequest, InitiateMultipartUploadOutcome>(this, client_, &OssClient::InitiateMultipartUpload, request, handler, context);
+}
+
+void OssClient::UploadPartAsync(const UploadPartRequest &request, const UploadPartAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<UploadPartRequest, PutObjectOutcome>(this, client_, &OssClient::UploadPart, request, handler, context);
 }
 
 void OssClient::UploadPartCopyAsync(const UploadPartCopyRequest &request, const UploadPartCopyAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
 {
-    auto fn = [this, request, handler, context]()
-    {
-        handler(this, request, client_->UploadPartCopy(request), context);
-    };
+    AsyncCall<UploadPartCopyRequest, UploadPartCopyOutcome>(this, client_, &OssClient::UploadPartCopy, request, handler, context);
+}
+
+void OssClient::CompleteMultipartUploadAsync(const CompleteMultipartUploadRequest &request, const CompleteMultipartUploadAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<CompleteMultipartUploadRequest, CompleteMultipartUploadOutcome>(this, client_, &OssClient::CompleteMultipartUpload, request, handler, context);
+}
 
-    client_->asyncExecute(new Runnable(fn));
+void OssClient::AbortMultipartUploadAsync(const AbortMultipartUploadRequest &request, const AbortMultipartUploadAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<AbortMultipartUploadRequest, VoidOutcome>(this, client_, &OssClient::AbortMultipartUpload, request, handler, context);
 }
 
+void OssClient::ListMultipartUploadsAsync(const ListMultipartUploadsRequest &request, const ListMultipartUploadsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<ListMultipartUploadsRequest, ListMultipartUploadsOutcome>(this, client_, &OssClient::ListMultipartUploads, request, handler, context);
+}
+
+void OssClient::ListPartsAsync(const ListPartsRequest &request, const ListPartsAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<ListPartsRequest, ListPartsOutcome>(this, client_, &OssClient::ListParts, request, handler, context);
+}
+
+void OssClient::GetObjectByUrlAsync(const GetObjectByUrlRequest &request, const GetObjectByUrlAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<GetObjectByUrlRequest, GetObjectOutcome>(this, client_, &OssClient::GetObjectByUrl, request, handler, context);
+}
+
+void OssClient::PutObjectByUrlAsync(const PutObjectByUrlRequest &request, const PutObjectByUrlAsyncHandler &handler, const std::shared_ptr<const AsyncCallerContext>& context) const
+{
+    AsyncCall<PutObjectByUrlRequest, PutObjectOutcome>(this, client_, &OssClient::PutObjectByUrl, request, handler, context);
+}
 
 /*Callable APIs*/
+ListBucketsOutcomeCallable OssClient::ListBucketsCallable(const ListBucketsRequest &request) const
+{
+    return CallableCall<ListBucketsRequest, ListBucketsOutcome>(this, client_, &OssClient::ListBuckets, request);
+}
+
+CreateBucketOutcomeCallable OssClient::CreateBucketCallable(const CreateBucketRequest &request) const
+{
+    return CallableCall<CreateBucketRequest, CreateBucketOutcome>(this, client_, &OssClient::CreateBucket, request);
+}
+
 ListObjectOutcomeCallable OssClient::ListObjectsCallable(const ListObjectsRequest &request) const
 {
-    auto task = std::make_shared<std::packaged_task<ListObjectOutcome()>>(
-        [this, request]()
-    {
-        return this->ListObjects(request);
-    });
-    client_->asyncExecute(new Runnable([task]() { (*task)(); }));
-    return task->get_future();
+    return CallableCall<ListObjectsRequest, ListObjectOutcome>(this, client_, &OssClient::ListObjects, request);
 }
 
-GetObjectOutcomeCallable OssClient::GetObjectCallable(const GetObjectRequest &request) const
+VoidOutcomeCallable OssClient::SetBucketAclCallable(const SetBucketAclRequest &request) const
 {
-    auto task = std::make_shared<std::packaged_task<GetObjectOutcome()>>(
-        [this, request]()
-    {
-        return this->GetObject(request);
-    });
-    client_->asyncExecute(new Runnable([task]() { (*task)(); }));
-    return task->get_future();
+    return CallableCall<SetBucketAclRequest, VoidOutcome>(this, client_, &OssClient::SetBucketAcl, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketLoggingCallable(const SetBucketLoggingRequest &request) const
+{
+    return CallableCall<SetBucketLoggingRequest, VoidOutcome>(this, client_, &OssClient::SetBucketLogging, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketWebsiteCallable(const SetBucketWebsiteRequest &request) const
+{
+    return CallableCall<SetBucketWebsiteRequest, VoidOutcome>(this, client_, &OssClient::SetBucketWebsite, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketRefererCallable(const SetBucketRefererRequest &request) const
+{
+    return CallableCall<SetBucketRefererRequest, VoidOutcome>(this, client_, &OssClient::SetBucketReferer, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketLifecycleCallable(const SetBucketLifecycleRequest &request) const
+{
+    return CallableCall<SetBucketLifecycleRequest, VoidOutcome>(this, client_, &OssClient::SetBucketLifecycle, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketCorsCallable(const SetBucketCorsRequest &request) const
+{
+    return CallableCall<SetBucketCorsRequest, VoidOutcome>(this, client_, &OssClient::SetBucketCors, request);
+}
+
+VoidOutcomeCallable OssClient::SetBucketStorageCapacityCallable(const SetBucketStorageCapacityRequest &request) const
+{
+    return CallableCall<SetBucketStorageCapacityRequest, VoidOutcome>(this, client_, &OssClient::SetBucketStorageCapacity, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteBucketCallable(const DeleteBucketRequest &request) const
+{
+    return CallableCall<DeleteBucketRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucket, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteBucketLoggingCallable(const DeleteBucketLoggingRequest &request) const
+{
+    return CallableCall<DeleteBucketLoggingRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketLogging, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteBucketWebsiteCallable(const DeleteBucketWebsiteRequest &request) const
+{
+    return CallableCall<DeleteBucketWebsiteRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketWebsite, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteBucketLifecycleCallable(const DeleteBucketLifecycleRequest &request) const
+{
+    return CallableCall<DeleteBucketLifecycleRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketLifecycle, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteBucketCorsCallable(const DeleteBucketCorsRequest &request) const
+{
+    return CallableCall<DeleteBucketCorsRequest, VoidOutcome>(this, client_, &OssClient::DeleteBucketCors, request);
+}
+
+GetBucketAclOutcomeCallable OssClient::GetBucketAclCallable(const GetBucketAclRequest &request) const
+{
+    return CallableCall<GetBucketAclRequest, GetBucketAclOutcome>(this, client_, &OssClient::GetBucketAcl, request);
+}
+
+GetBucketLocationOutcomeCallable OssClient::GetBucketLocationCallable(const GetBucketLocationRequest &request) const
+{
+    return CallableCall<GetBucketLocationRequest, GetBucketLocationOutcome>(this, client_, &OssClient::GetBucketLocation, request);
+}
+
+GetBucketInfoOutcomeCallable OssClient::GetBucketInfoCallable(const GetBucketInfoRequest &request) const
+{
+    return CallableCall<GetBucketInfoRequest, GetBucketInfoOutcome>(this, client_, &OssClient::GetBucketInfo, request);
+}
+
+GetBucketLoggingOutcomeCallable OssClient::GetBucketLoggingCallable(const GetBucketLoggingRequest &request) const
+{
+    return CallableCall<GetBucketLoggingRequest, GetBucketLoggingOutcome>(this, client_, &OssClient::GetBucketLogging, request);
+}
+
+GetBucketWebsiteOutcomeCallable OssClient::GetBucketWebsiteCallable(const GetBucketWebsiteRequest &request) const
+{
+    return CallableCall<GetBucketWebsiteRequest, GetBucketWebsiteOutcome>(this, client_, &OssClient::GetBucketWebsite, request);
+}
+
+GetBucketRefererOutcomeCallable OssClient::GetBucketRefererCallable(const GetBucketRefererRequest &request) const
+{
+    return CallableCall<GetBucketRefererRequest, GetBucketRefererOutcome>(this, client_, &OssClient::GetBucketReferer, request);
+}
+
+GetBucketLifecycleOutcomeCallable OssClient::GetBucketLifecycleCallable(const GetBucketLifecycleRequest &request) const
+{
+    return CallableCall<GetBucketLifecycleRequest, GetBucketLifecycleOutcome>(this, client_, &OssClient::GetBucketLifecycle, request);
+}
+
+GetBucketStatOutcomeCallable OssClient::GetBucketStatCallable(const GetBucketStatRequest &request) const
+{
+    return CallableCall<GetBucketStatRequest, GetBucketStatOutcome>(this, client_, &OssClient::GetBucketStat, request);
+}
+
+GetBucketCorsOutcomeCallable OssClient::GetBucketCorsCallable(const GetBucketCorsRequest &request) const
+{
+    return CallableCall<GetBucketCorsRequest, GetBucketCorsOutcome>(this, client_, &OssClient::GetBucketCors, request);
+}
 
+GetBucketStorageCapacityOutcomeCallable OssClient::GetBucketStorageCapacityCallable(const GetBucketStorageCapacityRequest &request) const
+{
+    return CallableCall<GetBucketStorageCapacityRequest, GetBucketStorageCapacityOutcome>(this, client_, &OssClient::GetBucketStorageCapacity, request);
+}
+
+GetObjectOutcomeCallable OssClient::GetObjectCallable(const GetObjectRequest &request) const
+{
+    return CallableCall<GetObjectRequest, GetObjectOutcome>(this, client_, &OssClient::GetObject, request);
 }
 
 PutObjectOutcomeCallable OssClient::PutObjectCallable(const PutObjectRequest &request) const
 {
-    auto task = std::make_shared<std::packaged_task<PutObjectOutcome()>>(
-        [this, request]()
-    {
-        return this->PutObject(request);
-    });
-    client_->asyncExecute(new Runnable([task]() { (*task)(); }));
-    return task->get_future();
+    return CallableCall<PutObjectRequest, PutObjectOutcome>(this, client_, &OssClient::PutObject, request);
+}
+
+VoidOutcomeCallable OssClient::DeleteObjectCallable(const DeleteObjectRequest &request) const
+{
+    return CallableCall<DeleteObjectRequest, VoidOutcome>(this, client_, &OssClient::DeleteObject, request);
+}
+
+DeleteObjecstOutcomeCallable OssClient::DeleteObjectsCallable(const DeleteObjectsRequest &request) const
+{
+    return CallableCall<DeleteObjectsRequest, DeleteObjecstOutcome>(this, client_, &OssClient::DeleteObjects, request);
+}
+
+ObjectMetaDataOutcomeCallable OssClient::HeadObjectCallable(const HeadObjectRequest &request) const
+{
+    return CallableCall<HeadObjectRequest, ObjectMetaDataOutcome>(this, client_, &OssClient::HeadObject, request);
+}
+
+ObjectMetaDataOutcomeCallable OssClient::GetObjectMetaCallable(const GetObjectMetaRequest &request) const
+{
+    return CallableCall<GetObjectMetaRequest, ObjectMetaDataOutcome>(this, client_, &OssClient::GetObjectMeta, request);
+}
+
+AppendObjectOutcomeCallable OssClient::AppendObjectCallable(const AppendObjectRequest &request) const
+{
+    return CallableCall<AppendObjectRequest, AppendObjectOutcome>(this, client_, &OssClient::AppendObject, request);
+}
+
+CopyObjectOutcomeCallable OssClient::CopyObjectCallable(const CopyObjectRequest &request) const
+{
+    return CallableCall<CopyObjectRequest, CopyObjectOutcome>(this, client_, &OssClient::CopyObject, request);
+}
+
+VoidOutcomeCallable OssClient::RestoreObjectCallable(const RestoreObjectRequest &request) const
+{
+    return CallableCall<RestoreObjectRequest, VoidOutcome>(this, client_, &OssClient::RestoreObject, request);
+}
+
+VoidOutcomeCallable OssClient::SetObjectAclCallable(const SetObjectAclRequest &request) const
+{
+    return CallableCall<SetObjectAclRequest, VoidOutcome>(this, client_, &OssClient::SetObjectAcl, request);
+}
+
+GetObjectAclOutcomeCallable OssClient::GetObjectAclCallable(const GetObjectAclRequest &request) const
+{
+    return CallableCall<GetObjectAclRequest, GetObjectAclOutcome>(this, client_, &OssClient::GetObjectAcl, request);
+}
+
+CreateSymlinkOutcomeCallable OssClient::CreateSymlinkCallable(const CreateSymlinkRequest &request) const
+{
+    return CallableCall<CreateSymlinkRequest, CreateSymlinkOutcome>(this, client_, &OssClient::CreateSymlink, request);
+}
+
+GetSymlinkOutcomeCallable OssClient::GetSymlinkCallable(const GetSymlinkRequest &request) const
+{
+    return CallableCall<GetSymlinkRequest, GetSymlinkOutcome>(this, client_, &OssClient::GetSymlink, request);
+}
+
+InitiateMultipartUploadOutcomeCallable OssClient::InitiateMultipartUploadCallable(const InitiateMultipartUploadRequest &request) const
+{
+    return CallableCall<InitiateMultipartUploadRequest, InitiateMultipartUploadOutcome>(this, client_, &OssClient::InitiateMultipartUpload, request);
 }
 
 PutObjectOutcomeCallable OssClient::UploadPartCallable(const UploadPartRequest &request) const
 {
-    auto task = std::make_shared<std::packaged_task<PutObjectOutcome()>>(
-        [this, request]()
-    {
-        return this->UploadPart(request);
-    });
-    client_->asyncExecute(new Runnable([task]() { (*task)(); }));
-    return task->get_future();
+    return CallableCall<UploadPartRequest, PutObjectOutcome>(this, client_, &OssClient::UploadPart, request);
 }
 
 UploadPartCopyOutcomeCallable OssClient::UploadPartCopyCallable(const UploadPartCopyRequest &request) const
 {
-    auto task = std::make_shared<std::packaged_task<UploadPartCopyOutcome()>>(
-        [this, request]()
-    {
-        return this->UploadPartCopy(request);
-    });
-    client_->asyncExecute(new Runnable([task]() { (*task)(); }));
-    return task->get_future();
+    return CallableCall<UploadPartCopyRequest, UploadPartCopyOutcome>(this, client_, &OssClient::UploadPartCopy, request);
+}
+
+CompleteMultipartUploadOutcomeCallable OssClient::CompleteMultipartUploadCallable(const CompleteMultipartUploadRequest &request) const
+{
+    return CallableCall<CompleteMultipartUploadRequest, CompleteMultipartUploadOutcome>(this, client_, &OssClient::CompleteMultipartUpload, request);
+}
+
+VoidOutcomeCallable OssClient::AbortMultipartUploadCallable(const AbortMultipartUploadRequest &request) const
+{
+    return CallableCall<AbortMultipartUploadRequest, VoidOutcome>(this, client_, &OssClient::AbortMultipartUpload, request);
+}
+
+ListMultipartUploadsOutcomeCallable OssClient::ListMultipartUploadsCallable(const ListMultipartUploadsRequest &request) const
+{
+    return CallableCall<ListMultipartUploadsRequest, ListMultipartUploadsOutcome>(this, client_, &OssClient::ListMultipartUploads, request);
+}
+
+ListPartsOutcomeCallable OssClient::ListPartsCallable(const ListPartsRequest &request) const
+{
+    return CallableCall<ListPartsRequest, ListPartsOutcome>(this, client_, &OssClient::ListParts, request);
+}
+
+GetObjectOutcomeCallable OssClient::GetObjectByUrlCallable(const GetObjectByUrlRequest &request) const
+{
+    return CallableCall<GetObjectByUrlRequest, GetObjectOutcome>(this, client_, &OssClient::GetObjectByUrl, request);
+}
+
+PutObjectOutcomeCallable OssClient::PutObjectByUrlCallable(const PutObjectByUrlRequest &request) const
+{
+    return CallableCall<PutObjectByUrlRequest, PutObjectOutcome>(this, client_, &OssClient::PutObjectByUrl, request);
 }
 
 /*Extended APIs*/
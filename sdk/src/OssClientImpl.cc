@@ -20,6 +20,7 @@
 #include <set>
 #include <tinyxml2/tinyxml2.h>
 #include <alibabacloud/oss/http/HttpType.h>
+#include <alibabacloud/oss/client/MetricsRegistry.h>
 #include "utils/Utils.h"
 #include "utils/SignUtils.h"
 #include "auth/HmacSha1Signer.h"
@@ -33,6 +34,51 @@ namespace
 {
 const std::string SERVICE_NAME = "OSS";
 const char *TAG = "OssClientImpl";
+
+/*
+* The last signatures made by a thread. The canonical string holds the Date,
+* so an entry only matches the requests of the same second.
+* An entry is picked by a hash of the canonical string, and only matches the same
+* canonical string signed with the same key id and secret. Credentials providers may
+* hand out a new snapshot per call, so the values are compared, not the snapshot.
+* The secret is kept per thread as the key cache of HmacSha1Signer does.
+*/
+struct SignatureCache
+{
+    static const size_t SIZE = 16;
+    struct Entry {
+        std::string canonical;
+        std::string keyId;
+        std::string secret;
+        std::string signature;
+    };
+
+    std::string sign(const Signer &signer, const std::string &canonical, const Credentials &credentials)
+    {
+        Entry &entry = entries[std::hash<std::string>()(canonical) % SIZE];
+        if (!entry.signature.empty() && entry.canonical == canonical &&
+            entry.keyId == credentials.AccessKeyId() && entry.secret == credentials.AccessKeySecret()) {
+            return entry.signature;
+        }
+        entry.signature = signer.generate(canonical, credentials.AccessKeySecret());
+        entry.canonical = canonical;
+        entry.keyId = credentials.AccessKeyId();
+        entry.secret = credentials.AccessKeySecret();
+        return entry.signature;
+    }
+
+    Entry entries[SIZE];
+};
+
+std::string GenerateSignature(const Signer &signer, const std::string &canonical,
+    const Credentials &credentials, bool useCache)
+{
+    if (!useCache) {
+        return signer.generate(canonical, credentials.AccessKeySecret());
+    }
+    static thread_local SignatureCache cache;
+    return cache.sign(signer, canonical, credentials);
+}
 }
 
 OssClientImpl::OssClientImpl(const std::string &endpoint, const std::shared_ptr<CredentialsProvider>& credentialsProvider, const ClientConfiguration & configuration) :
@@ -40,12 +86,25 @@ OssClientImpl::OssClientImpl(const std::string &endpoint, const std::shared_ptr<
     endpoint_(endpoint),
     credentialsProvider_(credentialsProvider),
     signer_(std::make_shared<HmacSha1Signer>()),
-    executor_(std::make_shared<Executor>())
+    executor_(std::make_shared<Executor>(configuration.maxConnections))
 {
+    if (configuration.metricsRegistry != nullptr) {
+        Executor *executor = executor_.get();
+        gaugeIds_.push_back(configuration.metricsRegistry->addGauge("oss_executor_queue_depth",
+            [executor]() { return static_cast<int64_t>(executor->queueSize()); }));
+        gaugeIds_.push_back(configuration.metricsRegistry->addGauge("oss_executor_threads",
+            [executor]() { return static_cast<int64_t>(executor->threadCount()); }));
+    }
+    if (configuration.warmupConnections > 0) {
+        warmUp(CombineHostString(endpoint_, configuration.warmupBucket, configuration.isCname).append("/"));
+    }
 }
 
 OssClientImpl::~OssClientImpl()
 {
+    for (auto id : gaugeIds_) {
+        configuration().metricsRegistry->removeGauge(id);
+    }
 }
 
 int OssClientImpl::asyncExecute(Runnable * r) const
@@ -60,6 +119,7 @@ int OssClientImpl::asyncExecute(Runnable * r) const
 std::shared_ptr<HttpRequest> OssClientImpl::buildHttpRequest(const std::string & endpoint, const ServiceRequest & msg, Http::Method method) const
 {
     auto httpRequest = std::make_shared<HttpRequest>(method);
+    httpRequest->setTraced(configuration().tracer != nullptr);
     auto calcContentMD5 = !!(msg.Flags()&REQUEST_FLAG_CONTENTMD5);
     auto paramInPath = !!(msg.Flags()&REQUEST_FLAG_PARAM_IN_PATH);
     httpRequest->setResponseStreamFactory(msg.ResponseStreamFactory());
@@ -89,6 +149,9 @@ bool OssClientImpl::hasResponseError(const std::shared_ptr<HttpResponse>&respons
         uint64_t serverCrc64 = std::strtoull(response->Header("x-oss-hash-crc64ecma").c_str(), nullptr, 10);
         if (clientCrc64 != serverCrc64) {
             response->setStatusCode(ERROR_CRC_INCONSISTENT);
+            if (metrics() != nullptr) {
+                metrics()->crc64Mismatch->add();
+            }
             std::stringstream ss;
             ss << "Crc64 validation failed. Expected hash:" << serverCrc64
                 << " not equal to calculated hash:" << clientCrc64
@@ -102,10 +165,16 @@ bool OssClientImpl::hasResponseError(const std::shared_ptr<HttpResponse>&respons
 }
 
 
-void OssClientImpl::addHeaders(const std::shared_ptr<HttpRequest> &httpRequest, const HeaderCollection &headers) const
+void OssClientImpl::addHeaders(const std::shared_ptr<HttpRequest> &httpRequest, HeaderCollection &&headers) const
 {
-    for (auto const& header : headers) {
-        httpRequest->addHeader(header.first, header.second);
+    //the request is new, so the headers are moved in rather than copied one by one
+    if (httpRequest->Headers().empty()) {
+        httpRequest->setHeaders(std::move(headers));
+    }
+    else {
+        for (auto const& header : headers) {
+            httpRequest->addHeader(header.first, header.second);
+        }
     }
 
     //common headers
@@ -113,8 +182,7 @@ void OssClientImpl::addHeaders(const std::shared_ptr<HttpRequest> &httpRequest,
 
     //Date
     if (!httpRequest->hasHeader(Http::DATE)) {
-        std::time_t t = std::time(nullptr);
-        httpRequest->addHeader(Http::DATE, ToGmtTime(t));
+        httpRequest->addHeader(Http::DATE, CurrentGmtTime());
     }
 }
 
@@ -144,16 +212,17 @@ void OssClientImpl::addBody(const std::shared_ptr<HttpRequest> &httpRequest, con
 
 void OssClientImpl::addSignInfo(const std::shared_ptr<HttpRequest> &httpRequest, const ServiceRequest &request) const
 {
-    const Credentials credentials = credentialsProvider_->getCredentials();
+    if (httpRequest->isTraced()) {
+        httpRequest->PhaseTimings().signStart = std::chrono::steady_clock::now();
+    }
+    const auto snapshot = credentialsProvider_->getCredentialsSnapshot();
+    const Credentials &credentials = *snapshot;
     if (!credentials.SessionToken().empty()) {
         httpRequest->addHeader("x-oss-security-token", credentials.SessionToken());
     }
 
-    //Sort the parameters
-    ParameterCollection parameters;
-    for (auto const&param : request.Parameters()) {
-        parameters[param.first] = param.second;
-    }
+    //ParameterCollection is sorted already
+    const ParameterCollection &parameters = request.Parameters();
 
     std::string method = Http::MethodToString(httpRequest->method());
 
@@ -172,19 +241,20 @@ void OssClientImpl::addSignInfo(const std::shared_ptr<HttpRequest> &httpRequest,
 
     SignUtils signUtils(signer_->version());
     signUtils.build(method, resource, date, httpRequest->Headers(), parameters);
-    auto signature = signer_->generate(signUtils.CanonicalString(), credentials.AccessKeySecret());
+    auto signature = GenerateSignature(*signer_, signUtils.CanonicalString(), credentials,
+        configuration().enableSignatureCache);
 
-    std::stringstream authValue;
-    authValue
-        << "OSS "
-        << credentials.AccessKeyId()
-        << ":"
-        << signature;
+    std::string authValue;
+    authValue.reserve(4 + credentials.AccessKeyId().size() + 1 + signature.size());
+    authValue.append("OSS ").append(credentials.AccessKeyId()).append(":").append(signature);
 
-    httpRequest->addHeader(Http::AUTHORIZATION, authValue.str());
+    httpRequest->addHeader(Http::AUTHORIZATION, authValue);
+    if (httpRequest->isTraced()) {
+        httpRequest->PhaseTimings().signEnd = std::chrono::steady_clock::now();
+    }
 
     OSS_LOG(LogLevel::LogDebug, TAG, "client(%p) request(%p) CanonicalString:%s", this, httpRequest.get(), signUtils.CanonicalString().c_str());
-    OSS_LOG(LogLevel::LogDebug, TAG, "client(%p) request(%p) Authorization:%s", this, httpRequest.get(), authValue.str().c_str());
+    OSS_LOG(LogLevel::LogDebug, TAG, "client(%p) request(%p) Authorization:%s", this, httpRequest.get(), authValue.c_str());
 }
 
 void OssClientImpl::addUrl(const std::shared_ptr<HttpRequest> &httpRequest, const std::string &endpoint, const ServiceRequest &request) const
@@ -199,15 +269,7 @@ void OssClientImpl::addUrl(const std::shared_ptr<HttpRequest> &httpRequest, cons
 
     auto parameters = request.Parameters();
     if (!parameters.empty()) {
-        std::stringstream queryString;
-        for (const auto &p : parameters)
-        {
-            if (p.second.empty())
-                queryString << "&" << UrlEncode(p.first);
-            else
-                queryString << "&" << UrlEncode(p.first) << "=" << UrlEncode(p.second);
-        }
-        url.setQuery(queryString.str().substr(1));
+        url.setQuery(CombineQueryString(parameters));
     }
     httpRequest->setUrl(url);
 }
@@ -217,6 +279,10 @@ void OssClientImpl::addOther(const std::shared_ptr<HttpRequest> &httpRequest, co
     //progress
     httpRequest->setTransferProgress(request.TransferProgress());
 
+    //cancellation
+    httpRequest->setCancellationToken(request.CancellationToken());
+    httpRequest->setDeadline(request.Deadline());
+
     //crc64 check
     auto checkCRC64 = !!(request.Flags()&REQUEST_FLAG_CHECK_CRC64);
     if (configuration().enableCrc64 &&
@@ -282,7 +348,8 @@ ServiceResult OssClientImpl::buildResult(const std::shared_ptr<HttpResponse> &ht
     result.setRequestId(httpResponse->Header("x-oss-request-id"));
     result.setPlayload(httpResponse->Body());
     result.setResponseCode(httpResponse->statusCode());
-    result.setHeaderCollection(httpResponse->Headers());
+    //the response is dropped after this, its headers are moved
+    result.setHeaderCollection(httpResponse->releaseHeaders());
     return result;
 }
 
@@ -828,7 +895,8 @@ StringOutcome OssClientImpl::GeneratePresignedUrl(const GeneratePresignedUrlRequ
     }
 
     ParameterCollection parameters;
-    const Credentials credentials = credentialsProvider_->getCredentials();
+    const auto snapshot = credentialsProvider_->getCredentialsSnapshot();
+    const Credentials &credentials = *snapshot;
     if (!credentials.SessionToken().empty()) {
         parameters["security-token"] = credentials.SessionToken();
     }
@@ -841,7 +909,8 @@ StringOutcome OssClientImpl::GeneratePresignedUrl(const GeneratePresignedUrlRequ
     auto resource = std::string().append("/").append(request.bucket_).append("/").append(request.key_);
     auto date = headers[Http::EXPIRES];
     signUtils.build(method, resource, date, headers, parameters);
-    auto signature = signer_->generate(signUtils.CanonicalString(), credentials.AccessKeySecret());
+    auto signature = GenerateSignature(*signer_, signUtils.CanonicalString(), credentials,
+        configuration().enableSignatureCache);
     parameters["Expires"] = date;
     parameters["OSSAccessKeyId"] = credentials.AccessKeyId();
     parameters["Signature"] = signature;
@@ -855,6 +924,72 @@ StringOutcome OssClientImpl::GeneratePresignedUrl(const GeneratePresignedUrlRequ
     return StringOutcome(ss.str());
 }
 
+PresignedUrlListOutcome OssClientImpl::GeneratePresignedUrls(const std::string &bucket, const std::vector<std::string> &keys,
+    int64_t expires, Http::Method method) const
+{
+    if (!IsValidBucketName(bucket)) {
+        return PresignedUrlListOutcome(OssError("ValidateError", "The Bucket or Key is invalid."));
+    }
+    for (auto const &key : keys) {
+        if (!IsValidObjectKey(key)) {
+            return PresignedUrlListOutcome(OssError("ValidateError", "The Bucket or Key is invalid."));
+        }
+    }
+
+    //everything but the key is the same for each url, so it is built once
+    const auto snapshot = credentialsProvider_->getCredentialsSnapshot();
+    const Credentials &credentials = *snapshot;
+    const std::string date = std::to_string(expires);
+
+    //VERB\n\n\nExpires\n/bucket/key[?security-token=...], see SignUtils::build
+    std::string canonical;
+    canonical.append(Http::MethodToString(method)).append("\n\n\n").append(date).append("\n/").append(bucket).append("/");
+    const size_t canonicalPrefix = canonical.size();
+    std::string canonicalSuffix;
+    if (!credentials.SessionToken().empty()) {
+        canonicalSuffix.append("?security-token=").append(credentials.SessionToken());
+    }
+
+    //host/path/key?Expires=...&OSSAccessKeyId=...&Signature=...[&security-token=...], in CombineQueryString order
+    std::string urlPrefix = CombineHostString(endpoint_, bucket, configuration().isCname);
+    urlPrefix.append(CombinePathString(endpoint_, bucket, ""));
+    std::string queryPrefix;
+    queryPrefix.append("?Expires=").append(UrlEncode(date));
+    queryPrefix.append("&OSSAccessKeyId=").append(UrlEncode(credentials.AccessKeyId()));
+    queryPrefix.append("&Signature=");
+    std::string querySuffix;
+    if (!credentials.SessionToken().empty()) {
+        querySuffix.append("&security-token=").append(UrlEncode(credentials.SessionToken()));
+    }
+
+    PresignedUrlList list;
+    size_t size = 0;
+    for (auto const &key : keys) {
+        //a key may grow 3 times when encoded, the signature is at most 28*3 bytes
+        size += urlPrefix.size() + key.size() * 3 + queryPrefix.size() + 84 + querySuffix.size() + 1;
+    }
+    list.buffer_.reserve(size);
+    list.offsets_.reserve(keys.size());
+
+    std::string &out = list.buffer_;
+    for (auto const &key : keys) {
+        canonical.resize(canonicalPrefix);
+        canonical.append(key).append(canonicalSuffix);
+        auto signature = signer_->generate(canonical, credentials.AccessKeySecret());
+
+        size_t offset = out.size();
+        out.append(urlPrefix);
+        UrlEncode(key.data(), key.size(), out);
+        out.append(queryPrefix);
+        UrlEncode(signature.data(), signature.size(), out);
+        out.append(querySuffix);
+        list.offsets_.push_back(std::make_pair(offset, out.size() - offset));
+        out.push_back('\0');
+    }
+
+    return PresignedUrlListOutcome(std::move(list));
+}
+
 GetObjectOutcome OssClientImpl::GetObjectByUrl(const GetObjectByUrlRequest &request) const
 {
     auto outcome = BASE::AttemptRequest(endpoint_, request, Http::Method::Get);
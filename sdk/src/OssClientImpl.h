@@ -99,6 +99,7 @@ namespace OSS
         
         /*Generate URL*/
         StringOutcome GeneratePresignedUrl(const GeneratePresignedUrlRequest &request) const;
+        PresignedUrlListOutcome GeneratePresignedUrls(const std::string &bucket, const std::vector<std::string> &keys, int64_t expires, Http::Method method) const;
         GetObjectOutcome GetObjectByUrl(const GetObjectByUrlRequest &request) const;
         PutObjectOutcome PutObjectByUrl(const PutObjectByUrlRequest &request) const;
 
@@ -119,7 +120,7 @@ namespace OSS
         OssOutcome MakeRequest(const OssRequest &request, Http::Method method) const;
 
     private:
-        void addHeaders(const std::shared_ptr<HttpRequest> &httpRequest, const HeaderCollection &headers) const;
+        void addHeaders(const std::shared_ptr<HttpRequest> &httpRequest, HeaderCollection &&headers) const;
         void addBody(const std::shared_ptr<HttpRequest> &httpRequest, const std::shared_ptr<std::iostream>& body, bool contentMd5 = false) const;
         void addSignInfo(const std::shared_ptr<HttpRequest> &httpRequest, const ServiceRequest &request) const;
         void addUrl(const std::shared_ptr<HttpRequest> &httpRequest, const std::string &endpoint, const ServiceRequest &request) const;
@@ -133,6 +134,7 @@ namespace OSS
         std::shared_ptr<CredentialsProvider> credentialsProvider_;
         std::shared_ptr<Signer> signer_;
         std::shared_ptr< Executor> executor_;
+        std::vector<uint64_t> gaugeIds_;
     };
 }
 }
@@ -15,6 +15,7 @@
  */
 
 #include <alibabacloud/oss/ServiceRequest.h>
+#include <alibabacloud/oss/client/CancellationToken.h>
 #include <sstream>
 
 using namespace AlibabaCloud::OSS;
@@ -23,7 +24,9 @@ ServiceRequest::ServiceRequest() :
     flags_(0),
     path_("/"),
     responseStreamFactory_([] { return std::make_shared<std::stringstream>(); }),
-    transferProgress_{nullptr, nullptr}
+    transferProgress_{nullptr, nullptr},
+    cancellationToken_(nullptr),
+    deadline_((std::chrono::steady_clock::time_point::max)())
 {
 }
 
@@ -57,6 +60,41 @@ void ServiceRequest::setTransferProgress(const AlibabaCloud::OSS::TransferProgre
     transferProgress_ = arg; 
 }
 
+const std::shared_ptr<CancellationToken>& ServiceRequest::CancellationToken() const
+{
+    return cancellationToken_;
+}
+
+void ServiceRequest::setCancellationToken(const std::shared_ptr<AlibabaCloud::OSS::CancellationToken>& token)
+{
+    cancellationToken_ = token;
+}
+
+const std::chrono::steady_clock::time_point& ServiceRequest::Deadline() const
+{
+    return deadline_;
+}
+
+void ServiceRequest::setDeadline(const std::chrono::steady_clock::time_point& deadline)
+{
+    deadline_ = deadline;
+}
+
+bool ServiceRequest::hasDeadline() const
+{
+    return deadline_ != (std::chrono::steady_clock::time_point::max)();
+}
+
+const SpanContext& ServiceRequest::TraceContext() const
+{
+    return traceContext_;
+}
+
+void ServiceRequest::setTraceContext(const SpanContext& context)
+{
+    traceContext_ = context;
+}
+
 void ServiceRequest::setPath(const std::string & path)
 {
     path_ = path;
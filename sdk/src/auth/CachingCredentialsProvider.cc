@@ -0,0 +1,177 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <alibabacloud/oss/auth/CachingCredentialsProvider.h>
+#include <alibabacloud/oss/client/ClientConfiguration.h>
+#include <json/json.h>
+#include <random>
+#include <sstream>
+#include "../http/CurlHttpClient.h"
+#include "../utils/Utils.h"
+#include "../utils/LogUtils.h"
+
+using namespace AlibabaCloud::OSS;
+
+static const char *TAG = "CachingCredentialsProvider";
+
+CachingCredentialsProvider::CachingCredentialsProvider(const CredentialsFetcher &fetcher, long refreshAheadSec,
+    long maxJitterSec, long retryDelaySec) :
+    CredentialsProvider(),
+    fetcher_(fetcher),
+    refreshAheadSec_(refreshAheadSec),
+    maxJitterSec_(maxJitterSec),
+    retryDelaySec_(retryDelaySec > 0 ? retryDelaySec : 1),
+    credentials_(std::make_shared<const Credentials>("", "", "")),
+    expiration_(0),
+    lastFetchFailed_(false),
+    stopped_(false)
+{
+    refresh();
+    thread_ = std::thread(&CachingCredentialsProvider::refreshLoop, this);
+}
+
+CachingCredentialsProvider::~CachingCredentialsProvider()
+{
+    {
+        std::lock_guard<std::mutex> locker(lock_);
+        stopped_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+Credentials CachingCredentialsProvider::getCredentials()
+{
+    return *getCredentialsSnapshot();
+}
+
+std::shared_ptr<const Credentials> CachingCredentialsProvider::getCredentialsSnapshot()
+{
+    /*
+    * Not lock-free: the shared_ptr atomic functions take a mutex from a small
+    * pool hashed by address (libstdc++). The critical section is a reference
+    * count increment and never waits on a fetch, which is what readers need.
+    */
+    return std::atomic_load(&credentials_);
+}
+
+std::time_t CachingCredentialsProvider::Expiration() const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    return expiration_;
+}
+
+bool CachingCredentialsProvider::refresh()
+{
+    Credentials credentials("", "", "");
+    std::time_t expiration = 0;
+    bool ok = fetcher_ && fetcher_(credentials, expiration);
+    if (ok) {
+        std::atomic_store(&credentials_, std::make_shared<const Credentials>(credentials));
+    }
+    else {
+        OSS_LOG(LogLevel::LogError, TAG, "provider(%p) fetch credentials fail", this);
+    }
+
+    std::lock_guard<std::mutex> locker(lock_);
+    if (ok) {
+        expiration_ = expiration;
+    }
+    lastFetchFailed_ = !ok;
+    return ok;
+}
+
+long CachingCredentialsProvider::nextRefreshDelaySec()
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    if (lastFetchFailed_) {
+        return retryDelaySec_;
+    }
+    long jitter = 0;
+    if (maxJitterSec_ > 0) {
+        static thread_local std::mt19937 engine(std::random_device{}());
+        jitter = std::uniform_int_distribution<long>(0, maxJitterSec_)(engine);
+    }
+    long delay = static_cast<long>(expiration_ - std::time(nullptr)) - refreshAheadSec_ - jitter;
+    return delay > 0 ? delay : 0;
+}
+
+void CachingCredentialsProvider::refreshLoop()
+{
+    for (;;) {
+        long delaySec = nextRefreshDelaySec();
+        {
+            std::unique_lock<std::mutex> locker(lock_);
+            if (cv_.wait_for(locker, std::chrono::seconds(delaySec), [this]() { return stopped_; })) {
+                return;
+            }
+        }
+        //an expired or failed fetch is retried no faster than retryDelaySec_
+        if (!refresh() || nextRefreshDelaySec() == 0) {
+            std::unique_lock<std::mutex> locker(lock_);
+            if (cv_.wait_for(locker, std::chrono::seconds(retryDelaySec_), [this]() { return stopped_; })) {
+                return;
+            }
+        }
+    }
+}
+
+CachingCredentialsProvider::CredentialsFetcher CachingCredentialsProvider::MetadataUrlFetcher(const std::string &url, long timeoutMs)
+{
+    ClientConfiguration conf;
+    conf.maxConnections = 1;
+    conf.connectTimeoutMs = timeoutMs;
+    conf.requestTimeoutMs = timeoutMs;
+    auto httpClient = std::make_shared<CurlHttpClient>(conf);
+
+    return [httpClient, url](Credentials &credentials, std::time_t &expiration) -> bool
+    {
+        auto request = std::make_shared<HttpRequest>(Http::Method::Get);
+        request->setUrl(Url(url));
+        request->setResponseStreamFactory([]() { return std::make_shared<std::stringstream>(); });
+        auto response = httpClient->makeRequest(request);
+        if (response->statusCode() != 200 || response->Body() == nullptr) {
+            OSS_LOG(LogLevel::LogError, TAG, "fetch credentials from metadata url fail, status:%d", response->statusCode());
+            return false;
+        }
+
+        Json::CharReaderBuilder builder;
+        Json::Value root;
+        std::string errors;
+        if (!Json::parseFromStream(builder, *response->Body(), &root, &errors) || !root.isObject()) {
+            OSS_LOG(LogLevel::LogError, TAG, "parse credentials fail, %s", errors.c_str());
+            return false;
+        }
+        if (root.isMember("Code") && root["Code"].asString() != "Success") {
+            OSS_LOG(LogLevel::LogError, TAG, "fetch credentials fail, Code:%s", root["Code"].asString().c_str());
+            return false;
+        }
+
+        std::time_t t = UtcToUnixTime(root["Expiration"].asString());
+        if (root["AccessKeyId"].asString().empty() || root["AccessKeySecret"].asString().empty() || t < 0) {
+            OSS_LOG(LogLevel::LogError, TAG, "credentials from metadata url are incomplete");
+            return false;
+        }
+        credentials.setAccessKeyId(root["AccessKeyId"].asString());
+        credentials.setAccessKeySecret(root["AccessKeySecret"].asString());
+        credentials.setSessionToken(root["SecurityToken"].asString());
+        expiration = t;
+        return true;
+    };
+}
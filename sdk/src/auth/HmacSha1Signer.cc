@@ -19,11 +19,96 @@
 #include <windows.h>
 #include <wincrypt.h>
 #else
-#include <openssl/hmac.h>
+#include <openssl/evp.h>
+#include <cstring>
 #endif
 
 using namespace AlibabaCloud::OSS;
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#endif
+
+namespace
+{
+    const int SHA1_BLOCK_SIZE = 64;
+    const int SHA1_DIGEST_SIZE = 20;
+    const int CACHED_KEY_COUNT = 4;
+
+    /*
+    * The sha1 state after the ipad and opad blocks of one key, so signing
+    * with a known key only hashes the message and the inner digest.
+    */
+    struct HmacKey
+    {
+        HmacKey() : inner(nullptr), outer(nullptr) {}
+        ~HmacKey()
+        {
+            if (inner) EVP_MD_CTX_free(inner);
+            if (outer) EVP_MD_CTX_free(outer);
+        }
+
+        bool init(const std::string &key)
+        {
+            unsigned char block[SHA1_BLOCK_SIZE];
+            unsigned char pad[SHA1_BLOCK_SIZE];
+            std::memset(block, 0, sizeof(block));
+            if (key.size() > SHA1_BLOCK_SIZE) {
+                unsigned int len = 0;
+                if (!EVP_Digest(key.c_str(), key.size(), block, &len, EVP_sha1(), nullptr))
+                    return false;
+            }
+            else {
+                std::memcpy(block, key.c_str(), key.size());
+            }
+
+            if (!inner) inner = EVP_MD_CTX_new();
+            if (!outer) outer = EVP_MD_CTX_new();
+            if (!inner || !outer) {
+                secret.clear();
+                return false;
+            }
+
+            for (int i = 0; i < SHA1_BLOCK_SIZE; i++) pad[i] = block[i] ^ 0x36;
+            bool ok = EVP_DigestInit_ex(inner, EVP_sha1(), nullptr) &&
+                EVP_DigestUpdate(inner, pad, SHA1_BLOCK_SIZE);
+            for (int i = 0; i < SHA1_BLOCK_SIZE; i++) pad[i] = block[i] ^ 0x5c;
+            ok = ok && EVP_DigestInit_ex(outer, EVP_sha1(), nullptr) &&
+                EVP_DigestUpdate(outer, pad, SHA1_BLOCK_SIZE);
+            secret = ok ? key : std::string();
+            return ok;
+        }
+
+        std::string secret;
+        EVP_MD_CTX *inner;
+        EVP_MD_CTX *outer;
+    };
+
+    //each thread keeps the keys of its last few credentials
+    struct HmacKeyCache
+    {
+        HmacKeyCache() : work(EVP_MD_CTX_new()), next(0) {}
+        ~HmacKeyCache() { if (work) EVP_MD_CTX_free(work); }
+
+        HmacKey *find(const std::string &secret)
+        {
+            for (int i = 0; i < CACHED_KEY_COUNT; i++) {
+                if (keys[i].inner != nullptr && keys[i].secret == secret) {
+                    return &keys[i];
+                }
+            }
+            HmacKey *key = &keys[next];
+            next = (next + 1) % CACHED_KEY_COUNT;
+            return key->init(secret) ? key : nullptr;
+        }
+
+        HmacKey keys[CACHED_KEY_COUNT];
+        EVP_MD_CTX *work;
+        int next;
+    };
+}
+
 HmacSha1Signer::HmacSha1Signer() :
     Signer(HmacSha1, "HMAC-SHA1", "1.0")
 {
@@ -84,16 +169,26 @@ std::string HmacSha1Signer::generate(const std::string & src, const std::string
     delete dest;
     return ret;
 #else
-    unsigned char md[EVP_MAX_BLOCK_LENGTH];
-    unsigned int mdLen = EVP_MAX_BLOCK_LENGTH;
+    static thread_local HmacKeyCache cache;
+    HmacKey *key = cache.work ? cache.find(secret) : nullptr;
+    if (key == nullptr)
+        return std::string();
 
-    if (HMAC(EVP_sha1(), secret.c_str(), secret.size(),
-        reinterpret_cast<const unsigned char*>(src.c_str()), src.size(),
-        md, &mdLen) == nullptr)
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int mdLen = 0;
+    EVP_MD_CTX *ctx = cache.work;
+    if (!EVP_MD_CTX_copy_ex(ctx, key->inner) ||
+        !EVP_DigestUpdate(ctx, src.c_str(), src.size()) ||
+        !EVP_DigestFinal_ex(ctx, md, &mdLen) ||
+        !EVP_MD_CTX_copy_ex(ctx, key->outer) ||
+        !EVP_DigestUpdate(ctx, md, mdLen) ||
+        !EVP_DigestFinal_ex(ctx, md, &mdLen))
         return std::string();
 
-    char encodedData[100];
-    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encodedData), md, mdLen);
-    return encodedData;
+    //20 bytes digest, 28 chars and the terminator written by EVP_EncodeBlock
+    std::string encoded(4 * ((SHA1_DIGEST_SIZE + 2) / 3) + 1, '\0');
+    int len = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), md, static_cast<int>(mdLen));
+    encoded.resize(len > 0 ? static_cast<size_t>(len) : 0);
+    return encoded;
 #endif
 }
\ No newline at end of file
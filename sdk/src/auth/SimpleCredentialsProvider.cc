@@ -20,7 +20,8 @@ using namespace AlibabaCloud::OSS;
 
 SimpleCredentialsProvider::SimpleCredentialsProvider(const Credentials &credentials):
     CredentialsProvider(),
-    credentials_(credentials)
+    credentials_(credentials),
+    snapshot_(std::make_shared<const Credentials>(credentials))
 {
 }
 
@@ -28,7 +29,8 @@ SimpleCredentialsProvider::SimpleCredentialsProvider(const std::string & accessK
     const std::string & accessKeySecret,
     const std::string &securityToken) :
     CredentialsProvider(),
-    credentials_(accessKeyId, accessKeySecret, securityToken)
+    credentials_(accessKeyId, accessKeySecret, securityToken),
+    snapshot_(std::make_shared<const Credentials>(credentials_))
 {
 }
 
@@ -40,3 +42,8 @@ Credentials SimpleCredentialsProvider::getCredentials()
 {
     return credentials_;
 }
+
+std::shared_ptr<const Credentials> SimpleCredentialsProvider::getCredentialsSnapshot()
+{
+    return snapshot_;
+}
@@ -32,8 +32,10 @@ namespace OSS
         ~SimpleCredentialsProvider();
 
         virtual Credentials getCredentials() override;
+        virtual std::shared_ptr<const Credentials> getCredentialsSnapshot() override;
     private:
         Credentials credentials_;
+        std::shared_ptr<const Credentials> snapshot_;
     };
 }
 }
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/client/AdaptiveRetryStrategy.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "../utils/Utils.h"
+
+using namespace AlibabaCloud::OSS;
+
+namespace
+{
+    long long NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::mt19937& RandomEngine()
+    {
+        static thread_local std::mt19937 engine(std::random_device{}());
+        return engine;
+    }
+
+    //the previous delay of the retry loop running on this thread
+    thread_local long PrevDelayMs = 0;
+}
+
+AdaptiveRetryStrategy::AdaptiveRetryStrategy(long maxRetries, long baseDelayMs, long maxDelayMs) :
+    maxRetries_(maxRetries),
+    baseDelayMs_((std::max)(1L, baseDelayMs)),
+    maxDelayMs_((std::max)(baseDelayMs_, maxDelayMs)),
+    maxTokens_(100.0),
+    tokenRatio_(0.1),
+    tokens_(100.0),
+    failureRatio_(0.5),
+    minimumRequests_(20),
+    windowMs_(10000),
+    openMs_(5000)
+{
+}
+
+AdaptiveRetryStrategy::~AdaptiveRetryStrategy()
+{
+}
+
+void AdaptiveRetryStrategy::setRetryBudget(double maxTokens, double tokenRatio)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    maxTokens_ = maxTokens;
+    tokenRatio_ = tokenRatio;
+    tokens_ = maxTokens;
+}
+
+void AdaptiveRetryStrategy::setCircuitBreaker(double failureRatio, long minimumRequests, long windowMs, long openMs)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    failureRatio_ = failureRatio;
+    minimumRequests_ = minimumRequests;
+    windowMs_ = windowMs;
+    openMs_ = openMs;
+}
+
+bool AdaptiveRetryStrategy::IsRetryableError(const Error& error)
+{
+    long responseCode = error.Status();
+
+    //http code
+    if (responseCode > 499 && responseCode < 600) {
+        return true;
+    }
+
+    switch (responseCode)
+    {
+    //curl error code, only the network ones. CURLE_WRITE_ERROR is the caller's response
+    //stream or an aborted transfer, it is neither retried nor held against the endpoint
+    case (ERROR_CURL_BASE + 7):  //CURLE_COULDNT_CONNECT
+    case (ERROR_CURL_BASE + 18): //CURLE_PARTIAL_FILE
+    case (ERROR_CURL_BASE + 28): //CURLE_OPERATION_TIMEDOUT
+    case (ERROR_CURL_BASE + 52): //CURLE_GOT_NOTHING
+    case (ERROR_CURL_BASE + 55): //CURLE_SEND_ERROR
+    case (ERROR_CURL_BASE + 56): //CURLE_RECV_ERROR
+        return true;
+    default:
+        break;
+    };
+
+    return false;
+}
+
+bool AdaptiveRetryStrategy::shouldRetry(const Error& error, long attemptedRetries) const
+{
+    if (attemptedRetries >= maxRetries_ || !IsRetryableError(error)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> locker(lock_);
+    return tokens_ > maxTokens_ / 2;
+}
+
+long AdaptiveRetryStrategy::calcDealyTimeMs(const Error& error, long attemptedRetries) const
+{
+    UNUSED_PARAM(error);
+    //decorrelated jitter, sleep = min(cap, random(base, prev * 3))
+    if (attemptedRetries == 0 || PrevDelayMs < baseDelayMs_) {
+        PrevDelayMs = baseDelayMs_;
+    }
+    long upper = static_cast<long>((std::min)(static_cast<long long>(maxDelayMs_),
+        static_cast<long long>(PrevDelayMs) * 3));
+    std::uniform_int_distribution<long> dist(baseDelayMs_, (std::max)(baseDelayMs_, upper));
+    PrevDelayMs = dist(RandomEngine());
+    return PrevDelayMs;
+}
+
+AdaptiveRetryStrategy::Circuit& AdaptiveRetryStrategy::circuit(const std::string& endpoint) const
+{
+    auto it = circuits_.find(endpoint);
+    if (it == circuits_.end()) {
+        Circuit c;
+        c.state = CircuitState::Closed;
+        c.openUntilMs = 0;
+        c.probing = false;
+        resetWindow(c, NowMs());
+        it = circuits_.insert(std::make_pair(endpoint, c)).first;
+    }
+    return it->second;
+}
+
+void AdaptiveRetryStrategy::resetWindow(Circuit& c, long long nowMs) const
+{
+    c.windowStartMs = nowMs;
+    c.requests = 0;
+    c.failures = 0;
+}
+
+bool AdaptiveRetryStrategy::allowRequest(const std::string& endpoint) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    Circuit& c = circuit(endpoint);
+    switch (c.state)
+    {
+    case CircuitState::Open:
+        if (NowMs() < c.openUntilMs) {
+            return false;
+        }
+        //let one probe request through
+        c.state = CircuitState::HalfOpen;
+        c.probing = true;
+        return true;
+    case CircuitState::HalfOpen:
+        if (c.probing) {
+            return false;
+        }
+        c.probing = true;
+        return true;
+    case CircuitState::Closed:
+    default:
+        return true;
+    }
+}
+
+void AdaptiveRetryStrategy::onRequestSuccess(const std::string& endpoint) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    tokens_ = (std::min)(maxTokens_, tokens_ + tokenRatio_);
+
+    Circuit& c = circuit(endpoint);
+    long long now = NowMs();
+    if (c.state != CircuitState::Closed) {
+        c.state = CircuitState::Closed;
+        c.probing = false;
+        resetWindow(c, now);
+    }
+    else if (now - c.windowStartMs > windowMs_) {
+        resetWindow(c, now);
+    }
+    c.requests++;
+}
+
+void AdaptiveRetryStrategy::onRequestFailure(const std::string& endpoint, const Error& error) const
+{
+    //the server answered, it is healthy from the breaker's point of view
+    if (!IsRetryableError(error)) {
+        onRequestSuccess(endpoint);
+        return;
+    }
+
+    std::lock_guard<std::mutex> locker(lock_);
+    tokens_ = (std::max)(0.0, tokens_ - 1.0);
+
+    Circuit& c = circuit(endpoint);
+    long long now = NowMs();
+    if (c.state == CircuitState::HalfOpen) {
+        c.state = CircuitState::Open;
+        c.openUntilMs = now + openMs_;
+        c.probing = false;
+        return;
+    }
+    if (c.state == CircuitState::Open) {
+        return;
+    }
+
+    if (now - c.windowStartMs > windowMs_) {
+        resetWindow(c, now);
+    }
+    c.requests++;
+    c.failures++;
+    if (c.requests >= minimumRequests_ &&
+        static_cast<double>(c.failures) >= failureRatio_ * static_cast<double>(c.requests)) {
+        c.state = CircuitState::Open;
+        c.openUntilMs = now + openMs_;
+    }
+}
+
+void AdaptiveRetryStrategy::onRequestAborted(const std::string& endpoint) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    Circuit& c = circuit(endpoint);
+    //an aborted probe proves nothing, wait another open period and probe again
+    if (c.state == CircuitState::HalfOpen && c.probing) {
+        c.state = CircuitState::Open;
+        c.openUntilMs = NowMs() + openMs_;
+        c.probing = false;
+    }
+}
+
+double AdaptiveRetryStrategy::RetryTokens() const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    return tokens_;
+}
+
+bool AdaptiveRetryStrategy::IsCircuitOpen(const std::string& endpoint) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    auto it = circuits_.find(endpoint);
+    return it != circuits_.end() && it->second.state != CircuitState::Closed;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <alibabacloud/oss/client/CancellationToken.h>
+
+using namespace AlibabaCloud::OSS;
+
+CancellationToken::CancellationToken() :
+    cancelled_(false)
+{
+}
+
+CancellationToken::~CancellationToken()
+{
+}
+
+void CancellationToken::cancel()
+{
+    cancelled_ = true;
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return cancelled_.load();
+}
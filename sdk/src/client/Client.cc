@@ -15,11 +15,17 @@
  */
 
 #include <alibabacloud/oss/client/RetryStrategy.h>
+#include <alibabacloud/oss/client/HedgePolicy.h>
+#include <alibabacloud/oss/client/EndpointBalancer.h>
+#include <alibabacloud/oss/client/CancellationToken.h>
+#include <alibabacloud/oss/client/MetricsRegistry.h>
+#include <alibabacloud/oss/client/Tracer.h>
 #include "Client.h"
 #include "../http/CurlHttpClient.h"
 #include "../utils/Executor.h"
 #include "../auth/Signer.h"
 #include <sstream>
+#include <algorithm>
 
 /*!
  * \class AlibabaCloud::Client Client.h 
@@ -33,6 +39,20 @@ Client::Client(const std::string & servicename, const ClientConfiguration &confi
     configuration_(configuration),
     httpClient_(std::make_shared<CurlHttpClient>(configuration))
 {
+    MetricsRegistry *registry = configuration.metricsRegistry.get();
+    if (registry != nullptr) {
+        metrics_.reset(new ClientMetrics());
+        for (int i = 0; i < ClientMetrics::MethodCount; i++) {
+            std::string label = "{method=\"" + Http::MethodToString(static_cast<Http::Method>(i)) + "\"}";
+            metrics_->requests[i] = registry->counter("oss_requests_total" + label);
+            metrics_->errors[i] = registry->counter("oss_request_errors_total" + label);
+            metrics_->retries[i] = registry->counter("oss_retries_total" + label);
+            metrics_->transferredBytes[i] = registry->counter("oss_transferred_bytes_total" + label);
+            metrics_->latency[i] = registry->histogram("oss_request_latency_us" + label);
+        }
+        metrics_->failFast = registry->counter("oss_circuit_open_rejections_total");
+        metrics_->crc64Mismatch = registry->counter("oss_crc64_mismatch_total");
+    }
 }
 
 Client::~Client()
@@ -49,37 +69,361 @@ std::string Client::serviceName()const
     return serviceName_;
 }
 
+//a GET which failed in the middle of the body is resumed from the last received byte
+struct Client::ResumeState
+{
+    IOStreamFactory factory;
+    std::shared_ptr<std::iostream> stream;
+    std::iostream::pos_type startPos;
+    int64_t received;
+    uint64_t crc64;
+    std::string etag;
+    bool streamUsed;
+};
+
+static bool isCancelled(const ServiceRequest &request)
+{
+    return request.CancellationToken() != nullptr && request.CancellationToken()->isCancelled();
+}
+
+static long remainingMs(const ServiceRequest &request)
+{
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        request.Deadline() - std::chrono::steady_clock::now()).count());
+}
+
+//the request is stopped by its cancellation token or deadline
+static bool buildAbortedError(const ServiceRequest &request, Error &error)
+{
+    if (isCancelled(request)) {
+        error = Error("ClientError:100004", "Request is cancelled by the cancellation token.");
+        error.setStatus(ERROR_REQUEST_CANCELLED);
+        return true;
+    }
+    if (request.hasDeadline() && remainingMs(request) <= 0) {
+        error = Error("ClientError:100005", "Request deadline exceeded.");
+        error.setStatus(ERROR_REQUEST_DEADLINE_EXCEEDED);
+        return true;
+    }
+    return false;
+}
+
+static long outcomeStatus(const Client::ClientOutcome &outcome)
+{
+    return outcome.isSuccess() ? outcome.result()->statusCode() : outcome.error().Status();
+}
+
+static void endSpan(Span &span, const Client::ClientOutcome &outcome)
+{
+    span.setAttribute("http.status_code", std::to_string(outcomeStatus(outcome)));
+    if (!outcome.isSuccess()) {
+        span.setAttribute("error.code", outcome.error().Code());
+    }
+    span.end(std::chrono::steady_clock::now());
+}
+
+void Client::recordRequest(Http::Method method, std::chrono::steady_clock::time_point startTime, bool success) const
+{
+    if (metrics_ == nullptr || method >= ClientMetrics::MethodCount) {
+        return;
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    metrics_->requests[method]->add();
+    if (!success) {
+        metrics_->errors[method]->add();
+    }
+    metrics_->latency[method]->record(static_cast<uint64_t>((std::max)(us, static_cast<decltype(us)>(0))));
+}
+
 Client::ClientOutcome Client::AttemptRequest(const std::string & endpoint, const ServiceRequest & request, Http::Method method) const
 {
+    auto startTime = std::chrono::steady_clock::now();
+    Tracer *tracer = configuration().tracer.get();
+    std::shared_ptr<Span> requestSpan;
+    if (tracer != nullptr) {
+        requestSpan = tracer->startSpan("oss.request", request.TraceContext(), startTime);
+        if (requestSpan != nullptr) {
+            requestSpan->setAttribute("http.method", Http::MethodToString(method));
+            requestSpan->setAttribute("oss.endpoint", endpoint);
+        }
+    }
+
+    ResumeState resumeState;
+    resumeState.factory = request.ResponseStreamFactory();
+    resumeState.startPos = -1;
+    resumeState.received = 0;
+    resumeState.crc64 = 0;
+    resumeState.streamUsed = false;
+    ResumeState *resume = (method == Http::Method::Get && request.ResponseStreamFactory()) ? &resumeState : nullptr;
+
+    RetryStrategy *retryStrategy = configuration().retryStrategy.get();
+    EndpointBalancer *balancer = configuration().endpointBalancer.get();
+    //a retry moves to another endpoint only if the request is safe to repeat there
+    const bool failover = method != Http::Method::Post;
+    std::string attemptEndpoint = endpoint;
     for (int retry =0; ;retry++) {
-        auto outcome = AttemptOnceRequest(endpoint, request, method);
+        if (balancer != nullptr && (retry == 0 || failover)) {
+            std::string picked = balancer->pickEndpoint(retry == 0 ? std::string() : attemptEndpoint);
+            if (!picked.empty()) {
+                attemptEndpoint = picked;
+            }
+        }
+        ClientOutcome outcome;
+        Error abortedError;
+        bool aborted = buildAbortedError(request, abortedError);
+        bool circuitOpen = !aborted && retryStrategy != nullptr && !retryStrategy->allowRequest(attemptEndpoint);
+        //the other endpoints may still take the request while the circuit of this one is open
+        if (circuitOpen && balancer != nullptr && (retry == 0 || failover)) {
+            std::vector<std::string> openEndpoints(1, attemptEndpoint);
+            while (circuitOpen && openEndpoints.size() < balancer->Endpoints().size()) {
+                std::string picked = balancer->pickEndpoint(openEndpoints);
+                if (std::find(openEndpoints.begin(), openEndpoints.end(), picked) != openEndpoints.end()) {
+                    break;
+                }
+                attemptEndpoint = picked;
+                circuitOpen = !retryStrategy->allowRequest(attemptEndpoint);
+                openEndpoints.push_back(attemptEndpoint);
+            }
+        }
+        if (aborted) {
+            outcome = ClientOutcome(abortedError);
+        }
+        else if (circuitOpen) {
+            Error error("ClientError:100003", "Circuit breaker is open for the endpoint, request fails fast.");
+            error.setStatus(ERROR_CIRCUIT_BREAKER_OPEN);
+            outcome = ClientOutcome(error);
+            if (metrics_ != nullptr) {
+                metrics_->failFast->add();
+            }
+        }
+        else {
+            std::shared_ptr<Span> attemptSpan;
+            if (requestSpan != nullptr) {
+                attemptSpan = tracer->startSpan("oss.attempt", requestSpan->context(), std::chrono::steady_clock::now());
+                if (attemptSpan != nullptr) {
+                    attemptSpan->setAttribute("oss.attempt", std::to_string(retry));
+                    attemptSpan->setAttribute("oss.endpoint", attemptEndpoint);
+                }
+            }
+            auto attemptStart = std::chrono::steady_clock::now();
+            if (balancer != nullptr) {
+                balancer->onRequestStart(attemptEndpoint);
+            }
+            int64_t firstByteUs = -1;
+            outcome = AttemptOnceRequest(attemptEndpoint, request, method, resume, attemptSpan.get(), &firstByteUs);
+            if (attemptSpan != nullptr) {
+                endSpan(*attemptSpan, outcome);
+            }
+            //a transfer stopped by the caller is not a failure of the endpoint
+            aborted = !outcome.isSuccess() && buildAbortedError(request, abortedError);
+            if (aborted) {
+                outcome = ClientOutcome(abortedError);
+                if (retryStrategy != nullptr) {
+                    retryStrategy->onRequestAborted(attemptEndpoint);
+                }
+            }
+            else if (retryStrategy != nullptr) {
+                if (outcome.isSuccess()) {
+                    retryStrategy->onRequestSuccess(attemptEndpoint);
+                }
+                else {
+                    retryStrategy->onRequestFailure(attemptEndpoint, outcome.error());
+                }
+            }
+            if (balancer != nullptr) {
+                //the endpoint is judged by its time to first byte, not by the size of the object
+                //or the caller's stream, the whole attempt only if no response came back
+                auto us = firstByteUs >= 0 ? firstByteUs : std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - attemptStart).count();
+                if (outcome.isSuccess()) {
+                    balancer->onRequestSuccess(attemptEndpoint, us);
+                }
+                else {
+                    balancer->onRequestFailure(attemptEndpoint, us, outcome.error());
+                }
+            }
+        }
+
         if (outcome.isSuccess()) {
+            recordRequest(method, startTime, true);
+            if (requestSpan != nullptr) {
+                requestSpan->setAttribute("oss.attempts", std::to_string(retry + 1));
+                endSpan(*requestSpan, outcome);
+            }
             return outcome;
         } 
-        else if (!httpClient_->isEnable()) {
+
+        bool willRetry = !aborted && !circuitOpen && httpClient_->isEnable() && retryStrategy != nullptr &&
+            retryStrategy->shouldRetry(outcome.error(), retry);
+        if (!willRetry) {
+            //drop what the resumed attempts have written
+            if (resumeState.stream != nullptr && resumeState.received > 0) {
+                resumeState.stream->clear();
+                resumeState.stream->seekp(resumeState.startPos);
+            }
+            recordRequest(method, startTime, false);
+            if (requestSpan != nullptr) {
+                requestSpan->setAttribute("oss.attempts", std::to_string(retry + 1));
+                endSpan(*requestSpan, outcome);
+            }
             return outcome;
         }
+        if (metrics_ != nullptr && method < ClientMetrics::MethodCount) {
+            metrics_->retries[method]->add();
+        }
+        long sleepTmeMs = retryStrategy->calcDealyTimeMs(outcome.error(), retry);
+        std::shared_ptr<Span> waitSpan;
+        if (requestSpan != nullptr) {
+            waitSpan = tracer->startSpan("oss.retry_wait", requestSpan->context(), std::chrono::steady_clock::now());
+        }
+        if (request.CancellationToken() == nullptr && !request.hasDeadline()) {
+            httpClient_->waitForRetry(sleepTmeMs);
+        }
         else {
-            RetryStrategy *retryStrategy = configuration().retryStrategy.get();
-            if (retryStrategy == nullptr || !retryStrategy->shouldRetry(outcome.error(), retry)) {
-                return outcome;
+            if (request.hasDeadline()) {
+                sleepTmeMs = (std::min)(sleepTmeMs, (std::max)(remainingMs(request), 0L));
             }
-            long sleepTmeMs = retryStrategy->calcDealyTimeMs(outcome.error(), retry);
-            httpClient_->waitForRetry(sleepTmeMs);
+            httpClient_->waitForRetry(sleepTmeMs, [&request]() { return isCancelled(request); });
+        }
+        if (waitSpan != nullptr) {
+            waitSpan->setAttribute("oss.retry_delay_ms", std::to_string(sleepTmeMs));
+            waitSpan->end(std::chrono::steady_clock::now());
         }
     }
 }
 
 Client::ClientOutcome Client::AttemptOnceRequest(const std::string & endpoint, const ServiceRequest & request, Http::Method method) const
+{
+    return AttemptOnceRequest(endpoint, request, method, nullptr, nullptr);
+}
+
+//the phases are known once the attempt is over, their spans are reported with the recorded times
+void Client::tracePhases(const HttpRequest &request, const Span &span) const
+{
+    static const std::chrono::steady_clock::time_point unset;
+    const HttpRequest::Timings &timings = request.PhaseTimings();
+    const struct {
+        const char *name;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    } phases[] = {
+        { "oss.sign", timings.signStart, timings.signEnd },
+        { "oss.pool_wait", timings.acquireStart, timings.acquireEnd },
+        { "oss.transfer", timings.acquireEnd, timings.transferEnd },
+    };
+    for (auto const &phase : phases) {
+        if (phase.start == unset || phase.end < phase.start) {
+            continue;
+        }
+        auto child = configuration().tracer->startSpan(phase.name, span.context(), phase.start);
+        if (child != nullptr) {
+            child->end(phase.end);
+        }
+    }
+}
+
+Client::ClientOutcome Client::AttemptOnceRequest(const std::string & endpoint, const ServiceRequest & request, Http::Method method,
+    ResumeState *resume, Span *span, int64_t *firstByteUs) const
 {
     if (!httpClient_->isEnable()) {
         return ClientOutcome(Error("ClientError:100002", "Disable all requests by upper."));
     }
 
     auto r = buildHttpRequest(endpoint, request, method);
-    auto response = httpClient_->makeRequest(r); 
+    if (span != nullptr && configuration().tracer->PropagateTraceParent() && span->context().isValid()) {
+        r->setHeader("traceparent", span->context().toTraceParent());
+    }
+
+    //ranged GETs are not resumed
+    if (resume != nullptr && resume->received == 0 && r->hasHeader(Http::RANGE)) {
+        resume = nullptr;
+    }
+    bool resuming = resume != nullptr && resume->received > 0;
+    if (resume != nullptr) {
+        resume->streamUsed = false;
+        if (resuming) {
+            std::stringstream range;
+            range << "bytes=" << resume->received << "-";
+            r->setHeader(Http::RANGE, range.str());
+            r->setHeader("If-Match", resume->etag);
+            r->setInitCrc64(resume->crc64);
+            r->setResumeOffset(resume->received);
+        }
+        r->setResponseStreamFactory([resume]() {
+            if (resume->stream == nullptr) {
+                resume->stream = resume->factory();
+                if (resume->stream != nullptr) {
+                    resume->startPos = resume->stream->tellp();
+                }
+            }
+            else {
+                resume->stream->clear();
+                resume->stream->seekp(resume->startPos + static_cast<std::streamoff>(resume->received));
+            }
+            resume->streamUsed = true;
+            return resume->stream;
+        });
+    }
+
+    std::shared_ptr<HttpResponse> response;
+    HedgePolicy *hedgePolicy = configuration().hedgePolicy.get();
+    if (hedgePolicy != nullptr && r->Body() == nullptr && (method == Http::Method::Head ||
+        (method == Http::Method::Get && hedgePolicy->isHedgeableRange(r->Header(Http::RANGE))))) {
+        response = httpClient_->makeHedgedRequest(r, *hedgePolicy);
+    }
+    else {
+        response = httpClient_->makeRequest(r);
+    }
+    if (span != nullptr) {
+        tracePhases(*r, *span);
+    }
+    if (firstByteUs != nullptr) {
+        *firstByteUs = r->FirstByteUs();
+    }
+    if (metrics_ != nullptr && method < ClientMetrics::MethodCount) {
+        metrics_->transferredBytes[method]->add(r->TransferedBytes());
+    }
+
+    if (resuming && r->ResumeOffset() == 0) {
+        //the range was ignored and the whole object written over the stream from its start
+        resuming = false;
+        resume->received = 0;
+        resume->crc64 = 0;
+        resume->etag.clear();
+    }
+    if (resuming) {
+        int code = response->statusCode();
+        if (code == 200 || code == 412 || code == 416) {
+            //the object changed, or an empty body ignored the range, start over
+            resume->received = 0;
+            resume->crc64 = 0;
+            resume->etag.clear();
+            resume->stream->clear();
+            resume->stream->seekp(resume->startPos);
+            return AttemptOnceRequest(endpoint, request, method, resume, span, firstByteUs);
+        }
+        if (code == 206) {
+            //looks like the whole object to the caller
+            std::string contentRange = response->Header("Content-Range");
+            auto pos = contentRange.rfind('/');
+            if (pos != std::string::npos) {
+                response->setHeader(Http::CONTENT_LENGTH, contentRange.substr(pos + 1));
+            }
+            response->removeHeader("Content-Range");
+            response->setStatusCode(200);
+        }
+    }
 
     if(hasResponseError(response)) {
+        if (resume != nullptr && resume->streamUsed && response->statusCode() >= ERROR_CURL_BASE) {
+            if (!resuming) {
+                resume->etag = response->Header(Http::ETAG);
+            }
+            if (!resume->etag.empty()) {
+                resume->received += static_cast<int64_t>(r->TransferedBytes());
+                resume->crc64 = r->Crc64Result();
+            }
+        }
         return ClientOutcome(buildError(response));
     } else {
         return ClientOutcome(response);
@@ -136,4 +480,9 @@ bool Client::isEnableRequest() const
 {
     return httpClient_->isEnable();
 }
+
+void Client::warmUp(const std::string &url) const
+{
+    httpClient_->warmUp(url);
+}
    
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <alibabacloud/oss/ServiceRequest.h>
@@ -29,6 +30,22 @@ namespace AlibabaCloud
 {
 namespace OSS
 {
+    class MetricsCounter;
+    class MetricsHistogram;
+    class Span;
+
+    //resolved once when the client is created, indexed by Http::Method from Get to Delete
+    struct ClientMetrics
+    {
+        static const int MethodCount = Http::Method::Delete + 1;
+        MetricsCounter *requests[MethodCount];
+        MetricsCounter *errors[MethodCount];
+        MetricsCounter *retries[MethodCount];
+        MetricsCounter *transferredBytes[MethodCount];
+        MetricsHistogram *latency[MethodCount];
+        MetricsCounter *failFast;
+        MetricsCounter *crc64Mismatch;
+    };
 
     class  Client
     {
@@ -50,12 +67,20 @@ namespace OSS
         bool isEnableRequest() const;
         void disableRequest();
         void enableRequest();
+        void warmUp(const std::string &url) const;
+        ClientMetrics *metrics() const { return metrics_.get(); }
     private:
+        struct ResumeState;
+        void recordRequest(Http::Method method, std::chrono::steady_clock::time_point startTime, bool success) const;
+        ClientOutcome AttemptOnceRequest(const std::string & endpoint, const ServiceRequest &request, Http::Method method,
+            ResumeState *resume, Span *span, int64_t *firstByteUs = nullptr) const;
+        void tracePhases(const HttpRequest &request, const Span &span) const;
         Error buildError(const std::shared_ptr<HttpResponse> &response) const ;
 
         std::string serviceName_;
         ClientConfiguration configuration_;
         std::shared_ptr<HttpClient> httpClient_;
+        std::unique_ptr<ClientMetrics> metrics_;
     };
 }
 }
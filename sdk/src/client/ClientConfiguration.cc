@@ -55,7 +55,7 @@ bool DefaultRetryStrategy::shouldRetry(const Error & error, long attemptedRetrie
     long responseCode = error.Status();
 
     //http code
-    if (responseCode > 499 && responseCode < 599) {
+    if (responseCode > 499 && responseCode < 600) {
         return true;
     }
     else {
@@ -90,6 +90,13 @@ ClientConfiguration::ClientConfiguration() :
     userAgent(DefaultUserAgent()), 
     scheme(Http::Scheme::HTTP), 
     maxConnections(16), 
+    connectionAcquireTimeoutMs(0),
+    warmupConnections(0),
+    idleConnectionTimeoutMs(0),
+    tcpKeepAliveIdleSec(60),
+    tcpKeepAliveIntervalSec(30),
+    enableHttp2(false),
+    http2ConnectionsPerHost(1),
     requestTimeoutMs(10000), 
     connectTimeoutMs(5000),
     retryStrategy(std::make_shared<DefaultRetryStrategy>()),
@@ -99,7 +106,13 @@ ClientConfiguration::ClientConfiguration() :
     isCname(false),
     enableCrc64(true),
     sendRateLimiter(nullptr),
-    recvRateLimiter(nullptr)
+    recvRateLimiter(nullptr),
+    hedgePolicy(nullptr),
+    endpointBalancer(nullptr),
+    enableSignatureCache(false),
+    traceSampler(nullptr),
+    metricsRegistry(nullptr),
+    tracer(nullptr)
 {
 
 }
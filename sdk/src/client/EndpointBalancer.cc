@@ -0,0 +1,229 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <alibabacloud/oss/client/EndpointBalancer.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+using namespace AlibabaCloud::OSS;
+
+namespace
+{
+    //weight of the newest sample in the moving averages
+    const double LATENCY_ALPHA = 0.3;
+    const double ERROR_ALPHA = 0.2;
+    //keeps the cost finite for an endpoint which only fails
+    const double MAX_ERROR_RATE = 0.99;
+
+    long long NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::mt19937& RandomEngine()
+    {
+        static thread_local std::mt19937 engine(std::random_device{}());
+        return engine;
+    }
+}
+
+EndpointBalancer::EndpointBalancer(const std::vector<std::string>& endpoints, long ejectFailures, long ejectMs) :
+    endpoints_(endpoints),
+    ejectFailures_((std::max)(1L, ejectFailures)),
+    ejectMs_((std::max)(0L, ejectMs))
+{
+    Stats s = { 0.0, false, 0.0, 0, 0, 0 };
+    stats_.assign(endpoints_.size(), s);
+}
+
+EndpointBalancer::~EndpointBalancer()
+{
+}
+
+bool EndpointBalancer::IsEndpointFailure(const Error& error)
+{
+    long responseCode = error.Status();
+    if (responseCode > 499 && responseCode < 600) {
+        return true;
+    }
+
+    switch (responseCode)
+    {
+    //curl error code, only the network ones. A write error, an aborted transfer or a
+    //bad option is local to the caller and says nothing about the endpoint
+    case (ERROR_CURL_BASE + 6):  //CURLE_COULDNT_RESOLVE_HOST
+    case (ERROR_CURL_BASE + 7):  //CURLE_COULDNT_CONNECT
+    case (ERROR_CURL_BASE + 18): //CURLE_PARTIAL_FILE
+    case (ERROR_CURL_BASE + 28): //CURLE_OPERATION_TIMEDOUT
+    case (ERROR_CURL_BASE + 35): //CURLE_SSL_CONNECT_ERROR
+    case (ERROR_CURL_BASE + 52): //CURLE_GOT_NOTHING
+    case (ERROR_CURL_BASE + 55): //CURLE_SEND_ERROR
+    case (ERROR_CURL_BASE + 56): //CURLE_RECV_ERROR
+        return true;
+    default:
+        break;
+    };
+    return false;
+}
+
+EndpointBalancer::Stats* EndpointBalancer::stats(const std::string& endpoint) const
+{
+    for (size_t i = 0; i < endpoints_.size(); i++) {
+        if (endpoints_[i] == endpoint) {
+            return &stats_[i];
+        }
+    }
+    return nullptr;
+}
+
+double EndpointBalancer::cost(const Stats& s, double defaultLatencyUs) const
+{
+    double latencyUs = s.sampled ? s.latencyUs : defaultLatencyUs;
+    return latencyUs * static_cast<double>(s.inFlight + 1) / (1.0 - (std::min)(s.errorRate, MAX_ERROR_RATE));
+}
+
+std::string EndpointBalancer::pickEndpoint(const std::string& avoid) const
+{
+    return pick(&avoid, avoid.empty() ? 0 : 1);
+}
+
+std::string EndpointBalancer::pickEndpoint(const std::vector<std::string>& avoid) const
+{
+    return pick(avoid.data(), avoid.size());
+}
+
+std::string EndpointBalancer::pick(const std::string* avoid, size_t avoidCount) const
+{
+    if (endpoints_.empty()) {
+        return std::string();
+    }
+
+    std::lock_guard<std::mutex> locker(lock_);
+    long long now = NowMs();
+    double latencySum = 0.0;
+    size_t sampled = 0;
+    for (Stats& s : stats_) {
+        //back after the ejection, with a clean record
+        if (s.ejectedUntilMs != 0 && s.ejectedUntilMs <= now) {
+            s.ejectedUntilMs = 0;
+            s.consecutiveFailures = 0;
+            s.errorRate = 0.0;
+        }
+        if (s.sampled) {
+            latencySum += s.latencyUs;
+            sampled++;
+        }
+    }
+    //an endpoint without samples yet looks like an average one
+    double defaultLatencyUs = sampled > 0 ? latencySum / sampled : 0.0;
+
+    //healthy and not avoided, then healthy, then not avoided, then any
+    std::vector<size_t> candidates;
+    for (int pass = 0; pass < 4 && candidates.empty(); pass++) {
+        bool healthyOnly = pass < 2;
+        bool skipAvoided = (pass % 2) == 0;
+        for (size_t i = 0; i < endpoints_.size(); i++) {
+            if ((healthyOnly && stats_[i].ejectedUntilMs != 0) ||
+                (skipAvoided && std::find(avoid, avoid + avoidCount, endpoints_[i]) != avoid + avoidCount)) {
+                continue;
+            }
+            candidates.push_back(i);
+        }
+    }
+
+    size_t chosen = candidates[0];
+    if (candidates.size() > 1) {
+        std::uniform_int_distribution<size_t> dist(0, candidates.size() - 1);
+        size_t a = dist(RandomEngine());
+        size_t b = dist(RandomEngine());
+        while (b == a) {
+            b = dist(RandomEngine());
+        }
+        chosen = cost(stats_[candidates[b]], defaultLatencyUs) < cost(stats_[candidates[a]], defaultLatencyUs) ?
+            candidates[b] : candidates[a];
+    }
+    return endpoints_[chosen];
+}
+
+void EndpointBalancer::onRequestStart(const std::string& endpoint) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    Stats* s = stats(endpoint);
+    if (s != nullptr) {
+        s->inFlight++;
+    }
+}
+
+void EndpointBalancer::record(Stats& s, long long latencyUs, bool failed) const
+{
+    s.inFlight = (std::max)(0L, s.inFlight - 1);
+    double latency = static_cast<double>((std::max)(0LL, latencyUs));
+    s.latencyUs = s.sampled ? s.latencyUs + LATENCY_ALPHA * (latency - s.latencyUs) : latency;
+    s.sampled = true;
+    s.errorRate += ERROR_ALPHA * ((failed ? 1.0 : 0.0) - s.errorRate);
+
+    if (!failed) {
+        s.consecutiveFailures = 0;
+        return;
+    }
+    s.consecutiveFailures++;
+    if (s.consecutiveFailures >= ejectFailures_ && s.ejectedUntilMs == 0) {
+        s.ejectedUntilMs = NowMs() + ejectMs_;
+    }
+}
+
+void EndpointBalancer::onRequestSuccess(const std::string& endpoint, long long latencyUs) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    Stats* s = stats(endpoint);
+    if (s != nullptr) {
+        record(*s, latencyUs, false);
+    }
+}
+
+void EndpointBalancer::onRequestFailure(const std::string& endpoint, long long latencyUs, const Error& error) const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    Stats* s = stats(endpoint);
+    if (s == nullptr) {
+        return;
+    }
+    //cancelled, timed out in the pool and the like, the endpoint was not to blame
+    long responseCode = error.Status();
+    if (responseCode >= ERROR_CLIENT_BASE && responseCode < ERROR_CURL_BASE) {
+        s->inFlight = (std::max)(0L, s->inFlight - 1);
+        return;
+    }
+    //the server answered, e.g. 404, it is healthy
+    record(*s, latencyUs, IsEndpointFailure(error));
+}
+
+std::vector<EndpointBalancer::EndpointState> EndpointBalancer::States() const
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    long long now = NowMs();
+    std::vector<EndpointState> states;
+    for (size_t i = 0; i < endpoints_.size(); i++) {
+        const Stats& s = stats_[i];
+        EndpointState state = { endpoints_[i], s.latencyUs / 1000.0, s.errorRate, s.inFlight,
+            s.ejectedUntilMs != 0 && s.ejectedUntilMs > now };
+        states.push_back(state);
+    }
+    return states;
+}
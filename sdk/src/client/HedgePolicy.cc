@@ -0,0 +1,115 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/client/HedgePolicy.h>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace AlibabaCloud::OSS;
+
+namespace
+{
+    //samples needed before the percentile is trusted
+    const size_t MIN_SAMPLES = 16;
+    //recompute the percentile every N samples
+    const size_t UPDATE_INTERVAL = 8;
+    //burst of hedges allowed
+    const double MAX_TOKENS = 10.0;
+}
+
+HedgePolicy::HedgePolicy(double percentile, long minDelayMs, long maxDelayMs,
+    double budgetPercent, size_t windowSize) :
+    percentile_(percentile),
+    minDelayMs_(minDelayMs),
+    maxDelayMs_((std::max)(minDelayMs, maxDelayMs)),
+    budgetPercent_(budgetPercent),
+    maxHedgeBytes_(1024 * 1024),
+    window_((std::max)(windowSize, MIN_SAMPLES), 0),
+    windowPos_(0),
+    samples_(0),
+    delayMs_(maxDelayMs_),
+    tokens_(1.0)
+{
+}
+
+HedgePolicy::~HedgePolicy()
+{
+}
+
+void HedgePolicy::setMaxHedgeBytes(int64_t maxHedgeBytes)
+{
+    maxHedgeBytes_ = maxHedgeBytes;
+}
+
+//"bytes=first-last" with both ends, an open range may be the rest of a large object
+bool HedgePolicy::isHedgeableRange(const std::string& range) const
+{
+    const std::string prefix = "bytes=";
+    if (range.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    const char *begin = range.c_str() + prefix.size();
+    char *end = nullptr;
+    long long first = std::strtoll(begin, &end, 10);
+    if (end == begin || *end != '-') {
+        return false;
+    }
+    begin = end + 1;
+    long long last = std::strtoll(begin, &end, 10);
+    if (end == begin || *end != '\0' || last < first) {
+        return false;
+    }
+    return last - first + 1 <= maxHedgeBytes_;
+}
+
+long HedgePolicy::hedgeDelayMs()
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    return delayMs_;
+}
+
+void HedgePolicy::recordLatency(long latencyMs)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    window_[windowPos_] = latencyMs;
+    windowPos_ = (windowPos_ + 1) % window_.size();
+    samples_++;
+    tokens_ = (std::min)(MAX_TOKENS, tokens_ + budgetPercent_ / 100.0);
+
+    if (samples_ >= MIN_SAMPLES && (samples_ % UPDATE_INTERVAL) == 0) {
+        updateDelay();
+    }
+}
+
+bool HedgePolicy::acquireHedge()
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    if (tokens_ < 1.0) {
+        return false;
+    }
+    tokens_ -= 1.0;
+    return true;
+}
+
+void HedgePolicy::updateDelay()
+{
+    size_t count = (std::min)(samples_, window_.size());
+    std::vector<long> sorted(window_.begin(), window_.begin() + count);
+    double percentile = (std::min)((std::max)(percentile_, 0.0), 100.0);
+    size_t index = static_cast<size_t>(percentile / 100.0 * (count - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    delayMs_ = (std::min)((std::max)(sorted[index], minDelayMs_), maxDelayMs_);
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/client/MetricsRegistry.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace AlibabaCloud::OSS;
+
+namespace
+{
+    //a thread keeps the shard it is given first
+    size_t ThreadShard()
+    {
+        static std::atomic<size_t> next(0);
+        static thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed);
+        return shard;
+    }
+
+    int HighestBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    //oss_requests_total{method="GET"} => oss_requests_total, method="GET"
+    void SplitName(const std::string &name, std::string &base, std::string &labels)
+    {
+        auto pos = name.find('{');
+        if (pos == std::string::npos || name.back() != '}') {
+            base = name;
+            labels.clear();
+            return;
+        }
+        base = name.substr(0, pos);
+        labels = name.substr(pos + 1, name.size() - pos - 2);
+    }
+}
+
+MetricsCounter::MetricsCounter()
+{
+    for (auto &shard : shards_) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricsCounter::add(uint64_t value)
+{
+    shards_[ThreadShard() % ShardCount].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t MetricsCounter::value() const
+{
+    uint64_t total = 0;
+    for (auto &shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t HistogramSnapshot::percentile(double p) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    p = (std::min)((std::max)(p, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count)));
+    target = (std::max)(target, static_cast<uint64_t>(1));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return MetricsHistogram::BucketUpperBound(i);
+        }
+    }
+    return MetricsHistogram::BucketUpperBound(buckets.size() - 1);
+}
+
+MetricsHistogram::MetricsHistogram()
+{
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t MetricsHistogram::BucketIndex(uint64_t value)
+{
+    if (value < 16) {
+        return static_cast<size_t>(value);
+    }
+    int bit = HighestBit(value);
+    return 16 + static_cast<size_t>(bit - 4) * 8 + static_cast<size_t>((value >> (bit - 3)) & 7);
+}
+
+uint64_t MetricsHistogram::BucketUpperBound(size_t index)
+{
+    if (index < 16) {
+        return index;
+    }
+    int bit = static_cast<int>((index - 16) / 8) + 4;
+    uint64_t lower = static_cast<uint64_t>(8 + (index - 16) % 8) << (bit - 3);
+    return lower + ((static_cast<uint64_t>(1) << (bit - 3)) - 1);
+}
+
+void MetricsHistogram::record(uint64_t value)
+{
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.add(value);
+}
+
+void MetricsHistogram::snapshot(HistogramSnapshot &snapshot) const
+{
+    snapshot.count = 0;
+    snapshot.buckets.resize(BucketCount);
+    for (size_t i = 0; i < BucketCount; i++) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = sum_.value();
+}
+
+MetricsExporter::~MetricsExporter()
+{
+}
+
+void PrometheusTextExporter::exportMetrics(const MetricsSnapshot &snapshot)
+{
+    std::stringstream ss;
+    std::set<std::string> typed;
+    std::string base, labels;
+
+    for (auto const &counter : snapshot.counters) {
+        SplitName(counter.first, base, labels);
+        if (typed.insert(base).second) {
+            ss << "# TYPE " << base << " counter\n";
+        }
+        ss << counter.first << " " << counter.second << "\n";
+    }
+
+    for (auto const &gauge : snapshot.gauges) {
+        SplitName(gauge.first, base, labels);
+        if (typed.insert(base).second) {
+            ss << "# TYPE " << base << " gauge\n";
+        }
+        ss << gauge.first << " " << gauge.second << "\n";
+    }
+
+    for (auto const &histogram : snapshot.histograms) {
+        SplitName(histogram.name, base, labels);
+        if (typed.insert(base).second) {
+            ss << "# TYPE " << base << " histogram\n";
+        }
+        std::string prefix = labels.empty() ? std::string() : labels + ",";
+        std::string suffix = labels.empty() ? std::string() : "{" + labels + "}";
+        //the same coarse bounds on every scrape, the fine buckets add up to them exactly
+        uint64_t cumulative = 0;
+        size_t i = 0;
+        for (int bit = MinBoundBit; bit <= MaxBoundBit; bit++) {
+            uint64_t bound = (static_cast<uint64_t>(1) << bit) - 1;
+            for (; i < histogram.buckets.size() && MetricsHistogram::BucketUpperBound(i) <= bound; i++) {
+                cumulative += histogram.buckets[i];
+            }
+            ss << base << "_bucket{" << prefix << "le=\"" << bound << "\"} " << cumulative << "\n";
+        }
+        ss << base << "_bucket{" << prefix << "le=\"+Inf\"} " << histogram.count << "\n";
+        ss << base << "_sum" << suffix << " " << histogram.sum << "\n";
+        ss << base << "_count" << suffix << " " << histogram.count << "\n";
+    }
+    text_ = ss.str();
+}
+
+MetricsRegistry::MetricsRegistry() :
+    nextGaugeId_(1)
+{
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+}
+
+MetricsCounter *MetricsRegistry::counter(const std::string &name)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    auto &counter = counters_[name];
+    if (counter == nullptr) {
+        counter.reset(new MetricsCounter());
+    }
+    return counter.get();
+}
+
+MetricsHistogram *MetricsRegistry::histogram(const std::string &name)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    auto &histogram = histograms_[name];
+    if (histogram == nullptr) {
+        histogram.reset(new MetricsHistogram());
+    }
+    return histogram.get();
+}
+
+uint64_t MetricsRegistry::addGauge(const std::string &name, const Gauge &gauge)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    uint64_t id = nextGaugeId_++;
+    gauges_[id] = std::make_pair(name, gauge);
+    return id;
+}
+
+void MetricsRegistry::removeGauge(uint64_t id)
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    gauges_.erase(id);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const
+{
+    MetricsSnapshot snapshot;
+    std::lock_guard<std::mutex> locker(lock_);
+    snapshot.counters.reserve(counters_.size());
+    for (auto const &counter : counters_) {
+        snapshot.counters.push_back(std::make_pair(counter.first, counter.second->value()));
+    }
+
+    std::map<std::string, int64_t> gauges;
+    for (auto const &gauge : gauges_) {
+        gauges[gauge.second.first] += gauge.second.second();
+    }
+    snapshot.gauges.assign(gauges.begin(), gauges.end());
+
+    snapshot.histograms.resize(histograms_.size());
+    size_t i = 0;
+    for (auto const &histogram : histograms_) {
+        snapshot.histograms[i].name = histogram.first;
+        histogram.second->snapshot(snapshot.histograms[i]);
+        i++;
+    }
+    return snapshot;
+}
+
+void MetricsRegistry::exportTo(MetricsExporter &exporter) const
+{
+    exporter.exportMetrics(snapshot());
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/client/TraceSampler.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "../utils/LogUtils.h"
+
+using namespace AlibabaCloud::OSS;
+
+static const char *TAG = "TraceSampler";
+
+TraceSampler::TraceSampler(double sampleRate, long latencyThresholdMs, long minStatusCode) :
+    sampleRate_(sampleRate),
+    latencyThresholdMs_(latencyThresholdMs),
+    minStatusCode_(minStatusCode),
+    requests_(0)
+{
+}
+
+TraceSampler::~TraceSampler()
+{
+}
+
+bool TraceSampler::shouldCapture()
+{
+    if (sampleRate_ <= 0.0) {
+        return false;
+    }
+    if (sampleRate_ >= 1.0) {
+        return true;
+    }
+    //every 1/rate-th request, spread evenly and without a lock
+    uint64_t n = requests_.fetch_add(1, std::memory_order_relaxed);
+    return std::floor((n + 1) * sampleRate_) > std::floor(n * sampleRate_);
+}
+
+bool TraceSampler::shouldEmit(const Sample &sample)
+{
+    if (latencyThresholdMs_ >= 0 && sample.latencyMs >= latencyThresholdMs_) {
+        return true;
+    }
+    if (minStatusCode_ > 0 && sample.statusCode >= minStatusCode_) {
+        return true;
+    }
+    return false;
+}
+
+void TraceSampler::emit(const Sample &sample, const std::string &trace)
+{
+    OSS_LOG(LogLevel::LogWarn, TAG, "trace %s %s, status:%ld, latency:%ld ms",
+        Http::MethodToString(sample.method).c_str(), sample.url.c_str(), sample.statusCode, sample.latencyMs);
+
+    //the lines packed into as few records as fit in the 2KB a log record holds,
+    //so a trace takes a handful of slots of the log ring
+    const size_t MAX_RECORD = 2000;
+    std::string record;
+    record.reserve(MAX_RECORD);
+    const char *begin = trace.data();
+    const char *end = begin + trace.size();
+    while (begin < end) {
+        const char *eol = static_cast<const char *>(memchr(begin, '\n', end - begin));
+        const char *next = eol ? eol + 1 : end;
+        const char *last = eol ? eol : end;
+        if (last > begin && last[-1] == '\r') {
+            last--;
+        }
+        while (last > begin) {
+            size_t len = (std::min)(static_cast<size_t>(last - begin), MAX_RECORD);
+            if (!record.empty() && record.size() + 1 + len > MAX_RECORD) {
+                OSS_LOG(LogLevel::LogWarn, TAG, "trace\n%s", record.c_str());
+                record.clear();
+            }
+            if (!record.empty()) {
+                record.push_back('\n');
+            }
+            record.append(begin, len);
+            begin += len;
+        }
+        begin = next;
+    }
+    if (!record.empty()) {
+        OSS_LOG(LogLevel::LogWarn, TAG, "trace\n%s", record.c_str());
+    }
+}
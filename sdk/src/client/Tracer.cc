@@ -0,0 +1,88 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/client/Tracer.h>
+#include <cstdio>
+
+using namespace AlibabaCloud::OSS;
+
+static bool IsLowerHex(const std::string &value, size_t length)
+{
+    if (value.size() != length) {
+        return false;
+    }
+    bool allZero = true;
+    for (char c : value) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+        allZero = allZero && c == '0';
+    }
+    return !allZero;
+}
+
+bool SpanContext::isValid() const
+{
+    return IsLowerHex(traceId, 32) && IsLowerHex(spanId, 16);
+}
+
+std::string SpanContext::toTraceParent() const
+{
+    char flags[3];
+    snprintf(flags, sizeof(flags), "%02x", traceFlags);
+    std::string value("00-");
+    value.append(traceId).append("-").append(spanId).append("-").append(flags);
+    return value;
+}
+
+bool SpanContext::FromTraceParent(const std::string &traceParent, SpanContext &context)
+{
+    //version 00 is 55 characters, later versions may append fields
+    if (traceParent.size() < 55 || traceParent[2] != '-' || traceParent[35] != '-' || traceParent[52] != '-' ||
+        (traceParent.size() > 55 && (traceParent.compare(0, 2, "00") == 0 || traceParent[55] != '-')) ||
+        traceParent.compare(0, 2, "ff") == 0) {
+        return false;
+    }
+    SpanContext parsed;
+    parsed.traceId = traceParent.substr(3, 32);
+    parsed.spanId = traceParent.substr(36, 16);
+    unsigned flags = 0;
+    for (size_t i = 53; i < 55; i++) {
+        char c = traceParent[i];
+        if (c >= '0' && c <= '9') flags = flags * 16 + (c - '0');
+        else if (c >= 'a' && c <= 'f') flags = flags * 16 + (c - 'a' + 10);
+        else return false;
+    }
+    parsed.traceFlags = static_cast<uint8_t>(flags);
+    if (!parsed.isValid()) {
+        return false;
+    }
+    context = parsed;
+    return true;
+}
+
+Span::~Span()
+{
+}
+
+Tracer::Tracer(bool propagateTraceParent) :
+    propagateTraceParent_(propagateTraceParent)
+{
+}
+
+Tracer::~Tracer()
+{
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "CurlHeaderList.h"
+
+using namespace AlibabaCloud::OSS;
+
+curl_slist *CurlHeaderList::build(const HeaderCollection &headers)
+{
+    size_t size = 0;
+    size_t count = 0;
+    for (const auto &p : headers) {
+        if (p.second.empty())
+            continue;
+        size += p.first.size() + p.second.size() + 3;
+        count++;
+    }
+    if (count == 0) {
+        return nullptr;
+    }
+
+    //"name: value\0" one after another, the nodes point into the buffer once it is filled
+    buffer_.clear();
+    buffer_.reserve(size);
+    for (const auto &p : headers) {
+        if (p.second.empty())
+            continue;
+        buffer_.append(p.first).append(": ", 2).append(p.second).push_back('\0');
+    }
+
+    nodes_.resize(count);
+    char *data = &buffer_[0];
+    for (size_t i = 0; i < count; i++) {
+        nodes_[i].data = data;
+        nodes_[i].next = (i + 1 < count) ? &nodes_[i + 1] : nullptr;
+        data += std::char_traits<char>::length(data) + 1;
+    }
+    return &nodes_[0];
+}
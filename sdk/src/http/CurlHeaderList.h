@@ -0,0 +1,43 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <alibabacloud/oss/utils/HeaderCollection.h>
+#include <curl/curl.h>
+#include <string>
+#include <vector>
+
+namespace AlibabaCloud
+{
+namespace OSS
+{
+    /*
+    * A curl header list laid out in buffers which are kept between requests,
+    * so building it does not allocate once the buffers are large enough.
+    * The list stays valid until the next build.
+    */
+    class CurlHeaderList
+    {
+    public:
+        curl_slist *build(const HeaderCollection &headers);
+    private:
+        std::string buffer_;
+        std::vector<curl_slist> nodes_;
+    };
+}
+}
@@ -15,17 +15,26 @@
  */
 
 #include "CurlHttpClient.h"
+#include "CurlHeaderList.h"
 #include <curl/curl.h>
 #include <cassert>
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 #include <../utils/Crc64.h>
 #include <alibabacloud/oss/client/Error.h>
 #include <alibabacloud/oss/client/RateLimiter.h>
+#include <alibabacloud/oss/client/HedgePolicy.h>
+#include <alibabacloud/oss/client/TraceSampler.h>
+#include <alibabacloud/oss/client/MetricsRegistry.h>
 #include "../utils/LogUtils.h"
 #include "../utils/Utils.h"
 
@@ -37,132 +46,457 @@ namespace OSS
 {
     const char * TAG = "CurlHttpClient";
     ////////////////////////////////////////////////////////////////////////////////////////////
-    template< typename RESOURCE_TYPE>
-    class ResourceManager_
+    /*
+    * Runs transfers on one multi handle driven by a background thread, so that concurrent
+    * requests to a host become HTTP/2 streams of the same connections instead of each
+    * holding its own. The callers block until their transfers are done.
+    */
+    class CurlMultiplexer
     {
     public:
-        ResourceManager_() : m_shutdown(false) {}
-        RESOURCE_TYPE Acquire()
+        explicit CurlMultiplexer(unsigned connectionsPerHost) :
+            multi_(curl_multi_init()),
+            stopping_(false)
+        {
+            curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            if (connectionsPerHost > 0) {
+                curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(connectionsPerHost));
+            }
+            thread_ = std::thread(&CurlMultiplexer::run, this);
+        }
+
+        ~CurlMultiplexer()
         {
-            std::unique_lock<std::mutex> locker(m_queueLock);
-            while(!m_shutdown.load() && m_resources.size() == 0)
             {
-                m_semaphore.wait(locker, [&](){ return m_shutdown.load() || m_resources.size() > 0; });                    
+                std::lock_guard<std::mutex> locker(lock_);
+                stopping_ = true;
             }
-    
-            assert(!m_shutdown.load());
-    
-            RESOURCE_TYPE resource = m_resources.back();
-            m_resources.pop_back();
-    
-            return resource;
+            wakeup();
+            thread_.join();
+            curl_multi_cleanup(multi_);
         }
-    
-        bool HasResourcesAvailable()
+
+        void perform(CURL* const *handles, CURLcode *results, size_t count)
         {
-            std::lock_guard<std::mutex> locker(m_queueLock);
-            return m_resources.size() > 0 && !m_shutdown.load();
+            Batch batch;
+            batch.remaining = count;
+            {
+                std::lock_guard<std::mutex> locker(lock_);
+                if (stopping_) {
+                    std::fill(results, results + count, CURLE_ABORTED_BY_CALLBACK);
+                    return;
+                }
+                for (size_t i = 0; i < count; i++) {
+                    Transfer transfer = { handles[i], &results[i], &batch };
+                    queue_.push_back(transfer);
+                }
+            }
+            wakeup();
+            std::unique_lock<std::mutex> locker(lock_);
+            batch.done.wait(locker, [&batch]() { return batch.remaining == 0; });
         }
-    
-        void Release(RESOURCE_TYPE resource)
+
+        CURLcode perform(CURL* handle)
         {
-            std::unique_lock<std::mutex> locker(m_queueLock);
-            m_resources.push_back(resource);
-            locker.unlock();
-            m_semaphore.notify_one();
+            CURLcode result = CURLE_OK;
+            perform(&handle, &result, 1);
+            return result;
         }
-    
-        void PutResource(RESOURCE_TYPE resource)
+
+        //called from the callbacks of a transfer which has just paused itself
+        void resumeAt(CURL* handle, std::chrono::steady_clock::time_point due)
         {
-            m_resources.push_back(resource);
+            paused_[handle] = due;
         }
-    
-        std::vector<RESOURCE_TYPE> ShutdownAndWait(size_t resourceCount)
+
+    private:
+        struct Batch
         {
-            std::vector<RESOURCE_TYPE> resources;
-            std::unique_lock<std::mutex> locker(m_queueLock);
-            m_shutdown = true;
-            while (m_resources.size() < resourceCount)
-            {
-                m_semaphore.wait(locker, [&]() { return m_resources.size() == resourceCount; });
+            size_t remaining;
+            std::condition_variable done;
+        };
+
+        struct Transfer
+        {
+            CURL* handle;
+            CURLcode *result;
+            Batch *batch;
+        };
+
+        void wakeup()
+        {
+#if LIBCURL_VERSION_NUM >= 0x074400
+            curl_multi_wakeup(multi_);
+#endif
+        }
+
+        void complete(const Transfer &transfer, CURLcode result)
+        {
+            *transfer.result = result;
+            std::lock_guard<std::mutex> locker(lock_);
+            if (--transfer.batch->remaining == 0) {
+                transfer.batch->done.notify_all();
             }
-            resources = m_resources;
-            m_resources.clear();
-            return resources;
         }
-    
-    private:
-        std::vector<RESOURCE_TYPE> m_resources;
-        std::mutex m_queueLock;
-        std::condition_variable m_semaphore;
-        std::atomic<bool> m_shutdown;
+
+        void run()
+        {
+            std::vector<Transfer> added;
+            for (;;) {
+                {
+                    std::lock_guard<std::mutex> locker(lock_);
+                    if (stopping_) {
+                        added.swap(queue_);
+                        break;
+                    }
+                    added.swap(queue_);
+                }
+                for (const Transfer &transfer : added) {
+                    running_[transfer.handle] = transfer;
+                    curl_multi_add_handle(multi_, transfer.handle);
+                }
+                added.clear();
+
+                //curl_easy_pause may call back into resumeAt, so the due ones are taken out first
+                int timeoutMs = 1000;
+                auto now = std::chrono::steady_clock::now();
+                std::vector<CURL*> due;
+                for (auto it = paused_.begin(); it != paused_.end();) {
+                    if (it->second <= now) {
+                        due.push_back(it->first);
+                        it = paused_.erase(it);
+                        continue;
+                    }
+                    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(it->second - now).count() + 1;
+                    timeoutMs = (std::min)(timeoutMs, static_cast<int>(wait));
+                    ++it;
+                }
+                for (CURL* handle : due) {
+                    curl_easy_pause(handle, CURLPAUSE_CONT);
+                }
+
+                int stillRunning = 0;
+                curl_multi_perform(multi_, &stillRunning);
+                CURLMsg *msg = nullptr;
+                int msgsLeft = 0;
+                while ((msg = curl_multi_info_read(multi_, &msgsLeft)) != nullptr) {
+                    if (msg->msg != CURLMSG_DONE) {
+                        continue;
+                    }
+                    CURL* handle = msg->easy_handle;
+                    CURLcode result = msg->data.result;
+                    curl_multi_remove_handle(multi_, handle);
+                    paused_.erase(handle);
+                    auto it = running_.find(handle);
+                    if (it != running_.end()) {
+                        complete(it->second, result);
+                        running_.erase(it);
+                    }
+                }
+#if LIBCURL_VERSION_NUM >= 0x074400
+                curl_multi_poll(multi_, nullptr, 0, timeoutMs, nullptr);
+#else
+                curl_multi_wait(multi_, nullptr, 0, (std::min)(timeoutMs, 10), nullptr);
+#endif
+            }
+
+            for (const auto &p : running_) {
+                curl_multi_remove_handle(multi_, p.first);
+                complete(p.second, CURLE_ABORTED_BY_CALLBACK);
+            }
+            running_.clear();
+            paused_.clear();
+            for (const Transfer &transfer : added) {
+                complete(transfer, CURLE_ABORTED_BY_CALLBACK);
+            }
+        }
+
+        CURLM* multi_;
+        std::mutex lock_;
+        std::vector<Transfer> queue_;
+        bool stopping_;
+        //only touched by the thread
+        std::unordered_map<CURL*, Transfer> running_;
+        std::unordered_map<CURL*, std::chrono::steady_clock::time_point> paused_;
+        std::thread thread_;
     };
-    
-    
+
+    //negotiated with ALPN for https, h2c with prior knowledge for http. libcurl before 8.0
+    //fails to reuse a prior knowledge connection for the next stream, so http stays on HTTP/1.1 there
+    static long Http2Version(const std::string &url)
+    {
+        if (url.compare(0, 7, "http://") != 0) {
+            return CURL_HTTP_VERSION_2TLS;
+        }
+#if LIBCURL_VERSION_NUM >= 0x080000
+        return CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+#else
+        return CURL_HTTP_VERSION_1_1;
+#endif
+    }
+
+    //the options every handle of a client shares, set once when the handle is created
+    struct HandleOptions
+    {
+        explicit HandleOptions(const ClientConfiguration &configuration);
+        void apply(CURL *handle) const;
+
+        std::string userAgent;
+        bool verifySSL;
+        std::string caPath;
+        std::string caFile;
+        std::string proxy;
+        long proxyPort;
+        std::string proxyUserName;
+        std::string proxyPassword;
+        long keepAliveIdle;
+        long keepAliveInterval;
+        bool http2;
+    };
+
+    //every handle carries the buffers its header list is built in
+    static CurlHeaderList *HeaderListOf(CURL *handle)
+    {
+        char *list = nullptr;
+        curl_easy_getinfo(handle, CURLINFO_PRIVATE, &list);
+        return reinterpret_cast<CurlHeaderList *>(list);
+    }
+
+    static size_t discardData(char *ptr, size_t size, size_t nmemb, void *userdata)
+    {
+        UNUSED_PARAM(ptr);
+        UNUSED_PARAM(userdata);
+        return size * nmemb;
+    }
+
+    /*
+    * The idle handles are spread over shards. A thread returns handles to its own shard,
+    * takes from it first and steals from the other shards when it is empty, so the threads
+    * rarely meet on a lock. Handles are created on demand up to maxSize, after that
+    * a thread waits until one is released or its deadline passes.
+    * A handle keeps its options between requests, a transfer restores only the options
+    * it changed before the handle is released.
+    * With a warm-up size or an idle timeout, a background thread connects handles up to
+    * the warm-up size and closes the ones idle for too long, but never below that size.
+    */
     class CurlContainer
     {
     public:
-        CurlContainer(unsigned maxSize = 16, long requestTimeout = 10000, long connectTimeout = 5000):
+        CurlContainer(const HandleOptions &options, unsigned maxSize = 16, long requestTimeout = 10000, long connectTimeout = 5000,
+            unsigned warmupSize = 0, long idleTimeoutMs = 0, CurlMultiplexer *multiplexer = nullptr):
+              options_(options),
               maxPoolSize_(maxSize), 
               requestTimeout_(requestTimeout), 
               connectTimeout_(connectTimeout),
-              poolSize_(0)
+              poolSize_(0),
+              available_(0),
+              waiters_(0),
+              multiCount_(0),
+              shardCount_(ShardCount(maxSize)),
+              shards_(new Shard[shardCount_]),
+              warmupSize_((std::min)(warmupSize, maxSize)),
+              idleTimeoutMs_(idleTimeoutMs),
+              stopping_(false),
+              multiplexer_(multiplexer)
         {
+            if (warmupSize_ > 0 || idleTimeoutMs_ > 0) {
+                maintainer_ = std::thread(&CurlContainer::maintain, this);
+            }
         }
     
         ~CurlContainer()
         {
-            for (CURL* handle : handleContainer_.ShutdownAndWait(poolSize_)) {
-                curl_easy_cleanup(handle);
+            if (maintainer_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> locker(maintainLock_);
+                    stopping_ = true;
+                }
+                maintainCv_.notify_one();
+                maintainer_.join();
+            }
+
+            //every handle is back before they are cleaned up
+            {
+                std::unique_lock<std::mutex> locker(waitLock_);
+                waiters_++;
+                waitCv_.wait(locker, [this]() { return available_.load() == poolSize_.load(); });
+                waiters_--;
+            }
+            for (unsigned i = 0; i < shardCount_; i++) {
+                for (const IdleHandle &idle : shards_[i].handles) {
+                    destroy(idle.handle);
+                }
+            }
+            for (CURLM* multi : multiHandles_) {
+                curl_multi_cleanup(multi);
             }
         }
     
-        CURL* Acquire()
+        //returns nullptr if no handle is free by the deadline
+        CURL* Acquire(std::chrono::steady_clock::time_point deadline = (std::chrono::steady_clock::time_point::max)())
         {
-            if(!handleContainer_.HasResourcesAvailable()) {
-                growPool();
+            CURL* handle = take(true);
+            if (handle != nullptr) {
+                return handle;
             }
-            CURL* handle = handleContainer_.Acquire();
+
+            std::unique_lock<std::mutex> locker(waitLock_);
+            waiters_++;
+            for (;;) {
+                //every shard is locked here, a handle released meanwhile is either seen or signalled
+                handle = take(false);
+                if (handle != nullptr) {
+                    break;
+                }
+                if (deadline == (std::chrono::steady_clock::time_point::max)()) {
+                    waitCv_.wait(locker);
+                }
+                else if (waitCv_.wait_until(locker, deadline) == std::cv_status::timeout) {
+                    handle = take(false);
+                    break;
+                }
+            }
+            waiters_--;
             return handle;
         }    
-    
+
+        //returns nullptr instead of waiting when the pool is exhausted
+        CURL* TryAcquire()
+        {
+            return take(true);
+        }
+
+        //multi handles keep their connection cache between hedged requests. Each keeps at most
+        //the two connections of a hedged request and there are at most half as many as easy handles,
+        //so the hedged requests add no more than maxSize connections. Returns nullptr when all are in use
+        CURLM* AcquireMulti()
+        {
+            std::lock_guard<std::mutex> locker(containerLock_);
+            if (!multiHandles_.empty()) {
+                CURLM* multi = multiHandles_.back();
+                multiHandles_.pop_back();
+                return multi;
+            }
+            if (multiCount_ >= (std::max)(maxPoolSize_ / 2, 1U)) {
+                return nullptr;
+            }
+            CURLM* multi = curl_multi_init();
+            if (multi != nullptr) {
+                curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, 2L);
+                multiCount_++;
+            }
+            return multi;
+        }
+
+        void ReleaseMulti(CURLM* multi)
+        {
+            if (multi) {
+                std::lock_guard<std::mutex> locker(containerLock_);
+                multiHandles_.push_back(multi);
+            }
+        }
+
+        unsigned PoolSize()
+        {
+            return poolSize_.load(std::memory_order_relaxed);
+        }
+
+        size_t InUse()
+        {
+            unsigned size = poolSize_.load(std::memory_order_relaxed);
+            unsigned available = available_.load(std::memory_order_relaxed);
+            return size > available ? size - available : 0;
+        }
+
         void Release(CURL* handle)
         {
             if (handle) {
-                curl_easy_reset(handle);
-                setDefaultOptions(handle);
-                handleContainer_.Release(handle);
+                push(handle, homeShard());
+                notifyWaiters();
             }
         }
+
+        //the url the background thread connects the warm-up handles to
+        void WarmUp(const std::string &url)
+        {
+            std::lock_guard<std::mutex> locker(maintainLock_);
+            warmupUrl_ = url;
+            maintainCv_.notify_one();
+        }
     
     private:
         CurlContainer(const CurlContainer&) = delete;
         const CurlContainer& operator = (const CurlContainer&) = delete;
         CurlContainer(const CurlContainer&&) = delete;
         const CurlContainer& operator = (const CurlContainer&&) = delete;
-    
-        bool growPool()
+
+        struct IdleHandle
         {
-            std::lock_guard<std::mutex> locker(containerLock_);
-            if (poolSize_ < maxPoolSize_) {
-                unsigned multiplier = poolSize_ > 0 ? poolSize_ : 1;
-                unsigned amountToAdd = (std::min)(multiplier * 2, maxPoolSize_ - poolSize_);
-        
-                unsigned actuallyAdded = 0;
-                for (unsigned i = 0; i < amountToAdd; ++i) {
-                    CURL* curlHandle = curl_easy_init();
-                    if (curlHandle) {
-                        setDefaultOptions(curlHandle);
-                        handleContainer_.Release(curlHandle);
-                        ++actuallyAdded;
-                    } else {
-                        break;
+            CURL* handle;
+            std::chrono::steady_clock::time_point since;
+        };
+
+        struct Shard
+        {
+            Shard() : count(0) {}
+            std::mutex lock;
+            //the most recently released last
+            std::vector<IdleHandle> handles;
+            //read without the lock to skip empty shards
+            std::atomic<unsigned> count;
+            char padding[64];
+        };
+
+        static unsigned ShardCount(unsigned maxSize)
+        {
+            unsigned cores = (std::max)(std::thread::hardware_concurrency(), 1U);
+            return (std::max)((std::min)((std::min)(cores, maxSize), 16U), 1U);
+        }
+
+        unsigned homeShard() const
+        {
+            static std::atomic<unsigned> next(0);
+            static thread_local unsigned shard = next.fetch_add(1, std::memory_order_relaxed);
+            return shard % shardCount_;
+        }
+
+        //the own shard first, then the others, then a new handle
+        CURL* take(bool skipEmpty)
+        {
+            unsigned home = homeShard();
+            for (unsigned i = 0; i < shardCount_; i++) {
+                Shard &shard = shards_[(home + i) % shardCount_];
+                if (skipEmpty && shard.count.load(std::memory_order_relaxed) == 0) {
+                    continue;
+                }
+                std::lock_guard<std::mutex> locker(shard.lock);
+                if (!shard.handles.empty()) {
+                    CURL* handle = shard.handles.back().handle;
+                    shard.handles.pop_back();
+                    shard.count.store(static_cast<unsigned>(shard.handles.size()), std::memory_order_relaxed);
+                    available_--;
+                    return handle;
+                }
+            }
+            return grow();
+        }
+
+        CURL* grow()
+        {
+            unsigned size = poolSize_.load();
+            while (size < maxPoolSize_) {
+                if (poolSize_.compare_exchange_weak(size, size + 1)) {
+                    CURL* handle = curl_easy_init();
+                    if (handle == nullptr) {
+                        poolSize_--;
+                        return nullptr;
                     }
+                    setDefaultOptions(handle);
+                    curl_easy_setopt(handle, CURLOPT_PRIVATE, new CurlHeaderList());
+                    return handle;
                 }
-                poolSize_ += actuallyAdded;
-                return actuallyAdded > 0;
             }
-            return false;
+            return nullptr;
         }
     
         void setDefaultOptions(CURL* handle)
@@ -176,20 +510,208 @@ namespace OSS
             curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, 1L);
             curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, requestTimeout_ / 1000);
 
-            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0L);
+            options_.apply(handle);
+        }
+
+        void destroy(CURL* handle)
+        {
+            delete HeaderListOf(handle);
+            curl_easy_cleanup(handle);
+        }
+
+        void push(CURL* handle, unsigned index)
+        {
+            IdleHandle idle = { handle, std::chrono::steady_clock::time_point() };
+            if (idleTimeoutMs_ > 0) {
+                idle.since = std::chrono::steady_clock::now();
+            }
+            Shard &shard = shards_[index];
+            {
+                std::lock_guard<std::mutex> locker(shard.lock);
+                shard.handles.push_back(idle);
+                shard.count.store(static_cast<unsigned>(shard.handles.size()), std::memory_order_relaxed);
+            }
+            available_++;
+        }
+
+        void notifyWaiters()
+        {
+            if (waiters_.load() > 0) {
+                std::lock_guard<std::mutex> locker(waitLock_);
+                waitCv_.notify_one();
+            }
+        }
+
+        void maintain()
+        {
+            const long intervalMs = idleTimeoutMs_ > 0 ? (std::max)((std::min)(idleTimeoutMs_ / 2, 5000L), 100L) : 5000L;
+            std::unique_lock<std::mutex> locker(maintainLock_);
+            while (!stopping_) {
+                std::string url = warmupUrl_;
+                locker.unlock();
+                if (!url.empty()) {
+                    warmUpTo(url);
+                }
+                if (idleTimeoutMs_ > 0) {
+                    closeIdle();
+                }
+                locker.lock();
+                maintainCv_.wait_for(locker, std::chrono::milliseconds(intervalMs),
+                    [&]() { return stopping_ || warmupUrl_ != url; });
+            }
+        }
+
+        bool isStopping()
+        {
+            std::lock_guard<std::mutex> locker(maintainLock_);
+            return stopping_;
+        }
+
+        //connects new handles in parallel until the pool holds the warm-up size,
+        //the ones which fail are dropped and tried again on the next round
+        void warmUpTo(const std::string &url)
+        {
+            std::vector<CURL*> handles;
+            for (unsigned size = poolSize_.load(); size < warmupSize_; size++) {
+                CURL* handle = grow();
+                if (handle == nullptr) {
+                    break;
+                }
+                handles.push_back(handle);
+            }
+            if (handles.empty()) {
+                return;
+            }
+
+            CURLM* multi = curl_multi_init();
+            for (CURL* handle : handles) {
+                curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+                curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+                curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, discardData);
+                curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, discardData);
+                curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 1L);
+                curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, static_cast<long>(connectTimeout_ + requestTimeout_));
+                if (options_.http2) {
+                    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, Http2Version(url));
+                }
+            }
+
+            //the connections of the multiplexer are shared by every handle
+            std::vector<CURL*> connected;
+            if (multiplexer_ != nullptr) {
+                std::vector<CURLcode> results(handles.size());
+                multiplexer_->perform(handles.data(), results.data(), handles.size());
+                for (size_t i = 0; i < handles.size(); i++) {
+                    if (results[i] == CURLE_OK) {
+                        connected.push_back(handles[i]);
+                    }
+                }
+            }
+            else {
+                for (CURL* handle : handles) {
+                    curl_multi_add_handle(multi, handle);
+                }
+            }
+
+            int running = multiplexer_ != nullptr ? 0 : static_cast<int>(handles.size());
+            while (running > 0 && !isStopping()) {
+                curl_multi_perform(multi, &running);
+                CURLMsg *msg = nullptr;
+                int msgsLeft = 0;
+                while ((msg = curl_multi_info_read(multi, &msgsLeft)) != nullptr) {
+                    if (msg->msg == CURLMSG_DONE && msg->data.result == CURLE_OK) {
+                        connected.push_back(msg->easy_handle);
+                    }
+                }
+                if (running > 0) {
+                    curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+                }
+            }
+
+            unsigned index = 0;
+            for (CURL* handle : handles) {
+                curl_multi_remove_handle(multi, handle);
+                if (std::find(connected.begin(), connected.end(), handle) == connected.end()) {
+                    destroy(handle);
+                    poolSize_--;
+                    continue;
+                }
+                curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
+                curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, 0L);
+                options_.apply(handle);
+                push(handle, index++ % shardCount_);
+            }
+            curl_multi_cleanup(multi);
+            notifyWaiters();
+
+            OSS_LOG(LogLevel::LogInfo, TAG, "warm up %u of %u connections to %s",
+                index, static_cast<unsigned>(handles.size()), url.c_str());
+        }
+
+        //the oldest handles of each shard first, while the pool is above the warm-up size
+        void closeIdle()
+        {
+            auto expired = std::chrono::steady_clock::now() - std::chrono::milliseconds(idleTimeoutMs_);
+            std::vector<CURL*> closed;
+            for (unsigned i = 0; i < shardCount_; i++) {
+                Shard &shard = shards_[i];
+                std::lock_guard<std::mutex> locker(shard.lock);
+                auto it = shard.handles.begin();
+                while (it != shard.handles.end() && it->since < expired) {
+                    unsigned size = poolSize_.load();
+                    if (size <= warmupSize_ || !poolSize_.compare_exchange_strong(size, size - 1)) {
+                        break;
+                    }
+                    closed.push_back(it->handle);
+                    available_--;
+                    ++it;
+                }
+                shard.handles.erase(shard.handles.begin(), it);
+                shard.count.store(static_cast<unsigned>(shard.handles.size()), std::memory_order_relaxed);
+            }
+            for (CURL* handle : closed) {
+                destroy(handle);
+            }
+            if (!closed.empty()) {
+                OSS_LOG(LogLevel::LogDebug, TAG, "close %u idle connections", static_cast<unsigned>(closed.size()));
+                notifyWaiters();
+            }
         }
     
     private:
-        ResourceManager_<CURL*> handleContainer_;
+        HandleOptions options_;
         unsigned maxPoolSize_;
         unsigned long requestTimeout_;
         unsigned long connectTimeout_;
-        unsigned poolSize_;
+        std::atomic<unsigned> poolSize_;
+        std::atomic<unsigned> available_;
+        std::atomic<int> waiters_;
+        unsigned multiCount_;
+        unsigned shardCount_;
+        std::unique_ptr<Shard[]> shards_;
+        std::mutex waitLock_;
+        std::condition_variable waitCv_;
+        std::vector<CURLM*> multiHandles_;
         std::mutex containerLock_;
+        unsigned warmupSize_;
+        long idleTimeoutMs_;
+        std::string warmupUrl_;
+        bool stopping_;
+        std::mutex maintainLock_;
+        std::condition_variable maintainCv_;
+        std::thread maintainer_;
+        CurlMultiplexer *multiplexer_;
     };
     
     /////////////////////////////////////////////////////////////////////////////////////////////
+    struct TransferState;
+    struct HedgeGroup {
+        TransferState *winner;
+    };
+
+    //the verbose output a sampled request keeps at most, a few log records
+    const size_t MAX_TRACE_SIZE = 8 * 1024;
+
     struct TransferState {
         CurlHttpClient *owner;
         CURL * curl;
@@ -205,8 +727,34 @@ namespace OSS
         uint64_t crc64Value;
         int sendSpeed;
         int recvSpeed;
+        curl_slist *headerList;
+        std::iostream::pos_type requestBodyPos;
+        HedgeGroup *group;
+        int64_t contentLength;
+        TraceSampler *sampler;
+        std::chrono::steady_clock::time_point startTime;
+        std::string trace;
+        CurlMultiplexer *pacer;
+        std::chrono::steady_clock::time_point paceStart;
+        int64_t pacedSend;
+        int64_t pacedRecv;
     };
 
+    //streams share their connection, so libcurl's speed limits do not hold for each of them.
+    //A stream ahead of its rate is paused instead, and the multiplexer resumes it when due
+    static bool PauseIfAhead(TransferState *state, int rate, int64_t paced)
+    {
+        if (state->pacer == nullptr || rate <= 0 || paced == 0) {
+            return false;
+        }
+        auto due = state->paceStart + std::chrono::microseconds(paced * 1000000 / (static_cast<int64_t>(rate) * 1024));
+        if (due <= std::chrono::steady_clock::now()) {
+            return false;
+        }
+        state->pacer->resumeAt(state->curl, due);
+        return true;
+    }
+
     static size_t sendBody(char *ptr, size_t size, size_t nmemb, void *userdata)
     {
         TransferState *state = static_cast<TransferState*>(userdata);
@@ -216,6 +764,14 @@ namespace OSS
             return 0;
         }
         
+        if (state->request->isAborted()) {
+            return CURL_READFUNC_ABORT;
+        }
+
+        if (PauseIfAhead(state, state->sendSpeed, state->pacedSend)) {
+            return CURL_READFUNC_PAUSE;
+        }
+
         std::shared_ptr<std::iostream> &content = state->request->Body();
         const size_t wanted = size * nmemb;
         size_t got = 0;
@@ -232,6 +788,7 @@ namespace OSS
         }
 
         state->transferred += got;
+        state->pacedSend += got;
         if (state->progress) {
             state->progress(got, state->transferred, state->total, state->userData);
         }
@@ -254,13 +811,29 @@ namespace OSS
             return -1;
         }
 
+        if (state->request->isAborted()) {
+            return 0;
+        }
+
+        if (PauseIfAhead(state, state->recvSpeed, state->pacedRecv)) {
+            return CURL_WRITEFUNC_PAUSE;
+        }
+
         if (state->firstRecvData) {
             long response_code = 0;
             curl_easy_getinfo(state->curl, CURLINFO_RESPONSE_CODE, &response_code);
             if (response_code / 100 == 2) {
                 state->response->addBody(state->request->ResponseStreamFactory()());
-                if (state->response->Body() != nullptr) {
-                    state->recvBodyPos = state->response->Body()->tellp();
+                auto &body = state->response->Body();
+                //a resumed request appends partial content, if the server ignored the range
+                //the whole object is written over what was received instead
+                if (state->request->ResumeOffset() > 0 && response_code != 206 && body != nullptr) {
+                    body->seekp(body->tellp() - static_cast<std::streamoff>(state->request->ResumeOffset()));
+                    state->crc64Value = 0;
+                    state->request->setResumeOffset(0);
+                }
+                if (body != nullptr) {
+                    state->recvBodyPos = body->tellp();
                 }
                 OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) setResponseBody, recvBodyPos:%lld",
                     state->request, state->recvBodyPos);
@@ -282,6 +855,7 @@ namespace OSS
         }
 
         state->transferred += wanted;
+        state->pacedRecv += wanted;
         if (state->progress) {
             state->progress(wanted, state->transferred, state->total, state->userData);
         }
@@ -293,31 +867,93 @@ namespace OSS
         return wanted;
     }
 
+    static bool EqualsIgnoreCase(const char *data, const char *lower, size_t len)
+    {
+        for (size_t i = 0; i < len; i++) {
+            char c = data[i];
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c + ('a' - 'A'));
+            }
+            if (c != lower[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //-1 if it is not a plain decimal number
+    static int64_t ParseContentLength(const char *begin, const char *end)
+    {
+        if (begin == end || end - begin > 18) {
+            return -1;
+        }
+        int64_t value = 0;
+        for (const char *p = begin; p < end; p++) {
+            if (*p < '0' || *p > '9') {
+                return -1;
+            }
+            value = value * 10 + (*p - '0');
+        }
+        return value;
+    }
+
     static size_t recvHeaders(char *buffer, size_t size, size_t nitems, void *userdata)
     {
         TransferState *state = static_cast<TransferState*>(userdata);
         const size_t length = nitems * size;
 
-        std::string line(buffer);
-        auto pos = line.find(':');
-        if (pos != line.npos)
-        {
-            size_t posEnd = line.rfind('\r');
-            if (posEnd != line.npos) {
-                posEnd = posEnd - pos - 2;
+        //the first attempt to get a response wins, the others are aborted
+        if (state->group != nullptr) {
+            if (state->group->winner == nullptr) {
+                state->group->winner = state;
+            }
+            else if (state->group->winner != state) {
+                return 0;
             }
-            std::string name  = line.substr(0, pos);
-            std::string value = line.substr(pos + 2, posEnd);
-            state->response->setHeader(name, value);
         }
 
-        if (length == 2 && (buffer[0] == 0x0D) && (buffer[1] == 0x0A)) {
-            if (state->response->hasHeader(Http::CONTENT_LENGTH)) {
-                double dval;
-                curl_easy_getinfo(state->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &dval);
-                state->total = (int64_t)dval;
+        //the buffer is one header line, not nul terminated, with its CRLF
+        const char *begin = buffer;
+        const char *end = buffer + length;
+        while (end > begin && (end[-1] == '\n' || end[-1] == '\r')) {
+            end--;
+        }
+
+        if (end == begin) {
+            //the blank line ending the headers
+            if (state->contentLength >= 0) {
+                state->total = state->contentLength;
             }
+            return length;
+        }
+
+        if (end - begin >= 5 && std::memcmp(begin, "HTTP/", 5) == 0) {
+            //a new status line, e.g. after 100-continue, starts over
+            state->contentLength = -1;
+            return length;
+        }
+
+        auto colon = static_cast<const char *>(std::memchr(begin, ':', end - begin));
+        if (colon == nullptr) {
+            return length;
+        }
+        const char *value = colon + 1;
+        while (value < end && (*value == ' ' || *value == '\t')) {
+            value++;
+        }
+        const char *valueEnd = end;
+        while (valueEnd > value && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t')) {
+            valueEnd--;
         }
+
+        const size_t nameLen = colon - begin;
+        if (nameLen == sizeof("Content-Length") - 1 &&
+            EqualsIgnoreCase(begin, "content-length", nameLen)) {
+            state->contentLength = ParseContentLength(value, valueEnd);
+        }
+
+        //the only copies are the strings kept by the response
+        state->response->setHeader(std::string(begin, nameLen), std::string(value, valueEnd - value));
         return length;
     }
 
@@ -340,6 +976,61 @@ namespace OSS
         return 0;
     }
 
+    //the verbose output of a sampled request, kept until it is known whether to emit it
+    static int traceCallback(CURL *handle, curl_infotype type, char *data, size_t size, void *userp)
+    {
+        UNUSED_PARAM(handle);
+        TransferState *state = static_cast<TransferState*>(userp);
+        const char *prefix;
+        switch (type) {
+        case CURLINFO_TEXT:
+            prefix = "* ";
+            break;
+        case CURLINFO_HEADER_OUT:
+            prefix = "> ";
+            break;
+        case CURLINFO_HEADER_IN:
+            prefix = "< ";
+            break;
+        default:
+            return 0;
+        }
+        if (state->trace.size() >= MAX_TRACE_SIZE) {
+            return 0;
+        }
+
+        //one entry per line, the credentials and the signing query parameters are not kept
+        const char *begin = data;
+        const char *end = data + size;
+        while (begin < end) {
+            const char *eol = static_cast<const char *>(memchr(begin, '\n', end - begin));
+            const char *next = eol ? eol + 1 : end;
+            const char *last = eol ? eol : end;
+            if (last > begin && last[-1] == '\r') {
+                last--;
+            }
+            if (last > begin) {
+                size_t len = last - begin;
+                state->trace.append(prefix);
+                if (type == CURLINFO_HEADER_OUT && len > 14 && EqualsIgnoreCase(begin, "authorization:", 14)) {
+                    state->trace.append(begin, 14).append(" ***");
+                }
+                else if (type == CURLINFO_HEADER_OUT && len > 21 && EqualsIgnoreCase(begin, "x-oss-security-token:", 21)) {
+                    state->trace.append(begin, 21).append(" ***");
+                }
+                else if (memchr(begin, '?', len) != nullptr) {
+                    state->trace.append(MaskUrlCredentials(std::string(begin, len)));
+                }
+                else {
+                    state->trace.append(begin, len);
+                }
+                state->trace.push_back('\n');
+            }
+            begin = next;
+        }
+        return 0;
+    }
+
     static int progressCallback(void *userdata, double dltotal, double dlnow,  double ultotal, double ulnow)
     {
         UNUSED_PARAM(dltotal);
@@ -358,13 +1049,18 @@ namespace OSS
             return 1;
         }
 
+        //stop by the cancellation token or the deadline of the request
+        if (state->request != nullptr && state->request->isAborted()) {
+            return 1;
+        }
+
         //for speed update
         if (thiz->sendRateLimiter_ != nullptr) {
             auto rate = thiz->sendRateLimiter_->Rate();
             if (rate != state->sendSpeed) {
                 state->sendSpeed = rate;
                 auto speed = static_cast<curl_off_t>(rate);
-                speed = speed * 1024;
+                speed = state->pacer != nullptr ? 0 : speed * 1024;
                 curl_easy_setopt(state->curl, CURLOPT_MAX_SEND_SPEED_LARGE, speed);
             }
         }
@@ -374,13 +1070,71 @@ namespace OSS
             if (rate != state->recvSpeed) {
                 state->recvSpeed = rate;
                 auto speed = static_cast<curl_off_t>(rate);
-                speed = speed * 1024;
+                speed = state->pacer != nullptr ? 0 : speed * 1024;
                 curl_easy_setopt(state->curl, CURLOPT_MAX_RECV_SPEED_LARGE, speed);
             }
         }
 
         return 0;
     }
+
+    HandleOptions::HandleOptions(const ClientConfiguration &configuration) :
+        userAgent(configuration.userAgent),
+        verifySSL(configuration.verifySSL),
+        caPath(configuration.caPath),
+        caFile(configuration.caFile),
+        proxyPort(static_cast<long>(configuration.proxyPort)),
+        proxyUserName(configuration.proxyUserName),
+        proxyPassword(configuration.proxyPassword),
+        keepAliveIdle(configuration.tcpKeepAliveIdleSec),
+        keepAliveInterval(configuration.tcpKeepAliveIntervalSec),
+        http2(configuration.enableHttp2)
+    {
+        if (!configuration.proxyHost.empty()) {
+            std::stringstream ss;
+            ss << configuration.proxyScheme << "://" << configuration.proxyHost;
+            proxy = ss.str();
+        }
+    }
+
+    void HandleOptions::apply(CURL *handle) const
+    {
+        curl_easy_setopt(handle, CURLOPT_USERAGENT, userAgent.c_str());
+
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, recvHeaders);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, recvBody);
+        curl_easy_setopt(handle, CURLOPT_READFUNCTION, sendBody);
+        curl_easy_setopt(handle, CURLOPT_PROGRESSFUNCTION, progressCallback);
+        curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
+
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, verifySSL ? 2L : 0L);
+        if (!caPath.empty()) {
+            curl_easy_setopt(handle, CURLOPT_CAPATH, caPath.c_str());
+        }
+        if (!caFile.empty()) {
+            curl_easy_setopt(handle, CURLOPT_CAINFO, caFile.c_str());
+        }
+
+        if (!proxy.empty()) {
+            curl_easy_setopt(handle, CURLOPT_PROXY, proxy.c_str());
+            curl_easy_setopt(handle, CURLOPT_PROXYPORT, proxyPort);
+            curl_easy_setopt(handle, CURLOPT_PROXYUSERNAME, proxyUserName.c_str());
+            curl_easy_setopt(handle, CURLOPT_PROXYPASSWORD, proxyPassword.c_str());
+        }
+
+        //keeps idle connections through NATs and load balancers
+        if (keepAliveIdle > 0) {
+            curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, keepAliveIdle);
+            curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, keepAliveInterval > 0 ? keepAliveInterval : keepAliveIdle);
+        }
+
+        //wait for a connection to multiplex on rather than open another one
+        if (http2) {
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
+    }
 }
 }
 
@@ -396,79 +1150,77 @@ void CurlHttpClient::cleanupGlobalState()
 
 CurlHttpClient::CurlHttpClient(const ClientConfiguration &configuration) :
     HttpClient(),
-    curlContainer_(new CurlContainer(configuration.maxConnections, 
+    multiplexer_(configuration.enableHttp2 ? new CurlMultiplexer(configuration.http2ConnectionsPerHost) : nullptr),
+    curlContainer_(new CurlContainer(HandleOptions(configuration),
+                                                       configuration.maxConnections, 
                                                        configuration.connectTimeoutMs, 
-                                                       configuration.requestTimeoutMs)),
-    userAgent_(configuration.userAgent),
-    proxyScheme_(configuration.proxyScheme),
-    proxyHost_(configuration.proxyHost),
-    proxyPort_(configuration.proxyPort),
-    proxyUserName_(configuration.proxyUserName),
-    proxyPassword_(configuration.proxyPassword),
-    verifySSL_(configuration.verifySSL),
-    caPath_(configuration.caPath),
-    caFile_(configuration.caFile),
+                                                       configuration.requestTimeoutMs,
+                                                       configuration.warmupConnections,
+                                                       configuration.idleConnectionTimeoutMs,
+                                                       multiplexer_.get())),
+    traceSampler_(configuration.traceSampler),
+    metricsRegistry_(configuration.metricsRegistry),
+    acquireTimeoutMs_(configuration.connectionAcquireTimeoutMs),
+    poolWait_(nullptr),
+    poolTimeouts_(nullptr),
     sendRateLimiter_(configuration.sendRateLimiter),
     recvRateLimiter_(configuration.recvRateLimiter)
 {
+    if (metricsRegistry_ != nullptr) {
+        poolWait_ = metricsRegistry_->histogram("oss_http_pool_wait_us");
+        poolTimeouts_ = metricsRegistry_->counter("oss_http_pool_timeouts_total");
+        CurlContainer *container = curlContainer_;
+        gaugeIds_.push_back(metricsRegistry_->addGauge("oss_http_connections_in_use",
+            [container]() { return static_cast<int64_t>(container->InUse()); }));
+        gaugeIds_.push_back(metricsRegistry_->addGauge("oss_http_connections",
+            [container]() { return static_cast<int64_t>(container->PoolSize()); }));
+    }
+}
+
+void CurlHttpClient::warmUp(const std::string &url)
+{
+    curlContainer_->WarmUp(url);
 }
 
 CurlHttpClient::~CurlHttpClient()
 {
+    for (auto id : gaugeIds_) {
+        metricsRegistry_->removeGauge(id);
+    }
     if (curlContainer_) {
         delete curlContainer_;
     }
 }
 
-std::shared_ptr<HttpResponse> CurlHttpClient::makeRequest(const std::shared_ptr<HttpRequest> &request)
+void CurlHttpClient::setupTransfer(TransferState &state)
 {
-    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) enter makeRequest", request.get());
-    curl_slist *list = nullptr;
+    CURL *curl = state.curl;
+    HttpRequest *request = state.request;
+
     auto& headers = request->Headers();
-    for (const auto &p : headers) {
-        if (p.second.empty())
-            continue;
-        std::string str = p.first;
-        str.append(": ").append(p.second);
-        list = curl_slist_append(list, str.c_str());
-    }
+    state.headerList = HeaderListOf(curl)->build(headers);
 
-    auto response = std::make_shared<HttpResponse>(request);
-    
-    std::iostream::pos_type requestBodyPos = -1;
     if (request->Body() != nullptr) {
-        requestBodyPos = request->Body()->tellg();
+        state.requestBodyPos = request->Body()->tellg();
     }
 
-    CURL * curl = curlContainer_->Acquire();
-
-    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) acquire curl handle:%p", request.get(), curl);
-
-    uint64_t initCRC64 = 0;
 #ifdef ENABLE_OSS_TEST
     if (headers.find("oss-test-crc64") != headers.end()) {
-        initCRC64 = std::strtoull(headers.at("oss-test-crc64").c_str(), nullptr, 10);
+        state.crc64Value = std::strtoull(headers.at("oss-test-crc64").c_str(), nullptr, 10);
     }
 #endif
-    TransferState transferState = {
-        this,
-        curl,
-        request.get(),
-        response.get(),
-        0, -1, 
-        true, -1, 
-        request->TransferProgress().Handler,
-        request->TransferProgress().UserData,
-        request->hasCheckCrc64(), initCRC64,
-        0, 0
-    };
 
     if (request->hasHeader(Http::CONTENT_LENGTH)) {
-        transferState.total = std::atoll(request->Header(Http::CONTENT_LENGTH).c_str());
+        state.total = std::atoll(request->Header(Http::CONTENT_LENGTH).c_str());
     }
 
     std::string url = request->url().toString();
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    if (multiplexer_ != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, Http2Version(url));
+        state.pacer = multiplexer_.get();
+        state.paceStart = std::chrono::steady_clock::now();
+    }
     switch (request->method())
     {
     case Http::Method::Head:
@@ -487,69 +1239,99 @@ std::shared_ptr<HttpResponse> CurlHttpClient::makeRequest(const std::shared_ptr<
     default:
         break;
     }
-    
-    curl_easy_setopt(curl, CURLOPT_USERAGENT,userAgent_.c_str());
-
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transferState);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, recvHeaders);
-
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transferState);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, recvBody);
 
-    curl_easy_setopt(curl, CURLOPT_READDATA, &transferState);
-    curl_easy_setopt(curl, CURLOPT_READFUNCTION, sendBody);
-
-    if (verifySSL_) {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-    }
-    if(!caPath_.empty()) {
-        curl_easy_setopt(curl, CURLOPT_CAPATH, caPath_.c_str());
-    }
-    if(!caFile_.empty()){
-        curl_easy_setopt(curl, CURLOPT_CAINFO, caFile_.c_str());
-    }
-
-    if (!proxyHost_.empty()) {
-        std::stringstream ss;
-        ss << proxyScheme_ << "://" << proxyHost_;
-        curl_easy_setopt(curl, CURLOPT_PROXY, ss.str().c_str());
-        curl_easy_setopt(curl, CURLOPT_PROXYPORT, (long) proxyPort_);
-        curl_easy_setopt(curl, CURLOPT_PROXYUSERNAME, proxyUserName_.c_str());
-        curl_easy_setopt(curl, CURLOPT_PROXYPASSWORD, proxyPassword_.c_str());
-    }
+    //the callbacks are set when the handle is created, only their data changes
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, state.headerList);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &state);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &state);
+    curl_easy_setopt(curl, CURLOPT_READDATA, &state);
+    curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &state);
 
     //debug
-    if (GetLogLevelInner() >= LogLevel::LogInfo) {
+    if (traceSampler_ != nullptr) {
+        if (traceSampler_->shouldCapture()) {
+            state.sampler = traceSampler_.get();
+            state.startTime = std::chrono::steady_clock::now();
+            curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+            curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, traceCallback);
+            curl_easy_setopt(curl, CURLOPT_DEBUGDATA, &state);
+        }
+    }
+    else if (GetLogLevelInner() >= LogLevel::LogInfo) {
         curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
         curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, debugCallback);
+        curl_easy_setopt(curl, CURLOPT_DEBUGDATA, nullptr);
     }
 
-    //progress Callback
-    curl_easy_setopt(curl, CURLOPT_PROGRESSFUNCTION, progressCallback);
-    curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &transferState);
-    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    //no longer than the deadline allows
+    auto deadline = request->Deadline();
+    if (deadline != (std::chrono::steady_clock::time_point::max)()) {
+        long remains = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count());
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (std::max)(remains, 1L));
+    }
 
-    //Send bytes/sec 
+    //Send bytes/sec, HTTP/2 streams are paced by PauseIfAhead instead
     if (sendRateLimiter_ != nullptr) {
-        transferState.sendSpeed = sendRateLimiter_->Rate();
-        auto speed = static_cast<curl_off_t>(transferState.sendSpeed);
-        speed = speed * 1024;
+        state.sendSpeed = sendRateLimiter_->Rate();
+        auto speed = static_cast<curl_off_t>(state.sendSpeed);
+        speed = state.pacer != nullptr ? 0 : speed * 1024;
         curl_easy_setopt(curl, CURLOPT_MAX_SEND_SPEED_LARGE, speed);
     }
 
     //Recv bytes/sec 
     if (recvRateLimiter_ != nullptr) {
-        transferState.recvSpeed = recvRateLimiter_->Rate();
-        auto speed = static_cast<curl_off_t>(transferState.recvSpeed);
-        speed = speed * 1024;
+        state.recvSpeed = recvRateLimiter_->Rate();
+        auto speed = static_cast<curl_off_t>(state.recvSpeed);
+        speed = state.pacer != nullptr ? 0 : speed * 1024;
         curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE, speed);
     }
+}
+
+//undoes the options setupTransfer changed, so the handle goes back to the pool as it was created
+static void restoreHandle(TransferState &state)
+{
+    CURL *curl = state.curl;
+    switch (state.request->method())
+    {
+    case Http::Method::Head:
+    case Http::Method::Put:
+    case Http::Method::Post:
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        break;
+    case Http::Method::Delete:
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+        break;
+    case Http::Method::Get:
+    default:
+        break;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, 0L);
+    if (state.request->Deadline() != (std::chrono::steady_clock::time_point::max)()) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 0L);
+    }
+}
+
+//time to the first response byte, which leaves out the pool wait and the body transfer
+static int64_t FirstByteUs(CURL *curl)
+{
+#if LIBCURL_VERSION_NUM >= 0x073d00
+    curl_off_t us = 0;
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &us);
+#else
+    double seconds = 0.0;
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &seconds);
+    int64_t us = static_cast<int64_t>(seconds * 1000000);
+#endif
+    return us > 0 ? static_cast<int64_t>(us) : -1;
+}
 
-    CURLcode res = curl_easy_perform(curl);
+static void finishTransfer(TransferState &state, CURLcode res)
+{
+    HttpResponse *response = state.response;
     long response_code= 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(state.curl, CURLINFO_RESPONSE_CODE, &response_code);
 
     if (res == CURLE_OK) {
         response->setStatusCode(response_code);
@@ -576,35 +1358,287 @@ std::shared_ptr<HttpResponse> CurlHttpClient::makeRequest(const std::shared_ptr<
             break;
         };
     }
-    
-    request->setCrc64Result(transferState.crc64Value);
-    request->setTransferedBytes(transferState.transferred);
 
-    curlContainer_->Release(curl);
-
-    curl_slist_free_all(list);
+    restoreHandle(state);
+    state.headerList = nullptr;
 
     auto & body = response->Body();
     if (body != nullptr) {
         body->flush();
-        if (res != CURLE_OK && transferState.recvBodyPos != -1) {
+        if (res != CURLE_OK && state.recvBodyPos != -1) {
             OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) setResponseBody, tellp:%lld, recvBodyPos:%lld",
-                request.get(), body->tellp(), transferState.recvBodyPos);
+                state.request, body->tellp(), state.recvBodyPos);
             body->clear();
-            body->seekp(transferState.recvBodyPos);
+            body->seekp(state.recvBodyPos);
         }
     }
     else {
         response->addBody(std::make_shared<std::stringstream>());
     }
 
-    if (requestBodyPos != -1) {
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) finish transfer, CURLcode:%d, ResponseCode:%d", 
+        state.request, res, response_code);
+
+    if (state.sampler != nullptr) {
+        TraceSampler::Sample sample;
+        sample.method = state.request->method();
+        sample.url = MaskUrlCredentials(state.request->url().toString());
+        sample.statusCode = response->statusCode();
+        sample.latencyMs = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - state.startTime).count());
+        if (state.sampler->shouldEmit(sample)) {
+            state.sampler->emit(sample, state.trace);
+        }
+        state.trace.clear();
+    }
+}
+
+static void initTransferState(TransferState &state, CurlHttpClient *owner, CURL *curl,
+    HttpRequest *request, HttpResponse *response, HedgeGroup *group)
+{
+    state.owner = owner;
+    state.curl = curl;
+    state.request = request;
+    state.response = response;
+    state.transferred = 0;
+    state.total = -1;
+    state.firstRecvData = true;
+    state.recvBodyPos = -1;
+    state.progress = request->TransferProgress().Handler;
+    state.userData = request->TransferProgress().UserData;
+    state.enableCrc64 = request->hasCheckCrc64();
+    state.crc64Value = request->InitCrc64();
+    state.sendSpeed = 0;
+    state.recvSpeed = 0;
+    state.headerList = nullptr;
+    state.requestBodyPos = -1;
+    state.group = group;
+    state.contentLength = -1;
+    state.sampler = nullptr;
+    state.trace.clear();
+    state.pacer = nullptr;
+    state.pacedSend = 0;
+    state.pacedRecv = 0;
+}
+
+//waits no longer than the acquire timeout and the request deadline allow
+static CURL *AcquireHandle(CurlContainer *container, HttpRequest &request, long timeoutMs,
+    MetricsHistogram *poolWait, MetricsCounter *poolTimeouts)
+{
+    auto deadline = request.Deadline();
+    bool timed = poolWait != nullptr || request.isTraced();
+    auto start = timed || timeoutMs > 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    if (timeoutMs > 0) {
+        deadline = (std::min)(deadline, start + std::chrono::milliseconds(timeoutMs));
+    }
+
+    CURL *curl = container->Acquire(deadline);
+
+    if (timed) {
+        auto end = std::chrono::steady_clock::now();
+        if (request.isTraced()) {
+            request.PhaseTimings().acquireStart = start;
+            request.PhaseTimings().acquireEnd = end;
+        }
+        if (poolWait != nullptr) {
+            poolWait->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+            if (curl == nullptr) {
+                poolTimeouts->add();
+            }
+        }
+    }
+    return curl;
+}
+
+static std::shared_ptr<HttpResponse> PoolTimeoutResponse(const std::shared_ptr<HttpRequest> &request)
+{
+    auto response = std::make_shared<HttpResponse>(request);
+    response->setStatusCode(ERROR_CONNECTION_POOL_TIMEOUT);
+    response->setStatusMsg("Timed out waiting for a free connection.");
+    response->addBody(std::make_shared<std::stringstream>());
+    return response;
+}
+
+std::shared_ptr<HttpResponse> CurlHttpClient::makeRequest(const std::shared_ptr<HttpRequest> &request)
+{
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) enter makeRequest", request.get());
+
+    CURL * curl = AcquireHandle(curlContainer_, *request, acquireTimeoutMs_, poolWait_, poolTimeouts_);
+    if (curl == nullptr) {
+        OSS_LOG(LogLevel::LogError, TAG, "request(%p) no curl handle is free in %ld ms", request.get(), acquireTimeoutMs_);
+        return PoolTimeoutResponse(request);
+    }
+
+    auto response = std::make_shared<HttpResponse>(request);
+
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) acquire curl handle:%p", request.get(), curl);
+
+    TransferState transferState;
+    initTransferState(transferState, this, curl, request.get(), response.get(), nullptr);
+    setupTransfer(transferState);
+
+    CURLcode res = multiplexer_ != nullptr ? multiplexer_->perform(curl) : curl_easy_perform(curl);
+    finishTransfer(transferState, res);
+    request->setFirstByteUs(FirstByteUs(curl));
+    if (request->isTraced()) {
+        request->PhaseTimings().transferEnd = std::chrono::steady_clock::now();
+    }
+
+    request->setCrc64Result(transferState.crc64Value);
+    request->setTransferedBytes(transferState.transferred);
+
+    curlContainer_->Release(curl);
+
+    if (transferState.requestBodyPos != -1) {
         request->Body()->clear();
-        request->Body()->seekg(requestBodyPos);
+        request->Body()->seekg(transferState.requestBodyPos);
     }
 
-    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) leave makeRequest, CURLcode:%d, ResponseCode:%d", 
-        request.get(), res, response_code);
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) leave makeRequest, CURLcode:%d", request.get(), res);
 
     return response;
 }
+
+std::shared_ptr<HttpResponse> CurlHttpClient::makeHedgedRequest(const std::shared_ptr<HttpRequest> &request, HedgePolicy &policy)
+{
+    //the hedge would be another stream of the same connection
+    if (multiplexer_ != nullptr) {
+        return makeRequest(request);
+    }
+
+    //too many hedged requests in flight already, this one goes without
+    CURLM *multi = curlContainer_->AcquireMulti();
+    if (multi == nullptr) {
+        return makeRequest(request);
+    }
+
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) enter makeHedgedRequest", request.get());
+
+    const long delayMs = policy.hedgeDelayMs();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    HedgeGroup group = { nullptr };
+    TransferState states[2];
+    std::shared_ptr<HttpResponse> responses[2];
+    CURLcode results[2] = { CURLE_OK, CURLE_OK };
+    bool running[2] = { false, false };
+    int attempts = 0;
+
+    auto startAttempt = [&](CURL *curl) {
+        responses[attempts] = std::make_shared<HttpResponse>(request);
+        initTransferState(states[attempts], this, curl, request.get(), responses[attempts].get(), &group);
+        setupTransfer(states[attempts]);
+        curl_multi_add_handle(multi, curl);
+        running[attempts] = true;
+        attempts++;
+    };
+
+    CURL *first = AcquireHandle(curlContainer_, *request, acquireTimeoutMs_, poolWait_, poolTimeouts_);
+    if (first == nullptr) {
+        curlContainer_->ReleaseMulti(multi);
+        return PoolTimeoutResponse(request);
+    }
+    startAttempt(first);
+
+    bool hedgeChecked = false;
+    long hedgeStartMs = 0;
+    for (;;) {
+        int stillRunning = 0;
+        curl_multi_perform(multi, &stillRunning);
+
+        CURLMsg *msg = nullptr;
+        int msgsLeft = 0;
+        while ((msg = curl_multi_info_read(multi, &msgsLeft)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            for (int i = 0; i < attempts; i++) {
+                if (states[i].curl == msg->easy_handle) {
+                    results[i] = msg->data.result;
+                    running[i] = false;
+                    curl_multi_remove_handle(multi, states[i].curl);
+                }
+            }
+        }
+
+        //done when the winner has finished, or when nothing is left to wait for
+        if (group.winner != nullptr) {
+            if (!running[group.winner == &states[0] ? 0 : 1]) {
+                break;
+            }
+        }
+        else if (!running[0] && !running[1]) {
+            break;
+        }
+
+        long elapsedMs = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+
+        if (!hedgeChecked && group.winner == nullptr && elapsedMs >= delayMs) {
+            hedgeChecked = true;
+            if (running[0] && policy.acquireHedge()) {
+                CURL *curl = curlContainer_->TryAcquire();
+                if (curl != nullptr) {
+                    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) send hedged request after %ld ms, curl handle:%p",
+                        request.get(), elapsedMs, curl);
+                    hedgeStartMs = elapsedMs;
+                    startAttempt(curl);
+                }
+            }
+        }
+
+        int timeoutMs = 100;
+        if (!hedgeChecked) {
+            timeoutMs = static_cast<int>((std::min)(100L, (std::max)(0L, delayMs - elapsedMs)));
+        }
+        curl_multi_wait(multi, nullptr, 0, timeoutMs, nullptr);
+    }
+
+    //the winner, or the attempt which failed last
+    int index = 0;
+    if (group.winner != nullptr) {
+        index = (group.winner == &states[0]) ? 0 : 1;
+    }
+    else if (attempts > 1 && results[0] != CURLE_OK && results[1] == CURLE_OK) {
+        index = 1;
+    }
+
+    if (results[index] == CURLE_OK) {
+        double firstByte = 0.0;
+        curl_easy_getinfo(states[index].curl, CURLINFO_STARTTRANSFER_TIME, &firstByte);
+        long latencyMs = static_cast<long>(firstByte * 1000);
+        if (index == 1) {
+            latencyMs += hedgeStartMs;
+        }
+        policy.recordLatency(latencyMs);
+    }
+
+    for (int i = 0; i < attempts; i++) {
+        if (running[i]) {
+            curl_multi_remove_handle(multi, states[i].curl);
+            results[i] = CURLE_ABORTED_BY_CALLBACK;
+        }
+        finishTransfer(states[i], results[i]);
+        if (i == index) {
+            request->setFirstByteUs(FirstByteUs(states[i].curl));
+        }
+        curlContainer_->Release(states[i].curl);
+    }
+    curlContainer_->ReleaseMulti(multi);
+    if (request->isTraced()) {
+        request->PhaseTimings().transferEnd = std::chrono::steady_clock::now();
+    }
+
+    request->setCrc64Result(states[index].crc64Value);
+    request->setTransferedBytes(states[index].transferred);
+
+    if (states[0].requestBodyPos != -1) {
+        request->Body()->clear();
+        request->Body()->seekg(states[0].requestBodyPos);
+    }
+
+    OSS_LOG(LogLevel::LogDebug, TAG, "request(%p) leave makeHedgedRequest, attempts:%d, winner:%d, CURLcode:%d",
+        request.get(), attempts, index, results[index]);
+
+    return responses[index];
+}
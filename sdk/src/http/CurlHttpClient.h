@@ -18,6 +18,8 @@
 
 #include <alibabacloud/oss/client/ClientConfiguration.h>
 #include "HttpClient.h"
+#include <memory>
+#include <vector>
 
 namespace AlibabaCloud
 {
@@ -25,7 +27,13 @@ namespace OSS
 {
 
     class CurlContainer;
+    class CurlMultiplexer;
     class RateLimiter;
+    class TraceSampler;
+    class MetricsRegistry;
+    class MetricsHistogram;
+    class MetricsCounter;
+    struct TransferState;
 
     class CurlHttpClient : public HttpClient
     {
@@ -37,17 +45,18 @@ namespace OSS
         static void cleanupGlobalState();
 
         virtual std::shared_ptr<HttpResponse> makeRequest(const std::shared_ptr<HttpRequest> &request) override;
+        virtual std::shared_ptr<HttpResponse> makeHedgedRequest(const std::shared_ptr<HttpRequest> &request, HedgePolicy &policy) override;
+        virtual void warmUp(const std::string &url) override;
     private:
+        void setupTransfer(TransferState &state);
+        std::unique_ptr<CurlMultiplexer> multiplexer_;
         CurlContainer *curlContainer_;
-        std::string userAgent_;
-        Http::Scheme proxyScheme_;
-        std::string proxyHost_;
-        unsigned int proxyPort_;
-        std::string proxyUserName_;
-        std::string proxyPassword_;
-        bool verifySSL_;
-        std::string caPath_;
-        std::string caFile_;
+        std::shared_ptr<TraceSampler> traceSampler_;
+        std::shared_ptr<MetricsRegistry> metricsRegistry_;
+        std::vector<uint64_t> gaugeIds_;
+        long acquireTimeoutMs_;
+        MetricsHistogram *poolWait_;
+        MetricsCounter *poolTimeouts_;
     public:
         std::shared_ptr<RateLimiter> sendRateLimiter_;
         std::shared_ptr<RateLimiter> recvRateLimiter_;
@@ -15,6 +15,7 @@
  */
 
 #include "HttpClient.h"
+#include <algorithm>
 
 
 using namespace AlibabaCloud::OSS;
@@ -28,6 +29,17 @@ HttpClient::~HttpClient()
 {
 }
 
+std::shared_ptr<HttpResponse> HttpClient::makeHedgedRequest(const std::shared_ptr<HttpRequest> &request, HedgePolicy &policy)
+{
+    (void)policy;
+    return makeRequest(request);
+}
+
+void HttpClient::warmUp(const std::string &url)
+{
+    (void)url;
+}
+
 bool HttpClient::isEnable()
 {
     return disable_.load() == false;
@@ -52,3 +64,18 @@ void HttpClient::waitForRetry(long milliseconds)
     requestSignal_.wait_for(lck, std::chrono::milliseconds(milliseconds), [this] ()-> bool { return disable_.load() == true; });
 }
 
+void HttpClient::waitForRetry(long milliseconds, const std::function<bool()> &stop)
+{
+    if (milliseconds == 0)
+        return;
+    //stop() has no way to signal us, so it is polled between short waits
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    std::unique_lock<std::mutex> lck(requestLock_);
+    while (disable_.load() == false && !stop()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= until) {
+            break;
+        }
+        requestSignal_.wait_for(lck, (std::min)(until - now, std::chrono::steady_clock::duration(std::chrono::milliseconds(50))));
+    }
+}
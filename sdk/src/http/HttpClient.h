@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <functional>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -28,6 +29,7 @@ namespace AlibabaCloud
 {
 namespace OSS
 {
+    class HedgePolicy;
 
     class HttpClient
     {
@@ -36,11 +38,15 @@ namespace OSS
         virtual ~HttpClient();
 
         virtual std::shared_ptr<HttpResponse> makeRequest(const std::shared_ptr<HttpRequest> &request) = 0;
+        virtual std::shared_ptr<HttpResponse> makeHedgedRequest(const std::shared_ptr<HttpRequest> &request, HedgePolicy &policy);
+        //opens connections to the url ahead of the requests, returns at once
+        virtual void warmUp(const std::string &url);
 
         bool isEnable();
         void disable();
         void enable();
         void waitForRetry(long milliseconds);
+        void waitForRetry(long milliseconds, const std::function<bool()> &stop);
         
     protected:
         std::atomic<bool> disable_;
@@ -30,9 +30,10 @@ HttpMessage::HttpMessage(const HttpMessage &other) :
 {
 }
 
-HttpMessage::HttpMessage(HttpMessage &&other)
+HttpMessage::HttpMessage(HttpMessage &&other) :
+    headers_(std::move(other.headers_)),
+    body_(std::move(other.body_))
 {
-    *this = std::move(other);
 }
 
 HttpMessage& HttpMessage::operator=(const HttpMessage &other)
@@ -46,8 +47,10 @@ HttpMessage& HttpMessage::operator=(const HttpMessage &other)
 
 HttpMessage& HttpMessage::operator=(HttpMessage &&other)
 {
-    if (this != &other)
-        *this = std::move(other);
+    if (this != &other) {
+        body_ = std::move(other.body_);
+        headers_ = std::move(other.headers_);
+    }
     return *this;
 }
 
@@ -61,6 +64,11 @@ void HttpMessage::setHeader(const std::string & name, const std::string & value)
     headers_[name] = value;
 }
 
+void HttpMessage::setHeader(std::string &&name, std::string &&value)
+{
+    headers_[std::move(name)] = std::move(value);
+}
+
 void HttpMessage::removeHeader(const std::string & name)
 {
     headers_.erase(name);
@@ -86,6 +94,18 @@ const HeaderCollection &HttpMessage::Headers() const
     return headers_;
 }
 
+void HttpMessage::setHeaders(HeaderCollection &&headers)
+{
+    headers_ = std::move(headers);
+}
+
+HeaderCollection HttpMessage::releaseHeaders()
+{
+    HeaderCollection headers(std::move(headers_));
+    headers_.clear();
+    return headers;
+}
+
 HttpMessage::~HttpMessage()
 {
 
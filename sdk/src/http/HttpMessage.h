@@ -38,10 +38,13 @@ namespace OSS
 
         void addHeader(const std::string &name, const std::string &value);
         void setHeader(const std::string &name, const std::string &value);
+        void setHeader(std::string &&name, std::string &&value);
         void removeHeader(const std::string &name);
         bool hasHeader(const std::string &name);
         std::string Header(const std::string &name)const;
         const HeaderCollection &Headers()const;
+        void setHeaders(HeaderCollection &&headers);
+        HeaderCollection releaseHeaders();
 
         void addBody(const std::shared_ptr<std::iostream>& body) { body_ = body;}
         std::shared_ptr<std::iostream>& Body() { return body_;}
@@ -15,6 +15,7 @@
  */
 #include <alibabacloud/oss/http/HttpType.h>
 #include "HttpRequest.h"
+#include <alibabacloud/oss/client/CancellationToken.h>
 
 using namespace AlibabaCloud::OSS;
 
@@ -57,8 +58,14 @@ HttpRequest::HttpRequest(Http::Method method) :
     url_(),
     responseStreamFactory_(nullptr),
     hasCheckCrc64_(false),
+    initCrc64_(0),
     crc64Result_(0),
-    transferedBytes_(0)
+    transferedBytes_(0),
+    resumeOffset_(0),
+    firstByteUs_(-1),
+    cancellationToken_(nullptr),
+    deadline_((std::chrono::steady_clock::time_point::max)()),
+    traced_(false)
 {
 }
 
@@ -66,6 +73,14 @@ HttpRequest::~HttpRequest()
 {
 }
 
+bool HttpRequest::isAborted() const
+{
+    if (cancellationToken_ != nullptr && cancellationToken_->isCancelled()) {
+        return true;
+    }
+    return std::chrono::steady_clock::now() >= deadline_;
+}
+
 Http::Method HttpRequest::method() const
 {
     return method_;
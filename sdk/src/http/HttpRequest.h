@@ -18,6 +18,7 @@
 
 #include <alibabacloud/oss/Types.h>
 #include <string>
+#include <chrono>
 #include "HttpMessage.h"
 #include "Url.h"
 #include <alibabacloud/oss/ServiceRequest.h>
@@ -46,11 +47,40 @@ namespace OSS
 
             void setCheckCrc64(bool enable) { hasCheckCrc64_ = enable; }
             bool hasCheckCrc64() const { return hasCheckCrc64_; }
+            void setInitCrc64(uint64_t crc) { initCrc64_ = crc; }
+            uint64_t InitCrc64() const { return initCrc64_; }
             void setCrc64Result(uint64_t crc) { crc64Result_ = crc; }
             uint64_t Crc64Result() const { return crc64Result_; }
 
+            void setResumeOffset(int64_t offset) { resumeOffset_ = offset; }
+            int64_t ResumeOffset() const { return resumeOffset_; }
+
             void setTransferedBytes(int64_t value) { transferedBytes_ = value; }
             uint64_t TransferedBytes() const { return transferedBytes_;}
+            //from the start of the transfer to the first response byte, -1 if none arrived
+            void setFirstByteUs(int64_t value) { firstByteUs_ = value; }
+            int64_t FirstByteUs() const { return firstByteUs_; }
+
+            void setCancellationToken(const std::shared_ptr<AlibabaCloud::OSS::CancellationToken> &token) { cancellationToken_ = token; }
+            const std::shared_ptr<AlibabaCloud::OSS::CancellationToken> &CancellationToken() const { return cancellationToken_; }
+            void setDeadline(const std::chrono::steady_clock::time_point &deadline) { deadline_ = deadline; }
+            const std::chrono::steady_clock::time_point &Deadline() const { return deadline_; }
+            //cancelled by the token or past the deadline
+            bool isAborted() const;
+
+            //when the phases of the request happened, only recorded for a traced request
+            struct Timings
+            {
+                std::chrono::steady_clock::time_point signStart;
+                std::chrono::steady_clock::time_point signEnd;
+                std::chrono::steady_clock::time_point acquireStart;
+                std::chrono::steady_clock::time_point acquireEnd;
+                std::chrono::steady_clock::time_point transferEnd;
+            };
+            void setTraced(bool traced) { traced_ = traced; }
+            bool isTraced() const { return traced_; }
+            Timings &PhaseTimings() { return timings_; }
+            const Timings &PhaseTimings() const { return timings_; }
 
         private:
             Http::Method method_;
@@ -58,8 +88,15 @@ namespace OSS
             IOStreamFactory responseStreamFactory_;
             AlibabaCloud::OSS::TransferProgress transferProgress_;
             bool hasCheckCrc64_;
+            uint64_t initCrc64_;
             uint64_t crc64Result_;
             int64_t transferedBytes_;
+            int64_t resumeOffset_;
+            int64_t firstByteUs_;
+            std::shared_ptr<AlibabaCloud::OSS::CancellationToken> cancellationToken_;
+            std::chrono::steady_clock::time_point deadline_;
+            bool traced_;
+            Timings timings_;
     };
 }
 }
@@ -16,75 +16,160 @@
 
 #include "Executor.h"
 #include <alibabacloud/oss/utils/Runnable.h>
-#include <assert.h>
 #include "../utils/LogUtils.h"
+#include <chrono>
 
 using namespace AlibabaCloud::OSS;
 
 static const char *TAG = "Executor";
 
-Executor::Executor():
-    state_(State::Free)
+//no task taken for this long with every worker busy, the workers are likely waiting on queued tasks
+static const std::chrono::milliseconds STALL_TIMEOUT(100);
+//how long a worker above poolSize stays idle before it exits
+static const std::chrono::seconds KEEP_ALIVE(60);
+
+Executor::Executor(size_t poolSize, size_t maxPoolSize):
+    poolSize_(poolSize > 0 ? poolSize : 1),
+    maxPoolSize_(maxPoolSize > poolSize_ ? maxPoolSize : poolSize_),
+    idleCount_(0),
+    taken_(0),
+    shutdown_(false)
 {
 }
 
 Executor::~Executor()
 {
-    auto expected = State::Free;
-    while (!state_.compare_exchange_strong(expected, State::Shutdown))
     {
-        assert(expected == State::Locked);
-        expected = State::Free;
+        std::lock_guard<std::mutex> locker(lock_);
+        shutdown_ = true;
+    }
+    cv_.notify_all();
+    monitorCv_.notify_all();
+    if (monitor_.joinable()) {
+        monitor_.join();
     }
 
-    auto it = threads_.begin();
-    while (!threads_.empty())
+    //no worker retires after the shutdown, the lists don't change anymore
+    std::list<std::thread> threads;
+    std::vector<std::thread> retired;
     {
-        it->second.join();
-        it = threads_.erase(it);
+        std::lock_guard<std::mutex> locker(lock_);
+        threads.swap(threads_);
+        retired.swap(retired_);
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (auto &t : retired) {
+        t.join();
     }
 }
 
-void Executor::execute(Runnable* task)
+//called with the lock held
+void Executor::startWorker()
 {
-    auto main = [task, this] {
-        OSS_LOG(LogLevel::LogDebug, TAG, "task(%p) enter execute main thread", task);
-        task->run();
-        delete task;
-        detach(std::this_thread::get_id());
-        OSS_LOG(LogLevel::LogDebug, TAG, "task(%p) leave execute main thread", task);
-    };
+    threads_.emplace_back();
+    auto self = std::prev(threads_.end());
+    *self = std::thread(&Executor::workerLoop, this, self);
+}
 
-    State expected;
-    do
+void Executor::execute(Runnable* task)
+{
     {
-        expected = State::Free;
-        if (state_.compare_exchange_strong(expected, State::Locked))
-        {
-            std::thread t(main);
-            const auto id = t.get_id(); 
-            threads_.emplace(id, std::move(t));
-            state_ = State::Free;
+        std::unique_lock<std::mutex> locker(lock_);
+        if (shutdown_) {
+            OSS_LOG(LogLevel::LogError, TAG, "task(%p) dropped, executor is shutdown", task);
+            delete task;
             return;
         }
-    } while (expected != State::Shutdown);
-    return;
+        tasks_.push(task);
+        if (idleCount_ < tasks_.size() && threads_.size() < poolSize_) {
+            startWorker();
+        }
+        else if (idleCount_ == 0) {
+            if (!monitor_.joinable()) {
+                monitor_ = std::thread(&Executor::monitorLoop, this);
+            }
+            monitorCv_.notify_one();
+        }
+        joinRetired(locker);
+    }
+    cv_.notify_one();
 }
 
-void Executor::detach(std::thread::id id)
+//called with the lock held, returns with it held
+void Executor::joinRetired(std::unique_lock<std::mutex> &locker)
 {
-    State expected;
-    do
-    {
-        expected = State::Free;
-        if (state_.compare_exchange_strong(expected, State::Locked))
-        {
-            auto it = threads_.find(id);
-            assert(it != threads_.end());
-            it->second.detach();
-            threads_.erase(it);
-            state_ = State::Free;
+    if (retired_.empty()) {
+        return;
+    }
+    std::vector<std::thread> retired;
+    retired.swap(retired_);
+    locker.unlock();
+    for (auto &t : retired) {
+        t.join();
+    }
+    locker.lock();
+}
+
+size_t Executor::queueSize()
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    return tasks_.size();
+}
+
+size_t Executor::threadCount()
+{
+    std::lock_guard<std::mutex> locker(lock_);
+    return threads_.size();
+}
+
+void Executor::workerLoop(std::list<std::thread>::iterator self)
+{
+    std::unique_lock<std::mutex> locker(lock_);
+    for (;;) {
+        idleCount_++;
+        bool ready = cv_.wait_for(locker, KEEP_ALIVE, [this]() { return shutdown_ || !tasks_.empty(); });
+        idleCount_--;
+        if (!ready) {
+            if (threads_.size() > poolSize_) {
+                //joined by the next execute or the destructor
+                retired_.push_back(std::move(*self));
+                threads_.erase(self);
+                return;
+            }
+            continue;
+        }
+        if (tasks_.empty()) {
+            //shutdown and nothing left to run
             return;
         }
-    } while (expected != State::Shutdown);
-}
\ No newline at end of file
+        Runnable *task = tasks_.front();
+        tasks_.pop();
+        taken_++;
+        locker.unlock();
+
+        OSS_LOG(LogLevel::LogDebug, TAG, "task(%p) enter execute worker thread", task);
+        task->run();
+        delete task;
+        OSS_LOG(LogLevel::LogDebug, TAG, "task(%p) leave execute worker thread", task);
+
+        locker.lock();
+    }
+}
+
+void Executor::monitorLoop()
+{
+    std::unique_lock<std::mutex> locker(lock_);
+    while (!shutdown_) {
+        monitorCv_.wait(locker, [this]() { return shutdown_ || (!tasks_.empty() && idleCount_ == 0); });
+        uint64_t taken = taken_;
+        if (monitorCv_.wait_for(locker, STALL_TIMEOUT, [this]() { return shutdown_; })) {
+            break;
+        }
+        if (!tasks_.empty() && idleCount_ == 0 && taken_ == taken && threads_.size() < maxPoolSize_) {
+            startWorker();
+            OSS_LOG(LogLevel::LogInfo, TAG, "queue stalled, start worker %u", static_cast<unsigned>(threads_.size()));
+        }
+    }
+}
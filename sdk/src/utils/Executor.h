@@ -16,33 +16,51 @@
 
 #pragma once
 
-#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <list>
 #include <queue>
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <unordered_map>
 
 namespace AlibabaCloud
 {
 namespace OSS
 {
     class Runnable;
+    /*
+    * A pool of worker threads, started on demand up to poolSize.
+    * A task may wait for another one, e.g. a handler calling *Callable().get(), so when
+    * the queue makes no progress for a while with every worker busy, a monitor starts
+    * another worker, up to maxPoolSize. Workers above poolSize exit once idle for a minute.
+    * Tasks queued when the executor is destroyed still run before it returns.
+    */
     class Executor
     {
     public:
-        Executor();
+        explicit Executor(size_t poolSize = 16, size_t maxPoolSize = 256);
         ~Executor();
         void execute(Runnable* task);
+        size_t queueSize();
+        size_t threadCount();
     private:
-        enum class State
-        {
-            Free, Locked, Shutdown
-        };
-        void detach(std::thread::id id);
-        std::atomic<State> state_;
-        std::unordered_map<std::thread::id, std::thread> threads_;
+        void startWorker();
+        void workerLoop(std::list<std::thread>::iterator self);
+        void monitorLoop();
+        void joinRetired(std::unique_lock<std::mutex> &locker);
+        size_t poolSize_;
+        size_t maxPoolSize_;
+        size_t idleCount_;
+        uint64_t taken_;
+        bool shutdown_;
+        std::mutex lock_;
+        std::condition_variable cv_;
+        std::condition_variable monitorCv_;
+        std::queue<Runnable*> tasks_;
+        std::list<std::thread> threads_;
+        std::vector<std::thread> retired_;
+        std::thread monitor_;
     };
 }
 }
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/utils/HeaderCollection.h>
+#include <algorithm>
+
+using namespace AlibabaCloud::OSS;
+
+static inline unsigned char AsciiLower(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+}
+
+static bool EqualsIgnoreCase(const std::string &lhs, const std::string &rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (AsciiLower(lhs[i]) != AsciiLower(rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool LessIgnoreCase(const std::string &lhs, const std::string &rhs)
+{
+    size_t n = std::min(lhs.size(), rhs.size());
+    for (size_t i = 0; i < n; i++) {
+        unsigned char a = AsciiLower(lhs[i]);
+        unsigned char b = AsciiLower(rhs[i]);
+        if (a != b) {
+            return a < b;
+        }
+    }
+    return lhs.size() < rhs.size();
+}
+
+//FNV-1a of the lower case name
+uint32_t HeaderCollection::Hash(const char *name, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= AsciiLower(static_cast<unsigned char>(name[i]));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+HeaderCollection::HeaderCollection(std::initializer_list<value_type> values)
+{
+    entries_.reserve(values.size());
+    for (auto const &value : values) {
+        insert(value);
+    }
+}
+
+//the first entry whose name is not less than the given one
+size_t HeaderCollection::lowerBound(const std::string &name) const
+{
+    auto pos = std::lower_bound(entries_.begin(), entries_.end(), name,
+        [](const Entry &entry, const std::string &key) { return LessIgnoreCase(entry.first, key); });
+    return static_cast<size_t>(pos - entries_.begin());
+}
+
+bool HeaderCollection::matches(size_t index, const std::string &name, uint32_t hash) const
+{
+    return index != entries_.size() && entries_[index].hash == hash && EqualsIgnoreCase(entries_[index].first, name);
+}
+
+size_t HeaderCollection::indexOf(const std::string &name, uint32_t hash) const
+{
+    //a response has a dozen or so headers, a scan of their hashes beats a binary search of string compares
+    if (entries_.size() <= 16) {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (matches(i, name, hash)) {
+                return i;
+            }
+        }
+        return entries_.size();
+    }
+    size_t index = lowerBound(name);
+    return matches(index, name, hash) ? index : entries_.size();
+}
+
+std::pair<HeaderCollection::iterator, bool> HeaderCollection::insertNew(value_type &&value, uint32_t hash, size_t index)
+{
+    if (entries_.capacity() == 0) {
+        //enough for most requests and responses in one allocation
+        entries_.reserve(16);
+    }
+    auto pos = entries_.emplace(entries_.begin() + index, std::move(value), hash);
+    return std::make_pair(pos, true);
+}
+
+HeaderCollection::iterator HeaderCollection::find(const std::string &name)
+{
+    return entries_.begin() + indexOf(name, Hash(name.data(), name.size()));
+}
+
+HeaderCollection::const_iterator HeaderCollection::find(const std::string &name) const
+{
+    return entries_.begin() + indexOf(name, Hash(name.data(), name.size()));
+}
+
+const std::string &HeaderCollection::at(const std::string &name) const
+{
+    static const std::string empty;
+    auto it = find(name);
+    return it != end() ? it->second : empty;
+}
+
+std::string &HeaderCollection::operator[](const std::string &name)
+{
+    uint32_t hash = Hash(name.data(), name.size());
+    size_t index = indexOf(name, hash);
+    if (index != entries_.size()) {
+        return entries_[index].second;
+    }
+    index = lowerBound(name);
+    return insertNew(value_type(name, std::string()), hash, index).first->second;
+}
+
+std::string &HeaderCollection::operator[](std::string &&name)
+{
+    uint32_t hash = Hash(name.data(), name.size());
+    size_t index = indexOf(name, hash);
+    if (index != entries_.size()) {
+        return entries_[index].second;
+    }
+    index = lowerBound(name);
+    return insertNew(value_type(std::move(name), std::string()), hash, index).first->second;
+}
+
+std::pair<HeaderCollection::iterator, bool> HeaderCollection::insert(const value_type &value)
+{
+    return insert(value_type(value));
+}
+
+std::pair<HeaderCollection::iterator, bool> HeaderCollection::insert(value_type &&value)
+{
+    uint32_t hash = Hash(value.first.data(), value.first.size());
+    size_t index = indexOf(value.first, hash);
+    if (index != entries_.size()) {
+        return std::make_pair(entries_.begin() + index, false);
+    }
+    index = lowerBound(value.first);
+    return insertNew(std::move(value), hash, index);
+}
+
+HeaderCollection::size_type HeaderCollection::erase(const std::string &name)
+{
+    auto it = find(name);
+    if (it == end()) {
+        return 0;
+    }
+    entries_.erase(it);
+    return 1;
+}
+
+HeaderCollection::iterator HeaderCollection::erase(const_iterator pos)
+{
+    return entries_.erase(pos);
+}
+
+bool HeaderCollection::operator==(const HeaderCollection &other) const
+{
+    if (size() != other.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i].hash != other.entries_[i].hash ||
+            !EqualsIgnoreCase(entries_[i].first, other.entries_[i].first) ||
+            entries_[i].second != other.entries_[i].second) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -19,73 +19,302 @@
 #include <iostream>
 #include <memory>
 #include <cstdarg>
+#include <cstdio>
+#include <cstring>
 #include <sstream>
 #include <chrono>
-#include <iomanip>
 #include <ctime>
 #include <thread>
-#include <cstdarg>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 using namespace AlibabaCloud::OSS;
 
-static LogLevel    gOssLogLevel = LogLevel::LogOff;
-static LogCallback gLogCallback = nullptr;
+static std::atomic<LogLevel>    gOssLogLevel(LogLevel::LogOff);
+static std::atomic<LogCallback> gLogCallback(nullptr);
 const static char *EnvLogLevels[] =
 {
     "off", "fatal", "error", "warn",
     "info", "debug", "trace", "all"
 };
 
-static std::string LogPrefix(LogLevel logLevel, const char* tag)
+namespace
 {
-    static const char *LogStr[] = {"[OFF]", "[FATAL]", "[ERROR]", "[WARN]", "[INFO]" , "[DEBUG]", "[TRACE]", "[ALL]"};
-    int index = logLevel - LogLevel::LogOff;
-    std::stringstream ss;
-    auto tp = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
-    auto ms = tp.time_since_epoch().count() % 1000;
-    auto t = std::chrono::system_clock::to_time_t(tp);
-    struct tm tm;
+    struct LogRecord
+    {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        const char *tag;
+        std::chrono::system_clock::time_point time;
+        std::thread::id threadId;
+        int length;
+        char message[2050];
+    };
+
+    /*
+    * A bounded multi-producer ring (per-slot sequence numbers) drained by one worker.
+    * Producers only claim a slot and format the message into it, the prefix is built
+    * and the callback is called on the worker thread.
+    */
+    class AsyncLogger
+    {
+    public:
+        static const size_t Capacity = 512;
+
+        AsyncLogger() :
+            records_(new LogRecord[Capacity]),
+            enqueuePos_(0),
+            dequeuePos_(0),
+            delivered_(0),
+            dropped_(0),
+            reported_(0),
+            idle_(false),
+            running_(false),
+            stop_(false),
+            cachedSecond_(-1)
+        {
+            for (size_t i = 0; i < Capacity; i++) {
+                records_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        void log(LogLevel level, const char *tag, const char *fmt, va_list args)
+        {
+            size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            LogRecord *record;
+            for (;;) {
+                record = &records_[pos & (Capacity - 1)];
+                size_t seq = record->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            record->level = level;
+            record->tag = tag;
+            record->time = std::chrono::system_clock::now();
+            record->threadId = std::this_thread::get_id();
 #ifdef WIN32
-    ::localtime_s(&tm, &t);
+            int i = vsnprintf_s(record->message, sizeof(record->message) - 1, _TRUNCATE, fmt, args);
 #else
-    ::localtime_r(&t, &tm);
+            int i = vsnprintf(record->message, sizeof(record->message) - 1, fmt, args);
 #endif
-#if defined(__GNUG__) && __GNUC__ < 5
-    char tmbuff[64];
-    strftime(tmbuff, 64, "%Y-%m-%d %H:%M:%S.", &tm);
-    ss << "[" << tmbuff << std::setw(3) << std::setfill('0') << ms << "]";
+            if (i < 0) {
+                i = 0;
+            }
+            else if (i > static_cast<int>(sizeof(record->message)) - 2) {
+                i = static_cast<int>(sizeof(record->message)) - 2;
+            }
+            while (i > 0 && record->message[i - 1] == '\n') {
+                i--;
+            }
+            record->length = i;
+            record->sequence.store(pos + 1, std::memory_order_release);
+
+            start();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (idle_.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lck(lock_);
+                cv_.notify_one();
+            }
+        }
+
+        void flush()
+        {
+            size_t target = enqueuePos_.load(std::memory_order_acquire);
+            //a callback which logs or switches the callback must not wait for itself
+            if (!running_.load(std::memory_order_acquire) ||
+                worker_.get_id() == std::this_thread::get_id()) {
+                return;
+            }
+            std::unique_lock<std::mutex> lck(lock_);
+            cv_.notify_one();
+            drainedCv_.wait(lck, [&]() {
+                return delivered_ >= target || !running_.load(std::memory_order_relaxed);
+            });
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> locker(stateLock_);
+            if (!running_.load(std::memory_order_acquire)) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lck(lock_);
+                stop_ = true;
+                cv_.notify_one();
+            }
+            worker_.join();
+            running_.store(false, std::memory_order_release);
+            stop_ = false;
+        }
+
+        uint64_t dropped() const
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void start()
+        {
+            if (running_.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::lock_guard<std::mutex> locker(stateLock_);
+            if (!running_.load(std::memory_order_relaxed)) {
+                worker_ = std::thread(&AsyncLogger::run, this);
+                running_.store(true, std::memory_order_release);
+            }
+        }
+
+        bool pending() const
+        {
+            const LogRecord &record = records_[dequeuePos_ & (Capacity - 1)];
+            return record.sequence.load(std::memory_order_acquire) == dequeuePos_ + 1;
+        }
+
+        void run()
+        {
+            std::string line;
+            for (;;) {
+                bool drained = false;
+                while (pending()) {
+                    LogRecord &record = records_[dequeuePos_ & (Capacity - 1)];
+                    LogLevel level = record.level;
+                    formatLine(record, line);
+                    record.sequence.store(dequeuePos_ + Capacity, std::memory_order_release);
+                    dequeuePos_++;
+                    deliver(level, line);
+                    drained = true;
+                }
+                reportDropped(line);
+
+                std::unique_lock<std::mutex> lck(lock_);
+                if (drained) {
+                    delivered_ = dequeuePos_;
+                    drainedCv_.notify_all();
+                }
+                if (stop_) {
+                    if (!pending())
+                        break;
+                    continue;
+                }
+                idle_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                cv_.wait_for(lck, std::chrono::milliseconds(100), [&]() { return stop_ || pending(); });
+                idle_.store(false, std::memory_order_relaxed);
+            }
+            std::lock_guard<std::mutex> lck(lock_);
+            delivered_ = dequeuePos_;
+            drainedCv_.notify_all();
+        }
+
+        void deliver(LogLevel level, const std::string &line)
+        {
+            LogCallback callback = gLogCallback.load(std::memory_order_acquire);
+            if (callback) {
+                callback(level, line);
+            }
+        }
+
+        void reportDropped(std::string &line)
+        {
+            uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+            if (dropped == reported_) {
+                return;
+            }
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%llu log records dropped",
+                static_cast<unsigned long long>(dropped - reported_));
+            reported_ = dropped;
+
+            LogRecord record;
+            record.level = LogLevel::LogWarn;
+            record.tag = "LogUtils";
+            record.time = std::chrono::system_clock::now();
+            record.threadId = std::this_thread::get_id();
+            record.length = static_cast<int>(strlen(buffer));
+            memcpy(record.message, buffer, record.length);
+            formatLine(record, line);
+            deliver(record.level, line);
+        }
+
+        void formatLine(const LogRecord &record, std::string &line)
+        {
+            static const char *LogStr[] = {"[OFF]", "[FATAL]", "[ERROR]", "[WARN]", "[INFO]" , "[DEBUG]", "[TRACE]", "[ALL]"};
+            int index = record.level - LogLevel::LogOff;
+            auto tp = std::chrono::time_point_cast<std::chrono::milliseconds>(record.time);
+            auto ms = tp.time_since_epoch().count() % 1000;
+            auto t = std::chrono::system_clock::to_time_t(tp);
+            if (t != cachedSecond_) {
+                struct tm tm;
+#ifdef WIN32
+                ::localtime_s(&tm, &t);
 #else
-    ss << "[" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S.") << std::setw(3) << std::setfill('0') << ms << "]";
+                ::localtime_r(&t, &tm);
 #endif
-    ss << LogStr[index];
-    ss << "[" << tag << "]";
-    ss << "[" << std::this_thread::get_id() << "]";
-    return ss.str();
+                strftime(cachedTime_, sizeof(cachedTime_), "%Y-%m-%d %H:%M:%S.", &tm);
+                cachedSecond_ = t;
+            }
+            if (record.threadId != cachedThreadId_ || cachedThread_.empty()) {
+                std::stringstream ss;
+                ss << record.threadId;
+                cachedThread_ = ss.str();
+                cachedThreadId_ = record.threadId;
+            }
+
+            char prefix[128];
+            snprintf(prefix, sizeof(prefix), "[%s%03d]%s[", cachedTime_, static_cast<int>(ms), LogStr[index]);
+            line.assign(prefix);
+            line.append(record.tag).append("][").append(cachedThread_).append("]");
+            line.append(record.message, record.length);
+            line.push_back('\n');
+        }
+
+        std::unique_ptr<LogRecord[]> records_;
+        std::atomic<size_t> enqueuePos_;
+        size_t dequeuePos_;
+        size_t delivered_;
+        std::atomic<uint64_t> dropped_;
+        uint64_t reported_;
+        std::atomic<bool> idle_;
+        std::atomic<bool> running_;
+        bool stop_;
+        std::mutex lock_;
+        std::condition_variable cv_;
+        std::condition_variable drainedCv_;
+        std::mutex stateLock_;
+        std::thread worker_;
+        std::time_t cachedSecond_;
+        char cachedTime_[64];
+        std::thread::id cachedThreadId_;
+        std::string cachedThread_;
+    };
+}
+
+//never destroyed, the worker may still be running when static objects are torn down
+static AsyncLogger &Logger()
+{
+    static AsyncLogger *logger = new AsyncLogger();
+    return *logger;
 }
 
 void AlibabaCloud::OSS::FormattedLog(LogLevel logLevel, const char* tag, const char* fmt, ...)
 {
-    std::stringstream ss;
-    ss << LogPrefix(logLevel, tag);
-    char buffer[2050];
-    int i = 0;
     va_list args;
     va_start(args, fmt);
-#ifdef WIN32
-    i = vsnprintf_s(buffer, sizeof(buffer) - 1, _TRUNCATE, fmt, args);
-#else
-    i = vsnprintf(buffer, sizeof(buffer) - 1, fmt, args);
-#endif
+    Logger().log(logLevel, tag, fmt, args);
     va_end(args);
-
-    while (i > 0 && buffer[i - 1] == '\n') {
-        i--;
-        buffer[i] = '\0';
-    }
-
-    ss << buffer << std::endl;
-    if (gLogCallback) {
-        gLogCallback(logLevel, ss.str());
-    }
 }
 
 static void DefaultLogCallbackFunc(LogLevel level, const std::string &stream)
@@ -96,12 +325,12 @@ static void DefaultLogCallbackFunc(LogLevel level, const std::string &stream)
 
 LogLevel AlibabaCloud::OSS::GetLogLevelInner()
 {
-    return gOssLogLevel;
+    return gOssLogLevel.load(std::memory_order_relaxed);
 }
 
 LogCallback AlibabaCloud::OSS::GetLogCallbackInner()
 {
-    return gLogCallback;
+    return gLogCallback.load(std::memory_order_relaxed);
 }
 
 void AlibabaCloud::OSS::SetLogLevelInner(LogLevel level)
@@ -111,9 +340,21 @@ void AlibabaCloud::OSS::SetLogLevelInner(LogLevel level)
 
 void AlibabaCloud::OSS::SetLogCallbackInner(LogCallback callback)
 {
+    //records logged before the switch still go to the previous callback
+    Logger().flush();
     gLogCallback = callback;
 }
 
+void AlibabaCloud::OSS::FlushLogInner()
+{
+    Logger().flush();
+}
+
+uint64_t AlibabaCloud::OSS::GetLogDroppedCountInner()
+{
+    return Logger().dropped();
+}
+
 void AlibabaCloud::OSS::InitLogInner()
 {
     gOssLogLevel = LogLevel::LogOff;
@@ -134,6 +375,7 @@ void AlibabaCloud::OSS::InitLogInner()
 
 void AlibabaCloud::OSS::DeinitLogInner()
 {
+    Logger().stop();
     gOssLogLevel = LogLevel::LogOff;
     gLogCallback = nullptr;
 }
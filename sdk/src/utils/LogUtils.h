@@ -28,7 +28,14 @@ namespace OSS
     LogCallback GetLogCallbackInner();
     void SetLogLevelInner(LogLevel level);
     void SetLogCallbackInner(LogCallback callback);
-
+    void FlushLogInner();
+    uint64_t GetLogDroppedCountInner();
+
+    /*
+    * The message is formatted into a slot of a bounded ring and handed to the
+    * log callback by a background thread. The record is dropped and counted
+    * when the ring is full. The tag must be a string literal.
+    */
     void FormattedLog(LogLevel logLevel, const char* tag, const char* formatStr, ...);
 
 #ifdef DISABLE_OSS_LOGGING
@@ -39,7 +46,7 @@ namespace OSS
 
     #define OSS_LOG(level, tag, ...) \
     { \
-        if ( AlibabaCloud::OSS::GetLogCallbackInner() && AlibabaCloud::OSS::GetLogLevelInner() >= level ) \
+        if ( AlibabaCloud::OSS::GetLogLevelInner() >= level && AlibabaCloud::OSS::GetLogCallbackInner() ) \
         { \
             FormattedLog(level, tag, __VA_ARGS__); \
         } \
@@ -15,26 +15,62 @@
  */
 
 #include "SignUtils.h"
-#include "Utils.h"
-#include <sstream>
-#include <map>
-#include <set>
+#include <algorithm>
+#include <cstring>
 #include <alibabacloud/oss/Const.h>
 #include <alibabacloud/oss/Types.h>
 #include <alibabacloud/oss/http/HttpType.h>
 
 using namespace AlibabaCloud::OSS;
 
-const static std::set<std::string> ParamtersToSign =
+//sorted by strcmp, looked up by binary search
+static const char *ParamtersToSign[] =
 {
-    "acl", "location", "bucketInfo", "stat", "referer", "cors", "website", "restore",
-    "logging", "symlink", "qos", "uploadId", "uploads", "partNumber",
-    "response-content-type", "response-content-language", "response-expires",
+    "acl", "append", "bucketInfo", "comp", "cors", "delete", "endTime", "lifecycle",
+    "live", "location", "logging", "objectMeta", "partNumber", "position", "qos", "referer",
     "response-cache-control", "response-content-disposition", "response-content-encoding",
-    "append", "position", "lifecycle", "delete", "live", "status", "comp", "vod",
-    "startTime", "endTime", "x-oss-process", "security-token", "objectMeta"
+    "response-content-language", "response-content-type", "response-expires",
+    "restore", "security-token", "startTime", "stat", "status", "symlink",
+    "uploadId", "uploads", "vod", "website", "x-oss-process"
 };
 
+static bool IsParamterToSign(const std::string &name)
+{
+    auto begin = std::begin(ParamtersToSign);
+    auto end = std::end(ParamtersToSign);
+    auto it = std::lower_bound(begin, end, name.c_str(),
+        [](const char *lhs, const char *rhs) { return std::strcmp(lhs, rhs) < 0; });
+    return it != end && name == *it;
+}
+
+static inline bool IsSpace(char c)
+{
+    return ::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+//the [begin, end) range of str without the leading and trailing spaces
+static inline void TrimRange(const std::string &str, size_t &begin, size_t &end)
+{
+    begin = 0;
+    end = str.size();
+    while (begin < end && IsSpace(str[begin])) begin++;
+    while (end > begin && IsSpace(str[end - 1])) end--;
+}
+
+static inline bool IsOssHeader(const std::string &name, size_t begin, size_t end)
+{
+    static const char prefix[] = "x-oss-";
+    if (end - begin < sizeof(prefix) - 1) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(prefix) - 1; i++) {
+        if (::tolower(static_cast<unsigned char>(name[begin + i])) != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 SignUtils::SignUtils(const std::string &version):
     signVersion_(version),
     canonicalString_()
@@ -56,8 +92,6 @@ void SignUtils::build(const std::string &method,
                       const HeaderCollection &headers,
                       const ParameterCollection &parameters)
 {
-    std::stringstream ss;
-
     /*Version 1*/
     // VERB + "\n" +
     // Content-MD5 + "\n"  +
@@ -66,43 +100,67 @@ void SignUtils::build(const std::string &method,
     // CanonicalizedOSSHeaders +
     // CanonicalizedResource) +
 
+    auto contentMd5 = headers.find(Http::CONTENT_MD5);
+    auto contentType = headers.find(Http::CONTENT_TYPE);
+
+    //size it first, so the string is allocated once
+    size_t size = method.size() + date.size() + resource.size() + 3;
+    if (contentMd5 != headers.end()) size += contentMd5->second.size();
+    if (contentType != headers.end()) size += contentType->second.size();
+    for (const auto &header : headers) {
+        size += header.first.size() + header.second.size() + 2;
+    }
+    for (const auto &param : parameters) {
+        size += param.first.size() + param.second.size() + 2;
+    }
+
+    std::string &out = canonicalString_;
+    out.clear();
+    out.reserve(size);
+
     //common headers
-    ss << method << "\n";
-    if (headers.find(Http::CONTENT_MD5) != headers.end()) {
-        ss << headers.at(Http::CONTENT_MD5);
+    out.append(method).push_back('\n');
+    if (contentMd5 != headers.end()) {
+        out.append(contentMd5->second);
     }
-    ss << "\n";
-    if (headers.find(Http::CONTENT_TYPE) != headers.end()) {
-        ss << headers.at(Http::CONTENT_TYPE);
+    out.push_back('\n');
+    if (contentType != headers.end()) {
+        out.append(contentType->second);
     }
-    ss << "\n";
+    out.push_back('\n');
     //Date or EXPIRES
-    ss << date << "\n";
+    out.append(date).push_back('\n');
 
-    //CanonicalizedOSSHeaders, start with x-oss-
+    //CanonicalizedOSSHeaders, start with x-oss-, lower case and trimmed in place
     for (const auto &header : headers) {
-        std::string lower = Trim(ToLower(header.first.c_str()).c_str());
-        if (lower.compare(0, 6, "x-oss-", 6) == 0) {
-            std::string value = Trim(header.second.c_str());
-            ss << lower << ":" << value << "\n";
+        size_t begin, end;
+        TrimRange(header.first, begin, end);
+        if (!IsOssHeader(header.first, begin, end)) {
+            continue;
+        }
+        for (size_t i = begin; i < end; i++) {
+            out.push_back(static_cast<char>(::tolower(static_cast<unsigned char>(header.first[i]))));
         }
+        out.push_back(':');
+        TrimRange(header.second, begin, end);
+        out.append(header.second, begin, end - begin);
+        out.push_back('\n');
     }
 
     //CanonicalizedResource, the sub resouce in
-    ss << resource;
+    out.append(resource);
     char separator = '?';
     for (auto const& param : parameters) {
-        if (ParamtersToSign.find(param.first) == ParamtersToSign.end()) {
+        if (!IsParamterToSign(param.first)) {
             continue;
         }
 
-        ss << separator;
-        ss << param.first;
+        out.push_back(separator);
+        out.append(param.first);
         if (!param.second.empty()) {
-            ss << "=" << param.second;
+            out.push_back('=');
+            out.append(param.second);
         }
         separator = '&';
     }
-
-    canonicalString_ = ss.str();
 }
@@ -20,6 +20,7 @@
 #include <openssl/md5.h>
 #include <algorithm>
 #include <cstring>
+#include <cstdio>
 #include <iostream> 
 #include <sstream>
 #include <map>
@@ -28,6 +29,11 @@
 #include <alibabacloud/oss/Const.h>
 #include <alibabacloud/oss/http/HttpType.h>
 #include "../http/Url.h"
+#if (defined(__SSE2__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define ALIBABACLOUD_OSS_SSE2
+#endif
 
 using namespace AlibabaCloud::OSS;
 
@@ -36,54 +42,227 @@ std::string AlibabaCloud::OSS::GenerateUuid()
     return "";
 }
 
-std::string AlibabaCloud::OSS::UrlEncode(const std::string & src)
+//1 for the bytes UrlEncode keeps as is: ALPHA, DIGIT, '-', '.', '_', '~'
+static const unsigned char UnreservedTable[256] =
+{
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0, 1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,1,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,0,0,0,1,0,
+};
+
+//the value of a hex digit, 0xFF if it is not one
+static const unsigned char HexValueTable[256] =
+{
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0,1,2,3,4,5,6,7,8,9,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,10,11,12,13,14,15,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,10,11,12,13,14,15,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+};
+
+#if defined(ALIBABACLOUD_OSS_SSE2)
+//bit i is set if src[i] is unreserved
+static inline unsigned int UnreservedMask(const unsigned char *src)
+{
+    //bytes >= 0x80 are negative as signed and fall out of every range
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    ok = _mm_or_si128(ok, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1))));
+    ok = _mm_or_si128(ok, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1))));
+    ok = _mm_or_si128(ok, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')), _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))));
+    ok = _mm_or_si128(ok, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')), _mm_cmpeq_epi8(v, _mm_set1_epi8('~'))));
+    return static_cast<unsigned int>(_mm_movemask_epi8(ok));
+}
+#endif
+
+static inline char *UrlEncodeByte(unsigned char c, char *out)
 {
-    std::stringstream dest;
     static const char *hex = "0123456789ABCDEF";
-    unsigned char c;
-
-    for (size_t i = 0; i < src.size(); i++) {
-        c = src[i];
-        if (isalnum(c) || (c == '-') || (c == '_') || (c == '.') || (c == '~')) {
-            dest << c;
-        } else if (c == ' ') {
-            dest << "%20";
-        } else {
-            dest << '%' << hex[c >> 4] << hex[c & 15];
+    if (UnreservedTable[c]) {
+        *out++ = static_cast<char>(c);
+    }
+    else {
+        *out++ = '%';
+        *out++ = hex[c >> 4];
+        *out++ = hex[c & 15];
+    }
+    return out;
+}
+
+void AlibabaCloud::OSS::UrlEncode(const char *src, size_t len, std::string &dest)
+{
+    auto in = reinterpret_cast<const unsigned char *>(src);
+
+    //size it first, escaped bytes take 3 chars
+    size_t size = len;
+    size_t i = 0;
+#if defined(ALIBABACLOUD_OSS_SSE2)
+    for (; i + 16 <= len; i += 16) {
+        size += 2 * (16 - __builtin_popcount(UnreservedMask(in + i)));
+    }
+#endif
+    for (; i < len; i++) {
+        size += UnreservedTable[in[i]] ? 0 : 2;
+    }
+
+    size_t pos = dest.size();
+    dest.resize(pos + size);
+    char *out = &dest[pos];
+    i = 0;
+#if defined(ALIBABACLOUD_OSS_SSE2)
+    //16 unreserved bytes are copied at once, a block with anything to escape goes byte by byte
+    for (; i + 16 <= len; i += 16) {
+        if (UnreservedMask(in + i) == 0xFFFF) {
+            std::memcpy(out, in + i, 16);
+            out += 16;
+            continue;
+        }
+        for (size_t j = i; j < i + 16; j++) {
+            out = UrlEncodeByte(in[j], out);
         }
     }
+#endif
+    for (; i < len; i++) {
+        out = UrlEncodeByte(in[i], out);
+    }
+}
 
-    return dest.str();
+std::string AlibabaCloud::OSS::UrlEncode(const std::string & src)
+{
+    std::string dest;
+    UrlEncode(src.data(), src.size(), dest);
+    return dest;
 }
 
 std::string AlibabaCloud::OSS::UrlDecode(const std::string & src)
 {
-    std::stringstream unescaped;
-    unescaped.fill('0');
-    unescaped << std::hex;
+    //the decoded string is never longer than the source
+    std::string dest(src.size(), '\0');
+    char *out = &dest[0];
+
+    //memchr is vectorized by the C library, so the plain runs are copied in bulk
+    const char *in = src.data();
+    const char *end = in + src.size();
+    while (in < end) {
+        auto percent = static_cast<const char *>(std::memchr(in, '%', end - in));
+        if (percent == nullptr) {
+            percent = end;
+        }
+        std::memcpy(out, in, percent - in);
+        out += percent - in;
+        in = percent;
+        if (in == end) {
+            break;
+        }
 
-    size_t safeLength = src.size();
-    const char *safe = src.c_str();
-    for (auto i = safe, n = safe + safeLength; i != n; ++i)
-    {
-        char c = *i;
-        if(c == '%')
-        {
-            char hex[3];
-            hex[0] = *(i + 1);
-            hex[1] = *(i + 2);
-            hex[2] = 0;
-            i += 2;
-            auto hexAsInteger = strtol(hex, nullptr, 16);
-            unescaped << (char)hexAsInteger;
+        //a '%' not followed by two hex digits is kept as is
+        unsigned char hi = end - in > 2 ? HexValueTable[static_cast<unsigned char>(in[1])] : 0xFF;
+        unsigned char lo = end - in > 2 ? HexValueTable[static_cast<unsigned char>(in[2])] : 0xFF;
+        if ((hi | lo) & 0xF0) {
+            *out++ = '%';
+            in += 1;
         }
-        else
-        {
-            unescaped << *i;
+        else {
+            *out++ = static_cast<char>((hi << 4) | lo);
+            in += 3;
         }
     }
+    dest.resize(out - dest.data());
 
-    return unescaped.str();
+    return dest;
+}
+
+static const char Base64Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char Base64UrlSafeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+#if defined(ALIBABACLOUD_OSS_SSE2) && !defined(_MSC_VER)
+#define ALIBABACLOUD_OSS_SSSE3
+//12 bytes in, 16 chars out per step, see http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+//the function is built for ssse3 and only called when the cpu has it
+__attribute__((target("ssse3")))
+static size_t Base64EncodeSsse3(const unsigned char *in, size_t len, char *out, bool urlSafe)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, (urlSafe ? '-' : '+') - 62, (urlSafe ? '_' : '/') - 63, 'A', 0, 0);
+    size_t i = 0;
+    //loads 16 bytes to use 12
+    for (; i + 16 <= len; i += 12) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), shuffle);
+        //split each 3 bytes into four 6 bits indices, one per byte
+        __m128i hi = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i lo = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(hi, lo);
+        //map each index range to the offset of its ascii range
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(shift, range), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chars);
+        out += 16;
+    }
+    return i;
+}
+
+static bool HasSsse3()
+{
+    static const bool has = __builtin_cpu_supports("ssse3") != 0;
+    return has;
+}
+#endif
+
+//appends the encoded bytes to dest, url safe has no padding
+static void Base64EncodeTo(const unsigned char *in, size_t len, bool urlSafe, std::string &dest)
+{
+    const char *table = urlSafe ? Base64UrlSafeTable : Base64Table;
+    size_t size = urlSafe ? (len * 4 + 2) / 3 : (len + 2) / 3 * 4;
+    size_t pos = dest.size();
+    dest.resize(pos + size);
+    char *out = &dest[pos];
+
+    size_t i = 0;
+#if defined(ALIBABACLOUD_OSS_SSSE3)
+    if (len >= 16 && HasSsse3()) {
+        i = Base64EncodeSsse3(in, len, out, urlSafe);
+        out += i / 3 * 4;
+    }
+#endif
+    for (; i + 3 <= len; i += 3) {
+        uint32_t v = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+        out[0] = table[v >> 18];
+        out[1] = table[(v >> 12) & 0x3F];
+        out[2] = table[(v >> 6) & 0x3F];
+        out[3] = table[v & 0x3F];
+        out += 4;
+    }
+    if (i < len) {
+        uint32_t v = uint32_t(in[i]) << 16;
+        if (i + 2 == len) {
+            v |= uint32_t(in[i + 1]) << 8;
+        }
+        *out++ = table[v >> 18];
+        *out++ = table[(v >> 12) & 0x3F];
+        if (i + 2 == len) {
+            *out++ = table[(v >> 6) & 0x3F];
+        }
+        else if (!urlSafe) {
+            *out++ = '=';
+        }
+        if (!urlSafe) {
+            *out++ = '=';
+        }
+    }
 }
 
 std::string AlibabaCloud::OSS::Base64Encode(const std::string &src)
@@ -93,61 +272,118 @@ std::string AlibabaCloud::OSS::Base64Encode(const std::string &src)
 
 std::string AlibabaCloud::OSS::Base64Encode(const char *src, int len)
 {
-    if (!src || len == 0) {
-        return "";
+    std::string dest;
+    if (!src || len <= 0) {
+        return dest;
     }
+    Base64EncodeTo(reinterpret_cast<const unsigned char *>(src), static_cast<size_t>(len), false, dest);
+    return dest;
+}
 
-    static const char *ENC = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+std::string AlibabaCloud::OSS::Base64EncodeUrlSafe(const std::string &src)
+{
+    return AlibabaCloud::OSS::Base64EncodeUrlSafe(src.c_str(), src.size());
+}
+
+std::string AlibabaCloud::OSS::Base64EncodeUrlSafe(const char *src, int len)
+{
+    std::string dest;
+    if (!src || len <= 0) {
+        return dest;
+    }
+    Base64EncodeTo(reinterpret_cast<const unsigned char *>(src), static_cast<size_t>(len), true, dest);
+    return dest;
+}
+
+//the value of each char of an alphabet, 0xFF if it is not in it
+struct Base64DecodeTable
+{
+    explicit Base64DecodeTable(const char *alphabet)
+    {
+        std::memset(value, 0xFF, sizeof(value));
+        for (unsigned char i = 0; i < 64; i++) {
+            value[static_cast<unsigned char>(alphabet[i])] = i;
+        }
+    }
+    unsigned char value[256];
+};
+
+static bool Base64DecodeTo(const char *src, size_t len, bool urlSafe, std::string &dest)
+{
+    static const Base64DecodeTable standardTable(Base64Table);
+    static const Base64DecodeTable urlSafeTable(Base64UrlSafeTable);
+    const unsigned char *table = urlSafe ? urlSafeTable.value : standardTable.value;
     auto in = reinterpret_cast<const unsigned char *>(src);
-    auto inLen = len;
-    std::stringstream ss;
-    while (inLen) {
-        // first 6 bits of char 1
-        ss << ENC[*in >> 2];
-        if (!--inLen) {
-            // last 2 bits of char 1, 4 bits of 0
-            ss << ENC[(*in & 0x3) << 4];
-            ss << '=';
-            ss << '=';
-            break;
+
+    //the standard form is padded to 4 chars, the url safe one may be
+    if (!urlSafe && len % 4 != 0) {
+        return false;
+    }
+    if (len % 4 == 0) {
+        for (int pad = 0; pad < 2 && len > 0 && in[len - 1] == '='; pad++) {
+            len--;
         }
-        // last 2 bits of char 1, first 4 bits of char 2
-        ss << ENC[((*in & 0x3) << 4) | (*(in + 1) >> 4)];
-        in++;
-        if (!--inLen) {
-            // last 4 bits of char 2, 2 bits of 0
-            ss << ENC[(*in & 0xF) << 2];
-            ss << '=';
-            break;
+    }
+    if (len % 4 == 1) {
+        return false;
+    }
+
+    size_t pos = dest.size();
+    dest.resize(pos + len / 4 * 3 + (len % 4 ? len % 4 - 1 : 0));
+    char *out = &dest[pos];
+
+    //invalid chars map to 0xFF, so they are checked once at the end
+    unsigned char bad = 0;
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        unsigned char a = table[in[i]], b = table[in[i + 1]], c = table[in[i + 2]], d = table[in[i + 3]];
+        bad |= a | b | c | d;
+        uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+        out[0] = static_cast<char>(v >> 16);
+        out[1] = static_cast<char>(v >> 8);
+        out[2] = static_cast<char>(v);
+        out += 3;
+    }
+    if (i < len) {
+        unsigned char a = table[in[i]], b = table[in[i + 1]];
+        unsigned char c = i + 3 == len ? table[in[i + 2]] : 0;
+        bad |= a | b | c;
+        uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6);
+        *out++ = static_cast<char>(v >> 16);
+        if (i + 3 == len) {
+            *out++ = static_cast<char>(v >> 8);
         }
-        // last 4 bits of char 2, first 2 bits of char 3
-        ss << ENC[((*in & 0xF) << 2) | (*(in + 1) >> 6)];
-        in++;
-        // last 6 bits of char 3
-        ss << ENC[*in & 0x3F];
-        in++, inLen--;
     }
-    return ss.str();
+
+    if (bad & 0xC0) {
+        dest.resize(pos);
+        return false;
+    }
+    return true;
 }
 
-std::string AlibabaCloud::OSS::Base64EncodeUrlSafe(const std::string &src)
+bool AlibabaCloud::OSS::Base64Decode(const char *src, size_t len, std::string &dest)
 {
-    return AlibabaCloud::OSS::Base64EncodeUrlSafe(src.c_str(), src.size());
+    return Base64DecodeTo(src, len, false, dest);
 }
 
-std::string AlibabaCloud::OSS::Base64EncodeUrlSafe(const char *src, int len)
+bool AlibabaCloud::OSS::Base64DecodeUrlSafe(const char *src, size_t len, std::string &dest)
 {
-    std::string out = AlibabaCloud::OSS::Base64Encode(src, len);
+    return Base64DecodeTo(src, len, true, dest);
+}
 
-    while (out.size() > 0 && *out.rbegin() == '=')
-        out.pop_back();
+std::string AlibabaCloud::OSS::Base64Decode(const std::string &src)
+{
+    std::string dest;
+    Base64DecodeTo(src.data(), src.size(), false, dest);
+    return dest;
+}
 
-    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { 
-        if (c == '+') return '-';
-        if (c == '/') return '_';
-        return (char)c;
-    });
-    return out;
+std::string AlibabaCloud::OSS::Base64DecodeUrlSafe(const std::string &src)
+{
+    std::string dest;
+    Base64DecodeTo(src.data(), src.size(), true, dest);
+    return dest;
 }
 
 std::string AlibabaCloud::OSS::ComputeContentMD5(const char * data, size_t size)
@@ -159,9 +395,7 @@ std::string AlibabaCloud::OSS::ComputeContentMD5(const char * data, size_t size)
     unsigned char md[MD5_DIGEST_LENGTH];
     MD5(reinterpret_cast<const unsigned char*>(data), size, (unsigned char*)&md);
      
-    char encodedData[100];
-    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encodedData), md, MD5_DIGEST_LENGTH);
-    return encodedData;
+    return Base64Encode(reinterpret_cast<const char*>(md), MD5_DIGEST_LENGTH);
 }
 
 std::string AlibabaCloud::OSS::ComputeContentMD5(std::istream& stream) 
@@ -201,9 +435,7 @@ std::string AlibabaCloud::OSS::ComputeContentMD5(std::istream& stream)
     stream.seekg(currentPos, stream.beg);
 
     //Based64
-    char encodedData[100];
-    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encodedData), md_value, md_len);
-    return encodedData;
+    return Base64Encode(reinterpret_cast<const char*>(md_value), static_cast<int>(md_len));
 }
 static std::string HexToString(const unsigned char *data, size_t size)
 { 
@@ -377,6 +609,33 @@ std::string AlibabaCloud::OSS::ToGmtTime(std::time_t &t)
     return date.str();    
 }
 
+//formatted at most once a second per thread, without the locale
+const std::string &AlibabaCloud::OSS::CurrentGmtTime()
+{
+    static const char *weekdays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char *months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    static thread_local std::time_t cachedTime = -1;
+    static thread_local std::string cachedDate;
+
+    std::time_t t = std::time(nullptr);
+    if (t != cachedTime) {
+        std::tm tm;
+#ifdef _WIN32
+        ::gmtime_s(&tm, &t);
+#else
+        ::gmtime_r(&t, &tm);
+#endif
+        char buff[32];
+        int len = snprintf(buff, sizeof(buff), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+            weekdays[tm.tm_wday % 7], tm.tm_mday, months[tm.tm_mon % 12], tm.tm_year + 1900,
+            tm.tm_hour, tm.tm_min, tm.tm_sec);
+        cachedDate.assign(buff, len > 0 ? static_cast<size_t>(len) : 0);
+        cachedTime = t;
+    }
+    return cachedDate;
+}
+
 std::string AlibabaCloud::OSS::ToUtcTime(std::time_t &t)
 {
     std::stringstream date;
@@ -396,6 +655,27 @@ std::string AlibabaCloud::OSS::ToUtcTime(std::time_t &t)
     return date.str();
 }
 
+//"2017-11-01T05:20:01Z" or "2017-11-01T05:20:01.000Z", -1 if malformed
+std::time_t AlibabaCloud::OSS::UtcToUnixTime(const std::string &t)
+{
+    std::tm tm;
+    std::memset(&tm, 0, sizeof(tm));
+    if (sscanf(t.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+        &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        return -1;
+    }
+    if (t.back() != 'Z') {
+        return -1;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+#ifdef _WIN32
+    return _mkgmtime(&tm);
+#else
+    return timegm(&tm);
+#endif
+}
+
 bool AlibabaCloud::OSS::IsValidBucketName(const std::string &bucketName)
 {
 #if defined(__GNUG__) && __GNUC__ < 5
@@ -448,151 +728,188 @@ bool AlibabaCloud::OSS::IsValidBucketName(const std::string &bucketName)
 #endif
  }
 
-const std::string& AlibabaCloud::OSS::LookupMimeType(const std::string &name)
-{
-    const static std::map<std::string, std::string> mimeType = {
-        {"html", "text/html"},
-        {"htm", "text/html"},
-        {"shtml", "text/html"},
-        {"css", "text/css"},
-        {"xml", "text/xml"},
-        {"gif", "image/gif"},
-        {"jpeg", "image/jpeg"},
-        {"jpg", "image/jpeg"},
-        {"js", "application/x-javascript"},
-        {"atom", "application/atom+xml"},
-        {"rss", "application/rss+xml"},
-        {"mml", "text/mathml"},
-        {"txt", "text/plain"},
-        {"jad", "text/vnd.sun.j2me.app-descriptor"},
-        {"wml", "text/vnd.wap.wml"},
-        {"htc", "text/x-component"},
-        {"png", "image/png"},
-        {"tif", "image/tiff"},
-        {"tiff", "image/tiff"},
-        {"wbmp", "image/vnd.wap.wbmp"},
-        {"ico", "image/x-icon"},
-        {"jng", "image/x-jng"},
-        {"bmp", "image/x-ms-bmp"},
-        {"svg", "image/svg+xml"},
-        {"svgz", "image/svg+xml"},
-        {"webp", "image/webp"},
-        {"jar", "application/java-archive"},
-        {"war", "application/java-archive"},
-        {"ear", "application/java-archive"},
-        {"hqx", "application/mac-binhex40"},
-        {"doc ", "application/msword"},
-        {"pdf", "application/pdf"},
-        {"ps", "application/postscript"},
-        {"eps", "application/postscript"},
-        {"ai", "application/postscript"},
-        {"rtf", "application/rtf"},
-        {"xls", "application/vnd.ms-excel"},
-        {"ppt", "application/vnd.ms-powerpoint"},
-        {"wmlc", "application/vnd.wap.wmlc"},
-        {"kml", "application/vnd.google-earth.kml+xml"},
-        {"kmz", "application/vnd.google-earth.kmz"},
-        {"7z", "application/x-7z-compressed"},
-        {"cco", "application/x-cocoa"},
-        {"jardiff", "application/x-java-archive-diff"},
-        {"jnlp", "application/x-java-jnlp-file"},
-        {"run", "application/x-makeself"},
-        {"pl", "application/x-perl"},
-        {"pm", "application/x-perl"},
-        {"prc", "application/x-pilot"},
-        {"pdb", "application/x-pilot"},
-        {"rar", "application/x-rar-compressed"},
-        {"rpm", "application/x-redhat-package-manager"},
-        {"sea", "application/x-sea"},
-        {"swf", "application/x-shockwave-flash"},
-        {"sit", "application/x-stuffit"},
-        {"tcl", "application/x-tcl"},
-        {"tk", "application/x-tcl"},
-        {"der", "application/x-x509-ca-cert"},
-        {"pem", "application/x-x509-ca-cert"},
-        {"crt", "application/x-x509-ca-cert"},
-        {"xpi", "application/x-xpinstall"},
-        {"xhtml", "application/xhtml+xml"},
-        {"zip", "application/zip"},
-        {"wgz", "application/x-nokia-widget"},
-        {"bin", "application/octet-stream"},
-        {"exe", "application/octet-stream"},
-        {"dll", "application/octet-stream"},
-        {"deb", "application/octet-stream"},
-        {"dmg", "application/octet-stream"},
-        {"eot", "application/octet-stream"},
-        {"iso", "application/octet-stream"},
-        {"img", "application/octet-stream"},
-        {"msi", "application/octet-stream"},
-        {"msp", "application/octet-stream"},
-        {"msm", "application/octet-stream"},
-        {"mid", "audio/midi"},
-        {"midi", "audio/midi"},
-        {"kar", "audio/midi"},
-        {"mp3", "audio/mpeg"},
-        {"ogg", "audio/ogg"},
-        {"m4a", "audio/x-m4a"},
-        {"ra", "audio/x-realaudio"},
-        {"3gpp", "video/3gpp"},
-        {"3gp", "video/3gpp"},
-        {"mp4", "video/mp4"},
-        {"mpeg", "video/mpeg"},
-        {"mpg", "video/mpeg"},
-        {"mov", "video/quicktime"},
-        {"webm", "video/webm"},
-        {"flv", "video/x-flv"},
-        {"m4v", "video/x-m4v"},
-        {"mng", "video/x-mng"},
-        {"asx", "video/x-ms-asf"},
-        {"asf", "video/x-ms-asf"},
-        {"wmv", "video/x-ms-wmv"},
-        {"avi", "video/x-msvideo"},
-        {"ts", "video/MP2T"},
-        {"m3u8", "application/x-mpegURL"},
-        {"apk", "application/vnd.android.package-archive"}
-        };
-
-    const static std::string defaultType("application/octet-stream");
-    std::string::size_type last_pos  = name.find_last_of('.');
-    std::string::size_type first_pos = name.find_first_of('.');
-    std::string prefix, ext, ext2;
+struct MimeEntry
+{
+    const char *ext;
+    const char *type;
+};
 
-    if (last_pos == std::string::npos) {
-        return defaultType;
-    }
+//lower case extensions sorted by strcmp, constant initialized so there is nothing to build at run time
+static constexpr MimeEntry MimeTable[] =
+{
+    {"3gp", "video/3gpp"},
+    {"3gpp", "video/3gpp"},
+    {"7z", "application/x-7z-compressed"},
+    {"ai", "application/postscript"},
+    {"apk", "application/vnd.android.package-archive"},
+    {"asf", "video/x-ms-asf"},
+    {"asx", "video/x-ms-asf"},
+    {"atom", "application/atom+xml"},
+    {"avi", "video/x-msvideo"},
+    {"bin", "application/octet-stream"},
+    {"bmp", "image/x-ms-bmp"},
+    {"cco", "application/x-cocoa"},
+    {"crt", "application/x-x509-ca-cert"},
+    {"css", "text/css"},
+    {"deb", "application/octet-stream"},
+    {"der", "application/x-x509-ca-cert"},
+    {"dll", "application/octet-stream"},
+    {"dmg", "application/octet-stream"},
+    {"doc", "application/msword"},
+    {"ear", "application/java-archive"},
+    {"eot", "application/octet-stream"},
+    {"eps", "application/postscript"},
+    {"exe", "application/octet-stream"},
+    {"flv", "video/x-flv"},
+    {"gif", "image/gif"},
+    {"hqx", "application/mac-binhex40"},
+    {"htc", "text/x-component"},
+    {"htm", "text/html"},
+    {"html", "text/html"},
+    {"ico", "image/x-icon"},
+    {"img", "application/octet-stream"},
+    {"iso", "application/octet-stream"},
+    {"jad", "text/vnd.sun.j2me.app-descriptor"},
+    {"jar", "application/java-archive"},
+    {"jardiff", "application/x-java-archive-diff"},
+    {"jng", "image/x-jng"},
+    {"jnlp", "application/x-java-jnlp-file"},
+    {"jpeg", "image/jpeg"},
+    {"jpg", "image/jpeg"},
+    {"js", "application/x-javascript"},
+    {"kar", "audio/midi"},
+    {"kml", "application/vnd.google-earth.kml+xml"},
+    {"kmz", "application/vnd.google-earth.kmz"},
+    {"m3u8", "application/x-mpegURL"},
+    {"m4a", "audio/x-m4a"},
+    {"m4v", "video/x-m4v"},
+    {"mid", "audio/midi"},
+    {"midi", "audio/midi"},
+    {"mml", "text/mathml"},
+    {"mng", "video/x-mng"},
+    {"mov", "video/quicktime"},
+    {"mp3", "audio/mpeg"},
+    {"mp4", "video/mp4"},
+    {"mpeg", "video/mpeg"},
+    {"mpg", "video/mpeg"},
+    {"msi", "application/octet-stream"},
+    {"msm", "application/octet-stream"},
+    {"msp", "application/octet-stream"},
+    {"ogg", "audio/ogg"},
+    {"pdb", "application/x-pilot"},
+    {"pdf", "application/pdf"},
+    {"pem", "application/x-x509-ca-cert"},
+    {"pl", "application/x-perl"},
+    {"pm", "application/x-perl"},
+    {"png", "image/png"},
+    {"ppt", "application/vnd.ms-powerpoint"},
+    {"prc", "application/x-pilot"},
+    {"ps", "application/postscript"},
+    {"ra", "audio/x-realaudio"},
+    {"rar", "application/x-rar-compressed"},
+    {"rpm", "application/x-redhat-package-manager"},
+    {"rss", "application/rss+xml"},
+    {"rtf", "application/rtf"},
+    {"run", "application/x-makeself"},
+    {"sea", "application/x-sea"},
+    {"shtml", "text/html"},
+    {"sit", "application/x-stuffit"},
+    {"svg", "image/svg+xml"},
+    {"svgz", "image/svg+xml"},
+    {"swf", "application/x-shockwave-flash"},
+    {"tcl", "application/x-tcl"},
+    {"tif", "image/tiff"},
+    {"tiff", "image/tiff"},
+    {"tk", "application/x-tcl"},
+    {"ts", "video/MP2T"},
+    {"txt", "text/plain"},
+    {"war", "application/java-archive"},
+    {"wbmp", "image/vnd.wap.wbmp"},
+    {"webm", "video/webm"},
+    {"webp", "image/webp"},
+    {"wgz", "application/x-nokia-widget"},
+    {"wml", "text/vnd.wap.wml"},
+    {"wmlc", "application/vnd.wap.wmlc"},
+    {"wmv", "video/x-ms-wmv"},
+    {"xhtml", "application/xhtml+xml"},
+    {"xls", "application/vnd.ms-excel"},
+    {"xml", "text/xml"},
+    {"xpi", "application/x-xpinstall"},
+    {"zip", "application/zip"},
+};
+static constexpr size_t MimeTableSize = sizeof(MimeTable) / sizeof(MimeTable[0]);
+
+static constexpr bool StrLess(const char *lhs, const char *rhs)
+{
+    return *lhs != *rhs ? static_cast<unsigned char>(*lhs) < static_cast<unsigned char>(*rhs) :
+        (*lhs != '\0' && StrLess(lhs + 1, rhs + 1));
+}
 
-    // extract the last extension
-    if (last_pos != std::string::npos) {
-        ext = name.substr(1 + last_pos, std::string::npos);
-    }
-    if (last_pos != std::string::npos) {
-        if (first_pos != std::string::npos && first_pos < last_pos) {
-            prefix = name.substr(0, last_pos);
-            // Now get the second to last file extension
-            std::string::size_type next_pos = prefix.find_last_of('.');
-            if (next_pos != std::string::npos) {
-                ext2 = prefix.substr(1 + next_pos, std::string::npos);
-            }
+static constexpr bool IsMimeTableSorted(size_t i)
+{
+    return i + 1 >= MimeTableSize || (StrLess(MimeTable[i].ext, MimeTable[i + 1].ext) && IsMimeTableSorted(i + 1));
+}
+static_assert(IsMimeTableSorted(0), "MimeTable must be sorted and have no duplicates");
+
+//compares ext[0, len), lower cased on the fly, with a table entry
+static int CompareExtension(const char *ext, size_t len, const char *entry)
+{
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = static_cast<unsigned char>(ext[i]);
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<unsigned char>(c + ('a' - 'A'));
+        }
+        unsigned char e = static_cast<unsigned char>(entry[i]);
+        if (c != e) {
+            return e == '\0' || c > e ? 1 : -1;
         }
     }
+    return entry[len] == '\0' ? 0 : -1;
+}
 
-    ext = ToLower(ext.c_str());
-    auto iter = mimeType.find(ext);
-    if (iter != mimeType.end()) {
-        return (*iter).second; 
+static const char *FindMimeType(const char *ext, size_t len)
+{
+    size_t lo = 0, hi = MimeTableSize;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = CompareExtension(ext, len, MimeTable[mid].ext);
+        if (cmp == 0) {
+            return MimeTable[mid].type;
+        }
+        if (cmp < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
     }
+    return nullptr;
+}
 
-    if (first_pos == last_pos) {
+const char *AlibabaCloud::OSS::LookupMimeType(const std::string &name)
+{
+    static const char *defaultType = "application/octet-stream";
+    std::string::size_type last_pos = name.find_last_of('.');
+    if (last_pos == std::string::npos) {
         return defaultType;
     }
 
-    ext2 = ToLower(ext2.c_str());
-    iter = mimeType.find(ext2);
-    if (iter != mimeType.end()) {
-        return (*iter).second;
+    // the last extension
+    const char *type = FindMimeType(name.data() + last_pos + 1, name.size() - last_pos - 1);
+    if (type != nullptr) {
+        return type;
     }
 
-    return defaultType;
+    // then the second to last one
+    if (last_pos == 0) {
+        return defaultType;
+    }
+    std::string::size_type next_pos = name.find_last_of('.', last_pos - 1);
+    if (next_pos == std::string::npos) {
+        return defaultType;
+    }
+    type = FindMimeType(name.data() + next_pos + 1, last_pos - next_pos - 1);
+    return type != nullptr ? type : defaultType;
 }
 
 std::string AlibabaCloud::OSS::CombineHostString(
@@ -627,23 +944,74 @@ std::string AlibabaCloud::OSS::CombinePathString(
     if (IsIp(url.host())) {
         path.append(bucket).append("/");
     }
-    path.append(UrlEncode(key));
+    UrlEncode(key.data(), key.size(), path);
     return path;
 }
 
 std::string AlibabaCloud::OSS::CombineQueryString(const ParameterCollection &parameters)
 {
-    std::stringstream ss;
-    if (!parameters.empty()) {
-        for (const auto &p : parameters)
-        {
-            if (p.second.empty())
-                ss << "&" << UrlEncode(p.first);
-            else
-                ss << "&" << UrlEncode(p.first) << "=" << UrlEncode(p.second);
+    std::string query;
+    bool first = true;
+    for (const auto &p : parameters)
+    {
+        if (!first)
+            query.push_back('&');
+        first = false;
+        UrlEncode(p.first.data(), p.first.size(), query);
+        if (!p.second.empty()) {
+            query.push_back('=');
+            UrlEncode(p.second.data(), p.second.size(), query);
+        }
+    }
+    return query;
+}
+
+std::string AlibabaCloud::OSS::MaskUrlCredentials(const std::string &url)
+{
+    static const char *names[] = {
+        "signature", "ossaccesskeyid", "security-token",
+        "x-oss-signature", "x-oss-credential", "x-oss-security-token"
+    };
+    std::string masked;
+    size_t pos = url.find('?');
+    if (pos == std::string::npos) {
+        return url;
+    }
+    //the query ends at the fragment, or at the protocol of a request line
+    size_t end = url.find_first_of(" #", pos);
+    if (end == std::string::npos) {
+        end = url.size();
+    }
+    masked.reserve(url.size());
+    masked.append(url, 0, pos + 1);
+    size_t begin = pos + 1;
+    while (begin < end) {
+        size_t amp = url.find('&', begin);
+        size_t next = (amp == std::string::npos || amp > end) ? end : amp;
+        size_t eq = url.find('=', begin);
+        bool secret = false;
+        if (eq != std::string::npos && eq < next) {
+            for (auto name : names) {
+                size_t len = strlen(name);
+                if (eq - begin == len && ToLower(url.substr(begin, len).c_str()) == name) {
+                    secret = true;
+                    break;
+                }
+            }
+        }
+        if (secret) {
+            masked.append(url, begin, eq + 1 - begin).append("***");
+        }
+        else {
+            masked.append(url, begin, next - begin);
+        }
+        if (next < end) {
+            masked.push_back('&');
         }
+        begin = next + 1;
     }
-    return ss.str().substr(1);
+    masked.append(url, end, std::string::npos);
+    return masked;
 }
 
 std::streampos AlibabaCloud::OSS::GetIOStreamLength(std::iostream &stream)
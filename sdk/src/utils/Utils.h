@@ -35,12 +35,20 @@ namespace OSS
 
     std::string GenerateUuid();
     std::string UrlEncode(const std::string &src);
+    //appends the encoded bytes to dest
+    void UrlEncode(const char *src, size_t len, std::string &dest);
     std::string UrlDecode(const std::string &src);
 
     std::string Base64Encode(const std::string &src);
     std::string Base64Encode(const char *src, int len);
     std::string Base64EncodeUrlSafe(const std::string &src);
     std::string Base64EncodeUrlSafe(const char *src, int len);
+    //empty if src is not valid base64
+    std::string Base64Decode(const std::string &src);
+    std::string Base64DecodeUrlSafe(const std::string &src);
+    //appends the decoded bytes to dest, false if src is not valid base64
+    bool Base64Decode(const char *src, size_t len, std::string &dest);
+    bool Base64DecodeUrlSafe(const char *src, size_t len, std::string &dest);
 
 
     void StringReplace(std::string &src, const std::string &s1, const std::string &s2);
@@ -53,7 +61,9 @@ namespace OSS
     std::string ToLower(const char* source);
     std::string ToUpper(const char* source);
     std::string ToGmtTime(std::time_t &t);
+    const std::string &CurrentGmtTime();
     std::string ToUtcTime(std::time_t &t);
+    std::time_t UtcToUnixTime(const std::string &t);
 
     bool IsIp(const std::string &host);
     bool IsValidBucketName(const std::string &bucketName);
@@ -61,10 +71,12 @@ namespace OSS
     bool IsValidLoggingPrefix(const std::string &prefix);
 
 
-    const std::string &LookupMimeType(const std::string& name);
+    const char *LookupMimeType(const std::string& name);
     std::string CombineHostString(const std::string &endpoint, const std::string &bucket, bool isCname);
     std::string CombinePathString(const std::string &endpoint, const std::string &bucket, const std::string &key);
     std::string CombineQueryString(const ParameterCollection &parameters);
+    //the url, or a request line, with the values of the signing query parameters replaced by ***
+    std::string MaskUrlCredentials(const std::string &url);
 
     std::streampos GetIOStreamLength(std::iostream &stream);
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/auth/CachingCredentialsProvider.h>
+#include <src/utils/Utils.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#ifndef _WIN32
+#include "../LocalServer.h"
+#endif
+
+namespace AlibabaCloud {
+namespace OSS {
+
+TEST(CachingCredentialsProviderTest, InitialFetchTest)
+{
+    std::atomic<int> fetches(0);
+    CachingCredentialsProvider provider([&](Credentials &credentials, std::time_t &expiration) {
+        fetches++;
+        credentials = Credentials("ak-1", "sk-1", "token-1");
+        expiration = std::time(nullptr) + 3600;
+        return true;
+    });
+
+    EXPECT_EQ(fetches.load(), 1);
+    auto snapshot = provider.getCredentialsSnapshot();
+    EXPECT_EQ(snapshot->AccessKeyId(), "ak-1");
+    EXPECT_EQ(snapshot->SessionToken(), "token-1");
+    EXPECT_EQ(provider.getCredentialsSnapshot(), snapshot);
+    EXPECT_EQ(provider.getCredentials().AccessKeySecret(), "sk-1");
+    EXPECT_EQ(fetches.load(), 1);
+}
+
+TEST(CachingCredentialsProviderTest, RefreshBeforeExpiryTest)
+{
+    std::atomic<int> fetches(0);
+    //expires in 2s, refreshed 1s ahead
+    CachingCredentialsProvider provider([&](Credentials &credentials, std::time_t &expiration) {
+        int n = ++fetches;
+        credentials = Credentials("ak-" + std::to_string(n), "sk", "");
+        expiration = std::time(nullptr) + (n == 1 ? 2 : 3600);
+        return true;
+    }, 1, 0, 1);
+
+    EXPECT_EQ(provider.getCredentials().AccessKeyId(), "ak-1");
+    for (int i = 0; i < 50 && fetches.load() < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(fetches.load(), 2);
+    EXPECT_EQ(provider.getCredentials().AccessKeyId(), "ak-2");
+}
+
+TEST(CachingCredentialsProviderTest, FailedRefreshKeepsCredentialsTest)
+{
+    std::atomic<int> fetches(0);
+    CachingCredentialsProvider provider([&](Credentials &credentials, std::time_t &expiration) {
+        int n = ++fetches;
+        if (n > 1 && n < 3) {
+            return false;
+        }
+        credentials = Credentials("ak-" + std::to_string(n), "sk", "");
+        expiration = std::time(nullptr) + (n == 1 ? 1 : 3600);
+        return true;
+    }, 1, 0, 1);
+
+    EXPECT_EQ(provider.getCredentials().AccessKeyId(), "ak-1");
+    for (int i = 0; i < 50 && fetches.load() < 3; i++) {
+        EXPECT_NE(provider.getCredentials().AccessKeyId(), "");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(fetches.load(), 3);
+    EXPECT_EQ(provider.getCredentials().AccessKeyId(), "ak-3");
+}
+
+TEST(CachingCredentialsProviderTest, UtcToUnixTimeTest)
+{
+    EXPECT_EQ(UtcToUnixTime("1970-01-01T00:00:00Z"), 0);
+    EXPECT_EQ(UtcToUnixTime("2017-11-01T05:20:01Z"), 1509513601);
+    EXPECT_EQ(UtcToUnixTime("2017-11-01T05:20:01.000Z"), 1509513601);
+    EXPECT_EQ(UtcToUnixTime("2017-11-01 05:20:01"), -1);
+    EXPECT_EQ(UtcToUnixTime(""), -1);
+}
+
+#ifndef _WIN32
+TEST(CachingCredentialsProviderTest, MetadataUrlTest)
+{
+    std::atomic<int> status(200);
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        EXPECT_EQ(req.path, "/latest/meta-data/ram/security-credentials/role");
+        resp.status = status.load();
+        std::time_t t = std::time(nullptr) + 3600;
+        resp.body = "{\"Code\":\"Success\",\"AccessKeyId\":\"STS.ak\",\"AccessKeySecret\":\"sk\","
+            "\"SecurityToken\":\"token\",\"Expiration\":\"" + ToUtcTime(t) + "\"}";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto fetcher = CachingCredentialsProvider::MetadataUrlFetcher(server.Endpoint() + "/latest/meta-data/ram/security-credentials/role");
+    Credentials credentials("", "");
+    std::time_t expiration = 0;
+    ASSERT_TRUE(fetcher(credentials, expiration));
+    EXPECT_EQ(credentials.AccessKeyId(), "STS.ak");
+    EXPECT_EQ(credentials.AccessKeySecret(), "sk");
+    EXPECT_EQ(credentials.SessionToken(), "token");
+    EXPECT_GT(expiration, std::time(nullptr) + 3500);
+
+    status = 404;
+    EXPECT_FALSE(fetcher(credentials, expiration));
+}
+
+TEST(CachingCredentialsProviderTest, ClientUsesSnapshotTest)
+{
+    std::string token;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        auto it = req.headers.find("x-oss-security-token");
+        token = it == req.headers.end() ? "" : it->second;
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto provider = std::make_shared<CachingCredentialsProvider>([](Credentials &credentials, std::time_t &expiration) {
+        credentials = Credentials("ak", "sk", "token-1");
+        expiration = std::time(nullptr) + 3600;
+        return true;
+    });
+    ClientConfiguration conf;
+    OssClient client(server.Endpoint(), provider, conf);
+    EXPECT_TRUE(client.HeadObject("bucket", "key").isSuccess());
+    EXPECT_EQ(token, "token-1");
+}
+#endif
+
+}
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <alibabacloud/oss/OssAwaitable.h>
+
+#if !defined(_WIN32) && defined(__cpp_impl_coroutine)
+#include <gtest/gtest.h>
+#include "../LocalServer.h"
+#include <future>
+#include <deque>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+//a fire-and-forget coroutine, enough to drive the awaitables in the tests
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static Detached HeadThenDelete(const OssClient &client, std::promise<std::pair<int64_t, bool>> &done)
+{
+    auto head = co_await Await(client, &OssClient::HeadObjectAsync, HeadObjectRequest("bucket", "key"));
+    auto del = co_await Await(client, &OssClient::DeleteObjectAsync, DeleteObjectRequest("bucket", "key"));
+    done.set_value(std::make_pair(head.isSuccess() ? head.result().ContentLength() : -1, del.isSuccess()));
+}
+
+static Detached HeadOn(const OssClient &client, const OssAwaitable<HeadObjectRequest, ObjectMetaDataOutcome>::Scheduler &scheduler,
+    std::promise<std::thread::id> &done)
+{
+    co_await Await(client, &OssClient::HeadObjectAsync, HeadObjectRequest("bucket", "key"), scheduler);
+    done.set_value(std::this_thread::get_id());
+}
+
+static Detached HeadCancellable(const OssClient &client, const std::shared_ptr<CancellationToken> &token,
+    std::promise<std::string> &done)
+{
+    auto head = co_await Await(client, &OssClient::HeadObjectAsync, HeadObjectRequest("bucket", "key"), token);
+    done.set_value(head.isSuccess() ? std::string() : head.error().Code());
+}
+
+static LocalServer::Handler Handler()
+{
+    return [](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (req.method == "DELETE") {
+            resp.status = 204;
+            return;
+        }
+        resp.headers["Content-Length"] = "42";
+        resp.headers["ETag"] = "\"etag-1\"";
+    };
+}
+
+TEST(AwaitableTest, SequentialAwaitTest)
+{
+    LocalServer server(Handler());
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    std::promise<std::pair<int64_t, bool>> done;
+    auto future = done.get_future();
+    HeadThenDelete(client, done);
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    auto result = future.get();
+    EXPECT_EQ(result.first, 42);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(server.RequestCount(), 2);
+}
+
+TEST(AwaitableTest, SchedulerResumeTest)
+{
+    LocalServer server(Handler());
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    //a single threaded event loop
+    std::mutex lock;
+    std::condition_variable cv;
+    std::deque<std::coroutine_handle<>> queue;
+    auto scheduler = [&](std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> locker(lock);
+        queue.push_back(handle);
+        cv.notify_one();
+    };
+
+    std::promise<std::thread::id> done;
+    auto future = done.get_future();
+    HeadOn(client, scheduler, done);
+
+    std::unique_lock<std::mutex> locker(lock);
+    ASSERT_TRUE(cv.wait_for(locker, std::chrono::seconds(10), [&]() { return !queue.empty(); }));
+    auto handle = queue.front();
+    queue.pop_front();
+    locker.unlock();
+    handle.resume();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(future.get(), std::this_thread::get_id());
+}
+
+TEST(AwaitableTest, CancelTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.delayMs = 5000;
+    });
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    auto token = std::make_shared<CancellationToken>();
+    std::promise<std::string> done;
+    auto future = done.get_future();
+    auto start = std::chrono::steady_clock::now();
+    HeadCancellable(client, token, done);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    token->cancel();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(3)), std::future_status::ready);
+    EXPECT_EQ(future.get(), "ClientError:100004");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(3));
+}
+
+}
+}
+#endif
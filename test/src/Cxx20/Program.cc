@@ -0,0 +1,31 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <alibabacloud/oss/OssClient.h>
+#include <gtest/gtest.h>
+#include <iostream>
+
+//the C++20 only tests, they all run offline
+int main(int argc, char **argv)
+{
+    std::cout << "oss-cpp-sdk C++20 test" << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    AlibabaCloud::OSS::InitializeSdk();
+    int ret = RUN_ALL_TESTS();
+    AlibabaCloud::OSS::ShutdownSdk();
+    return ret;
+}
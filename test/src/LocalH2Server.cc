@@ -0,0 +1,375 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include "LocalH2Server.h"
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <openssl/evp.h>
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace AlibabaCloud::OSS;
+
+namespace
+{
+    const uint8_t FRAME_DATA = 0x0;
+    const uint8_t FRAME_HEADERS = 0x1;
+    const uint8_t FRAME_SETTINGS = 0x4;
+    const uint8_t FRAME_PING = 0x6;
+    const uint8_t FRAME_GOAWAY = 0x7;
+    const uint8_t FRAME_WINDOW_UPDATE = 0x8;
+    const uint8_t FRAME_CONTINUATION = 0x9;
+    const uint8_t FLAG_END_STREAM = 0x1;
+    const uint8_t FLAG_ACK = 0x1;
+    const uint8_t FLAG_END_HEADERS = 0x4;
+
+    const char PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+    const size_t PREFACE_SIZE = sizeof(PREFACE) - 1;
+
+    int SelectH2(SSL *, const unsigned char **out, unsigned char *outlen,
+        const unsigned char *in, unsigned int inlen, void *)
+    {
+        static const unsigned char protos[] = { 2, 'h', '2' };
+        unsigned char *selected = nullptr;
+        if (SSL_select_next_proto(&selected, outlen, protos, sizeof(protos), in, inlen) != OPENSSL_NPN_NEGOTIATED) {
+            return SSL_TLSEXT_ERR_NOACK;
+        }
+        *out = selected;
+        return SSL_TLSEXT_ERR_OK;
+    }
+
+    //an EC key and a certificate for 127.0.0.1 signed by itself
+    bool UseSelfSignedCert(SSL_CTX *ctx)
+    {
+        EVP_PKEY *pkey = nullptr;
+        EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        bool ok = kctx != nullptr &&
+            EVP_PKEY_keygen_init(kctx) > 0 &&
+            EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) > 0 &&
+            EVP_PKEY_keygen(kctx, &pkey) > 0;
+        EVP_PKEY_CTX_free(kctx);
+
+        X509 *cert = ok ? X509_new() : nullptr;
+        if (cert != nullptr) {
+            X509_set_version(cert, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+            X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+            X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+            X509_set_pubkey(cert, pkey);
+            X509_NAME *name = X509_get_subject_name(cert);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("127.0.0.1"), -1, -1, 0);
+            X509_set_issuer_name(cert, name);
+            ok = X509_sign(cert, pkey, EVP_sha256()) > 0 &&
+                SSL_CTX_use_certificate(ctx, cert) == 1 &&
+                SSL_CTX_use_PrivateKey(ctx, pkey) == 1;
+        }
+        X509_free(cert);
+        EVP_PKEY_free(pkey);
+        return ok;
+    }
+
+    std::string Frame(uint8_t type, uint8_t flags, unsigned streamId, const std::string &payload)
+    {
+        std::string frame(9, '\0');
+        frame[0] = static_cast<char>((payload.size() >> 16) & 0xff);
+        frame[1] = static_cast<char>((payload.size() >> 8) & 0xff);
+        frame[2] = static_cast<char>(payload.size() & 0xff);
+        frame[3] = static_cast<char>(type);
+        frame[4] = static_cast<char>(flags);
+        frame[5] = static_cast<char>((streamId >> 24) & 0x7f);
+        frame[6] = static_cast<char>((streamId >> 16) & 0xff);
+        frame[7] = static_cast<char>((streamId >> 8) & 0xff);
+        frame[8] = static_cast<char>(streamId & 0xff);
+        return frame.append(payload);
+    }
+
+    //literal header field without indexing, the name and value not huffman coded
+    void AppendLiteral(std::string &block, const std::string &name, const std::string &value)
+    {
+        block.push_back('\0');
+        block.push_back(static_cast<char>(name.size()));
+        block.append(name);
+        block.push_back(static_cast<char>(value.size()));
+        block.append(value);
+    }
+
+    std::string WindowIncrement(unsigned increment)
+    {
+        std::string payload(4, '\0');
+        payload[0] = static_cast<char>((increment >> 24) & 0x7f);
+        payload[1] = static_cast<char>((increment >> 16) & 0xff);
+        payload[2] = static_cast<char>((increment >> 8) & 0xff);
+        payload[3] = static_cast<char>(increment & 0xff);
+        return payload;
+    }
+}
+
+LocalH2Server::LocalH2Server(const std::string &body, long delayMs) :
+    body_(body),
+    delayMs_(delayMs),
+    ctx_(nullptr),
+    listenFd_(-1),
+    port_(0),
+    stopped_(true),
+    connectionCount_(0),
+    streamCount_(0),
+    concurrentStreams_(0),
+    maxConcurrentStreams_(0)
+{
+}
+
+LocalH2Server::~LocalH2Server()
+{
+    Stop();
+    SSL_CTX_free(ctx_);
+}
+
+bool LocalH2Server::Start()
+{
+    ctx_ = SSL_CTX_new(TLS_server_method());
+    if (ctx_ == nullptr || !UseSelfSignedCert(ctx_)) {
+        return false;
+    }
+    SSL_CTX_set_alpn_select_cb(ctx_, SelectH2, nullptr);
+    SSL_CTX_set_mode(ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd_, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 64) != 0 ||
+        getsockname(listenFd_, (sockaddr *)&addr, &len) != 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    stopped_ = false;
+    acceptThread_ = std::thread(&LocalH2Server::acceptLoop, this);
+    return true;
+}
+
+void LocalH2Server::Stop()
+{
+    if (stopped_.exchange(true)) {
+        return;
+    }
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> locker(lock_);
+        for (int fd : fds_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        workers.swap(workers_);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+}
+
+std::string LocalH2Server::Endpoint() const
+{
+    std::stringstream ss;
+    ss << "https://127.0.0.1:" << port_;
+    return ss.str();
+}
+
+void LocalH2Server::acceptLoop()
+{
+    while (!stopped_) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+        connectionCount_++;
+        std::lock_guard<std::mutex> locker(lock_);
+        fds_.push_back(fd);
+        workers_.push_back(std::thread(&LocalH2Server::serve, this, fd));
+    }
+}
+
+std::string LocalH2Server::response(unsigned streamId)
+{
+    //indexed :status 200
+    std::string block(1, static_cast<char>(0x88));
+    AppendLiteral(block, "content-length", std::to_string(body_.size()));
+    AppendLiteral(block, "content-type", "application/octet-stream");
+    AppendLiteral(block, "etag", "\"etag-1\"");
+    std::string out = Frame(FRAME_HEADERS, FLAG_END_HEADERS, streamId, block);
+    const size_t maxFrame = 16384;
+    for (size_t pos = 0; pos < body_.size() || pos == 0; pos += maxFrame) {
+        bool last = pos + maxFrame >= body_.size();
+        out.append(Frame(FRAME_DATA, last ? FLAG_END_STREAM : 0, streamId, body_.substr(pos, maxFrame)));
+    }
+    return out;
+}
+
+//one thread per connection reads the frames, and writes the responses once they are due
+void LocalH2Server::serve(int fd)
+{
+    //SSL_write sends with plain write(), a peer which went away must not raise SIGPIPE in the test binary,
+    //with the signal blocked on this thread the write fails with EPIPE instead
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, nullptr);
+
+    SSL *ssl = SSL_new(ctx_);
+    SSL_set_fd(ssl, fd);
+    if (SSL_accept(ssl) != 1) {
+        SSL_free(ssl);
+        close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    struct Pending {
+        std::chrono::steady_clock::time_point due;
+        unsigned streamId;
+    };
+    std::deque<Pending> pending;
+    std::string in;
+    //SETTINGS_MAX_CONCURRENT_STREAMS = 100
+    std::string out = Frame(FRAME_SETTINGS, 0, 0, std::string("\x00\x03\x00\x00\x00\x64", 6));
+    bool prefaceSeen = false;
+    bool open = true;
+
+    while (open && !stopped_) {
+        auto now = std::chrono::steady_clock::now();
+        int timeoutMs = 100;
+        if (!pending.empty()) {
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(pending.front().due - now).count();
+            timeoutMs = static_cast<int>(wait < 0 ? 0 : (wait < 100 ? wait : 100));
+        }
+        if (SSL_pending(ssl) == 0) {
+            pollfd pfd = { fd, static_cast<short>(POLLIN | (out.empty() ? 0 : POLLOUT)), 0 };
+            poll(&pfd, 1, timeoutMs);
+        }
+
+        char buffer[16384];
+        for (;;) {
+            int n = SSL_read(ssl, buffer, sizeof(buffer));
+            if (n > 0) {
+                in.append(buffer, n);
+                continue;
+            }
+            int err = SSL_get_error(ssl, n);
+            if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) {
+                open = false;
+            }
+            break;
+        }
+
+        if (!prefaceSeen && in.size() >= PREFACE_SIZE) {
+            if (in.compare(0, PREFACE_SIZE, PREFACE) != 0) {
+                break;
+            }
+            in.erase(0, PREFACE_SIZE);
+            prefaceSeen = true;
+        }
+        size_t pos = 0;
+        while (prefaceSeen && in.size() - pos >= 9) {
+            const char *header = in.data() + pos;
+            size_t length = (static_cast<uint8_t>(header[0]) << 16) | (static_cast<uint8_t>(header[1]) << 8) | static_cast<uint8_t>(header[2]);
+            if (in.size() - pos < 9 + length) {
+                break;
+            }
+            uint8_t type = static_cast<uint8_t>(header[3]);
+            uint8_t flags = static_cast<uint8_t>(header[4]);
+            unsigned streamId = ((static_cast<uint8_t>(header[5]) & 0x7f) << 24) | (static_cast<uint8_t>(header[6]) << 16) |
+                (static_cast<uint8_t>(header[7]) << 8) | static_cast<uint8_t>(header[8]);
+            std::string payload = in.substr(pos + 9, length);
+            pos += 9 + length;
+
+            if (type == FRAME_SETTINGS && !(flags & FLAG_ACK)) {
+                out.append(Frame(FRAME_SETTINGS, FLAG_ACK, 0, ""));
+            }
+            else if (type == FRAME_PING && !(flags & FLAG_ACK)) {
+                out.append(Frame(FRAME_PING, FLAG_ACK, 0, payload));
+            }
+            else if (type == FRAME_GOAWAY) {
+                open = false;
+            }
+            else if (type == FRAME_DATA && length > 0) {
+                out.append(Frame(FRAME_WINDOW_UPDATE, 0, 0, WindowIncrement(static_cast<unsigned>(length))));
+                out.append(Frame(FRAME_WINDOW_UPDATE, 0, streamId, WindowIncrement(static_cast<unsigned>(length))));
+            }
+
+            //the request is complete with its last frame
+            if ((type == FRAME_HEADERS || type == FRAME_CONTINUATION || type == FRAME_DATA) && (flags & FLAG_END_STREAM)) {
+                streamCount_++;
+                int current = ++concurrentStreams_;
+                int seen = maxConcurrentStreams_.load();
+                while (current > seen && !maxConcurrentStreams_.compare_exchange_weak(seen, current)) {
+                }
+                Pending p = { std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs_), streamId };
+                pending.push_back(p);
+            }
+        }
+        in.erase(0, pos);
+
+        now = std::chrono::steady_clock::now();
+        while (!pending.empty() && pending.front().due <= now) {
+            out.append(response(pending.front().streamId));
+            pending.pop_front();
+            concurrentStreams_--;
+        }
+
+        while (!out.empty()) {
+            int n = SSL_write(ssl, out.data(), static_cast<int>(out.size()));
+            if (n <= 0) {
+                int err = SSL_get_error(ssl, n);
+                if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) {
+                    open = false;
+                }
+                break;
+            }
+            out.erase(0, n);
+        }
+    }
+
+    concurrentStreams_ -= static_cast<int>(pending.size());
+    SSL_free(ssl);
+    close(fd);
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#ifndef _WIN32
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <openssl/ssl.h>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+/*
+* A minimal HTTP/2 server over TLS on 127.0.0.1, with a self-signed certificate and "h2"
+* chosen by ALPN. It answers every stream with 200 and the same body after a delay, without
+* decoding the request headers, and counts the connections and the streams in flight.
+*/
+class LocalH2Server
+{
+public:
+    LocalH2Server(const std::string &body, long delayMs);
+    ~LocalH2Server();
+
+    bool Start();
+    void Stop();
+    std::string Endpoint() const;
+    int ConnectionCount() const { return connectionCount_.load(); }
+    int StreamCount() const { return streamCount_.load(); }
+    int MaxConcurrentStreams() const { return maxConcurrentStreams_.load(); }
+
+private:
+    void acceptLoop();
+    void serve(int fd);
+    std::string response(unsigned streamId);
+
+    std::string body_;
+    long delayMs_;
+    SSL_CTX *ctx_;
+    int listenFd_;
+    int port_;
+    std::atomic<bool> stopped_;
+    std::atomic<int> connectionCount_;
+    std::atomic<int> streamCount_;
+    std::atomic<int> concurrentStreams_;
+    std::atomic<int> maxConcurrentStreams_;
+    std::thread acceptThread_;
+    std::mutex lock_;
+    std::vector<int> fds_;
+    std::vector<std::thread> workers_;
+};
+
+}
+}
+#endif
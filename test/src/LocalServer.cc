@@ -0,0 +1,198 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include "LocalServer.h"
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace AlibabaCloud::OSS;
+
+LocalServer::LocalServer(const Handler &handler) :
+    handler_(handler),
+    listenFd_(-1),
+    port_(0),
+    stopped_(true),
+    requestCount_(0)
+{
+}
+
+LocalServer::~LocalServer()
+{
+    Stop();
+}
+
+bool LocalServer::Start()
+{
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd_, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 64) != 0 ||
+        getsockname(listenFd_, (sockaddr *)&addr, &len) != 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    stopped_ = false;
+    acceptThread_ = std::thread(&LocalServer::acceptLoop, this);
+    return true;
+}
+
+void LocalServer::Stop()
+{
+    if (stopped_.exchange(true)) {
+        return;
+    }
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    cv_.notify_all();
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> locker(lock_);
+        workers.swap(workers_);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+}
+
+std::string LocalServer::Endpoint() const
+{
+    std::stringstream ss;
+    ss << "http://127.0.0.1:" << port_;
+    return ss.str();
+}
+
+void LocalServer::acceptLoop()
+{
+    while (!stopped_) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+        std::lock_guard<std::mutex> locker(lock_);
+        workers_.push_back(std::thread(&LocalServer::serve, this, fd));
+    }
+}
+
+bool LocalServer::sleepFor(long ms)
+{
+    std::unique_lock<std::mutex> locker(lock_);
+    cv_.wait_for(locker, std::chrono::milliseconds(ms), [this]() { return stopped_.load(); });
+    return !stopped_;
+}
+
+void LocalServer::serve(int fd)
+{
+    std::string data;
+    char buffer[4096];
+    size_t headerEnd;
+    while ((headerEnd = data.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            close(fd);
+            return;
+        }
+        data.append(buffer, n);
+    }
+
+    Request request;
+    std::istringstream is(data.substr(0, headerEnd));
+    std::string line;
+    std::getline(is, line);
+    std::istringstream(line) >> request.method >> request.path;
+    while (std::getline(is, line)) {
+        auto pos = line.find(':');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        std::string value = line.substr(pos + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        if (!value.empty() && value.back() == '\r') {
+            value.pop_back();
+        }
+        request.headers[line.substr(0, pos)] = value;
+    }
+    request.body = data.substr(headerEnd + 4);
+    auto it = request.headers.find("Content-Length");
+    size_t contentLength = it == request.headers.end() ? 0 : std::strtoul(it->second.c_str(), nullptr, 10);
+    while (request.body.size() < contentLength) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        request.body.append(buffer, n);
+    }
+
+    requestCount_++;
+    Response response;
+    handler_(request, response);
+
+    if (response.delayMs > 0 && !sleepFor(response.delayMs)) {
+        close(fd);
+        return;
+    }
+
+    std::stringstream ss;
+    ss << "HTTP/1.1 " << response.status << " Status\r\n";
+    ss << "Content-Length: " << response.body.size() << "\r\n";
+    ss << "Connection: close\r\n";
+    for (const auto &h : response.headers) {
+        ss << h.first << ": " << h.second << "\r\n";
+    }
+    ss << "\r\n";
+    std::string out = ss.str();
+    if (request.method != "HEAD") {
+        if (response.truncateAt >= 0 && response.truncateAt < static_cast<long>(response.body.size())) {
+            out.append(response.body, 0, response.truncateAt);
+        }
+        else {
+            out.append(response.body);
+        }
+    }
+
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t n = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += n;
+    }
+    close(fd);
+}
+#endif
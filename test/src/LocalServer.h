@@ -0,0 +1,87 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _WIN32
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+/*
+* A minimal HTTP/1.1 server on 127.0.0.1, used as a stand-in for OSS
+* by the tests which must run without network access.
+* Every connection is served by its own thread and closed after one response.
+*/
+class LocalServer
+{
+public:
+    struct Request {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> headers;
+        std::string body;
+    };
+
+    struct Response {
+        Response() : status(200), delayMs(0), truncateAt(-1) {}
+        int status;
+        std::map<std::string, std::string> headers;
+        std::string body;
+        //wait before sending the response
+        long delayMs;
+        //close the connection after so many body bytes, -1 sends all
+        long truncateAt;
+    };
+
+    typedef std::function<void(const Request &, Response &)> Handler;
+
+    explicit LocalServer(const Handler &handler);
+    ~LocalServer();
+
+    bool Start();
+    void Stop();
+    int Port() const { return port_; }
+    std::string Endpoint() const;
+    int RequestCount() const { return requestCount_.load(); }
+
+private:
+    void acceptLoop();
+    void serve(int fd);
+    bool sleepFor(long ms);
+
+    Handler handler_;
+    int listenFd_;
+    int port_;
+    std::atomic<bool> stopped_;
+    std::atomic<int> requestCount_;
+    std::thread acceptThread_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::vector<std::thread> workers_;
+};
+
+}
+}
+#endif
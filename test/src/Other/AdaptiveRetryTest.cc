@@ -0,0 +1,203 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/AdaptiveRetryStrategy.h>
+#include <alibabacloud/oss/client/CancellationToken.h>
+#include "../LocalServer.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static Error ServerError(long status)
+{
+    Error error("ServerError", "");
+    error.setStatus(status);
+    return error;
+}
+
+TEST(AdaptiveRetryTest, RetryableErrorTest)
+{
+    EXPECT_TRUE(AdaptiveRetryStrategy::IsRetryableError(ServerError(503)));
+    EXPECT_TRUE(AdaptiveRetryStrategy::IsRetryableError(ServerError(599)));
+    EXPECT_TRUE(AdaptiveRetryStrategy::IsRetryableError(ServerError(ERROR_CURL_BASE + 28)));
+    EXPECT_FALSE(AdaptiveRetryStrategy::IsRetryableError(ServerError(404)));
+    EXPECT_FALSE(AdaptiveRetryStrategy::IsRetryableError(ServerError(ERROR_CRC_INCONSISTENT)));
+    EXPECT_FALSE(AdaptiveRetryStrategy::IsRetryableError(ServerError(ERROR_CURL_BASE + 23)));
+}
+
+TEST(AdaptiveRetryTest, DecorrelatedJitterTest)
+{
+    AdaptiveRetryStrategy strategy(10, 100, 2000);
+    Error error = ServerError(503);
+    for (int round = 0; round < 20; round++) {
+        long prev = 100;
+        for (long retry = 0; retry < 10; retry++) {
+            long delay = strategy.calcDealyTimeMs(error, retry);
+            EXPECT_GE(delay, 100L);
+            EXPECT_LE(delay, 2000L);
+            EXPECT_LE(delay, prev * 3);
+            prev = delay;
+        }
+    }
+}
+
+TEST(AdaptiveRetryTest, MaxRetriesTest)
+{
+    AdaptiveRetryStrategy strategy(2);
+    Error error = ServerError(500);
+    EXPECT_TRUE(strategy.shouldRetry(error, 0));
+    EXPECT_TRUE(strategy.shouldRetry(error, 1));
+    EXPECT_FALSE(strategy.shouldRetry(error, 2));
+    EXPECT_FALSE(strategy.shouldRetry(ServerError(403), 0));
+}
+
+TEST(AdaptiveRetryTest, RetryBudgetTest)
+{
+    AdaptiveRetryStrategy strategy(3);
+    strategy.setRetryBudget(10, 1);
+    strategy.setCircuitBreaker(1.0, 1000, 10000, 5000);
+    Error error = ServerError(503);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(strategy.shouldRetry(error, 0));
+        strategy.onRequestFailure("endpoint", error);
+    }
+    //tokens at half of max, retries stop
+    EXPECT_DOUBLE_EQ(strategy.RetryTokens(), 5.0);
+    EXPECT_FALSE(strategy.shouldRetry(error, 0));
+
+    //successes refill the budget
+    strategy.onRequestSuccess("endpoint");
+    EXPECT_TRUE(strategy.shouldRetry(error, 0));
+
+    //client errors don't cost tokens
+    strategy.onRequestFailure("endpoint", ServerError(404));
+    EXPECT_DOUBLE_EQ(strategy.RetryTokens(), 7.0);
+}
+
+TEST(AdaptiveRetryTest, CircuitBreakerTest)
+{
+    AdaptiveRetryStrategy strategy;
+    strategy.setCircuitBreaker(0.5, 4, 10000, 100);
+    Error error = ServerError(503);
+
+    EXPECT_TRUE(strategy.allowRequest("a"));
+    strategy.onRequestSuccess("a");
+    strategy.onRequestFailure("a", error);
+    strategy.onRequestFailure("a", error);
+    EXPECT_FALSE(strategy.IsCircuitOpen("a"));
+    strategy.onRequestFailure("a", error);
+    EXPECT_TRUE(strategy.IsCircuitOpen("a"));
+    EXPECT_FALSE(strategy.allowRequest("a"));
+
+    //other endpoints are not affected
+    EXPECT_TRUE(strategy.allowRequest("b"));
+    EXPECT_FALSE(strategy.IsCircuitOpen("b"));
+
+    //a single probe after the open period, failing opens it again
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_TRUE(strategy.allowRequest("a"));
+    EXPECT_FALSE(strategy.allowRequest("a"));
+    strategy.onRequestFailure("a", error);
+    EXPECT_FALSE(strategy.allowRequest("a"));
+
+    //a successful probe closes it
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_TRUE(strategy.allowRequest("a"));
+    strategy.onRequestSuccess("a");
+    EXPECT_FALSE(strategy.IsCircuitOpen("a"));
+    EXPECT_TRUE(strategy.allowRequest("a"));
+}
+
+TEST(AdaptiveRetryTest, AbortedProbeTest)
+{
+    std::atomic<int> requests(0);
+    LocalServer server([&](const LocalServer::Request &, LocalServer::Response &resp) {
+        int n = ++requests;
+        if (n <= 2) {
+            resp.status = 503;
+        }
+        else if (n == 3) {
+            resp.delayMs = 3000;
+        }
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto strategy = std::make_shared<AdaptiveRetryStrategy>(0, 1, 5);
+    strategy->setCircuitBreaker(0.5, 2, 10000, 100);
+    ClientConfiguration conf;
+    conf.retryStrategy = strategy;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    EXPECT_FALSE(client.GetObject("bucket", "key").isSuccess());
+    EXPECT_FALSE(client.GetObject("bucket", "key").isSuccess());
+    EXPECT_TRUE(strategy->IsCircuitOpen(server.Endpoint()));
+
+    //the probe is cancelled while the server holds it
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    auto token = std::make_shared<CancellationToken>();
+    GetObjectRequest request("bucket", "key");
+    request.setCancellationToken(token);
+    std::thread canceller([token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        token->cancel();
+    });
+    auto outcome = client.GetObject(request);
+    canceller.join();
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100004");
+    EXPECT_EQ(client.GetObject("bucket", "key").error().Code(), "ClientError:100003");
+
+    //the next open period ends with a new probe, which closes the circuit
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_TRUE(client.GetObject("bucket", "key").isSuccess());
+    EXPECT_FALSE(strategy->IsCircuitOpen(server.Endpoint()));
+}
+
+TEST(AdaptiveRetryTest, ClientFailFastTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 503;
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto strategy = std::make_shared<AdaptiveRetryStrategy>(2, 1, 5);
+    strategy->setCircuitBreaker(0.5, 6, 10000, 60000);
+    ClientConfiguration conf;
+    conf.retryStrategy = strategy;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    //3 attempts per request, the breaker opens on the 6th failure
+    auto outcome = client.GetObject("bucket", "key");
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ServerError:503");
+    outcome = client.GetObject("bucket", "key");
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(server.RequestCount(), 6);
+
+    outcome = client.GetObject("bucket", "key");
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100003");
+    EXPECT_EQ(server.RequestCount(), 6);
+}
+
+}
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include "../LocalServer.h"
+#include <mutex>
+#include <set>
+#include <condition_variable>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+class AsyncApiTest : public ::testing::Test {
+protected:
+    static ClientConfiguration Conf()
+    {
+        ClientConfiguration conf;
+        conf.enableCrc64 = false;
+        conf.maxConnections = 4;
+        return conf;
+    }
+};
+
+class HeadObjectAsyncContext : public AsyncCallerContext
+{
+public:
+    HeadObjectAsyncContext() : ready(false), length(-1) {}
+    mutable std::mutex mtx;
+    mutable std::condition_variable cv;
+    mutable bool ready;
+    mutable int64_t length;
+};
+
+TEST_F(AsyncApiTest, HeadObjectAsyncTest)
+{
+    LocalServer server([](const LocalServer::Request &req, LocalServer::Response &resp) {
+        EXPECT_EQ(req.method, "HEAD");
+        resp.headers["Content-Length"] = "1234";
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto context = std::make_shared<HeadObjectAsyncContext>();
+    HeadObjectAsyncHandler handler = [](const OssClient *, const HeadObjectRequest &,
+        const ObjectMetaDataOutcome &outcome, const std::shared_ptr<const AsyncCallerContext> &ctx) {
+        auto c = static_cast<const HeadObjectAsyncContext *>(ctx.get());
+        std::unique_lock<std::mutex> lck(c->mtx);
+        c->length = outcome.isSuccess() ? outcome.result().ContentLength() : -1;
+        c->ready = true;
+        c->cv.notify_all();
+    };
+    client.HeadObjectAsync(HeadObjectRequest("bucket", "key"), handler, context);
+
+    std::unique_lock<std::mutex> lck(context->mtx);
+    ASSERT_TRUE(context->cv.wait_for(lck, std::chrono::seconds(10), [&]() { return context->ready; }));
+    EXPECT_EQ(context->length, 1234);
+}
+
+TEST_F(AsyncApiTest, CallableTest)
+{
+    LocalServer server([](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (req.method == "DELETE") {
+            resp.status = 204;
+        }
+        else {
+            resp.headers["ETag"] = "\"etag-1\"";
+        }
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto head = client.HeadObjectCallable(HeadObjectRequest("bucket", "key"));
+    auto del = client.DeleteObjectCallable(DeleteObjectRequest("bucket", "key"));
+    auto acl = client.SetBucketAclCallable(SetBucketAclRequest("bucket", CannedAccessControlList::Private));
+
+    EXPECT_TRUE(head.get().isSuccess());
+    EXPECT_TRUE(del.get().isSuccess());
+    EXPECT_TRUE(acl.get().isSuccess());
+    EXPECT_EQ(server.RequestCount(), 3);
+}
+
+TEST_F(AsyncApiTest, PooledExecutorTest)
+{
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    std::vector<ObjectMetaDataOutcomeCallable> results;
+    for (int i = 0; i < 32; i++) {
+        results.push_back(client.HeadObjectCallable(HeadObjectRequest("bucket", "key")));
+    }
+    for (auto &r : results) {
+        EXPECT_TRUE(r.get().isSuccess());
+    }
+
+    //the calls share the workers, not one thread each
+    std::vector<std::future<void>> probes;
+    for (int i = 0; i < 32; i++) {
+        auto task = std::make_shared<std::packaged_task<void()>>([&]() {
+            std::lock_guard<std::mutex> locker(lock);
+            threads.insert(std::this_thread::get_id());
+        });
+        probes.push_back(task->get_future());
+        client.HeadObjectAsync(HeadObjectRequest("bucket", "key"),
+            [task](const OssClient *, const HeadObjectRequest &, const ObjectMetaDataOutcome &,
+                const std::shared_ptr<const AsyncCallerContext> &) { (*task)(); });
+    }
+    for (auto &p : probes) {
+        p.get();
+    }
+    EXPECT_LE(threads.size(), 4U);
+}
+
+TEST_F(AsyncApiTest, NestedCallableTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    //every handler waits on a request queued behind it, twice as many as the workers
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    std::mutex lock;
+    std::condition_variable cv;
+    int done = 0;
+    const int count = 2 * Conf().maxConnections;
+    for (int i = 0; i < count; i++) {
+        client.HeadObjectAsync(HeadObjectRequest("bucket", "key"),
+            [&](const OssClient *c, const HeadObjectRequest &, const ObjectMetaDataOutcome &,
+                const std::shared_ptr<const AsyncCallerContext> &) {
+            bool nested = c->HeadObjectCallable(HeadObjectRequest("bucket", "key")).get().isSuccess();
+            std::lock_guard<std::mutex> locker(lock);
+            done += nested ? 1 : 0;
+            cv.notify_all();
+        });
+    }
+
+    std::unique_lock<std::mutex> locker(lock);
+    EXPECT_TRUE(cv.wait_for(locker, std::chrono::seconds(20), [&]() { return done == count; }));
+    EXPECT_EQ(done, count);
+}
+
+}
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/CancellationToken.h>
+#include <alibabacloud/oss/client/RetryStrategy.h>
+#include "../LocalServer.h"
+#include <thread>
+#include <chrono>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+class CancellationTest : public ::testing::Test {
+protected:
+    class SlowRetry : public RetryStrategy
+    {
+    public:
+        bool shouldRetry(const Error &, long attemptedRetries) const override { return attemptedRetries < 3; }
+        long calcDealyTimeMs(const Error &, long) const override { return 5000; }
+    };
+
+    static ClientConfiguration Conf()
+    {
+        ClientConfiguration conf;
+        conf.enableCrc64 = false;
+        conf.retryStrategy = std::make_shared<SlowRetry>();
+        return conf;
+    }
+
+    static LocalServer::Handler Delay(long delayMs, int status = 200)
+    {
+        return [delayMs, status](const LocalServer::Request &, LocalServer::Response &resp) {
+            resp.status = status;
+            resp.delayMs = delayMs;
+            resp.body = "hello";
+        };
+    }
+
+    static long ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+};
+
+TEST_F(CancellationTest, CancelledBeforeStartTest)
+{
+    LocalServer server(Delay(0));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto token = std::make_shared<CancellationToken>();
+    token->cancel();
+    GetObjectRequest request("bucket", "key");
+    request.setCancellationToken(token);
+
+    auto outcome = client.GetObject(request);
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100004");
+    EXPECT_EQ(server.RequestCount(), 0);
+}
+
+TEST_F(CancellationTest, CancelInFlightTest)
+{
+    LocalServer server(Delay(3000));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto token = std::make_shared<CancellationToken>();
+    GetObjectRequest request("bucket", "key");
+    request.setCancellationToken(token);
+
+    std::thread canceller([token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        token->cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client.GetObject(request);
+    long elapsed = ElapsedMs(start);
+    canceller.join();
+
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100004");
+    EXPECT_LT(elapsed, 2000L);
+    EXPECT_EQ(server.RequestCount(), 1);
+}
+
+TEST_F(CancellationTest, CancelRetryWaitTest)
+{
+    LocalServer server(Delay(0, 503));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto token = std::make_shared<CancellationToken>();
+    HeadObjectRequest request("bucket", "key");
+    request.setCancellationToken(token);
+
+    std::thread canceller([token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        token->cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client.HeadObject(request);
+    long elapsed = ElapsedMs(start);
+    canceller.join();
+
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100004");
+    EXPECT_LT(elapsed, 2000L);
+    EXPECT_EQ(server.RequestCount(), 1);
+}
+
+TEST_F(CancellationTest, DeadlineTest)
+{
+    LocalServer server(Delay(3000));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    GetObjectRequest request("bucket", "key");
+    request.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(300));
+
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client.GetObject(request);
+    long elapsed = ElapsedMs(start);
+
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100005");
+    EXPECT_GE(elapsed, 250L);
+    EXPECT_LT(elapsed, 2000L);
+}
+
+TEST_F(CancellationTest, DeadlineCapsRetryWaitTest)
+{
+    LocalServer server(Delay(0, 503));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    HeadObjectRequest request("bucket", "key");
+    request.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(300));
+
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client.HeadObject(request);
+    long elapsed = ElapsedMs(start);
+
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100005");
+    EXPECT_LT(elapsed, 2000L);
+    EXPECT_EQ(server.RequestCount(), 1);
+}
+
+TEST_F(CancellationTest, OtherRequestsUnaffectedTest)
+{
+    LocalServer server(Delay(0));
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto token = std::make_shared<CancellationToken>();
+    token->cancel();
+    GetObjectRequest cancelled("bucket", "key");
+    cancelled.setCancellationToken(token);
+
+    EXPECT_FALSE(client.GetObject(cancelled).isSuccess());
+    EXPECT_TRUE(client.GetObject(GetObjectRequest("bucket", "key")).isSuccess());
+}
+
+}
+}
+#endif
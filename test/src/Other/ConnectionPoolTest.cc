@@ -0,0 +1,221 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/MetricsRegistry.h>
+#include "../LocalServer.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static int64_t GaugeValue(const MetricsRegistry &registry, const std::string &name)
+{
+    for (const auto &gauge : registry.snapshot().gauges) {
+        if (gauge.first == name) {
+            return gauge.second;
+        }
+    }
+    return -1;
+}
+
+static HistogramSnapshot PoolWait(MetricsRegistry &registry)
+{
+    HistogramSnapshot snapshot;
+    registry.histogram("oss_http_pool_wait_us")->snapshot(snapshot);
+    return snapshot;
+}
+
+static LocalServer::Handler SlowHandler(int delayMs)
+{
+    return [delayMs](const LocalServer::Request &, LocalServer::Response &resp) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        resp.headers["ETag"] = "\"etag-1\"";
+    };
+}
+
+TEST(ConnectionPoolTest, AcquireTimeoutTest)
+{
+    LocalServer server(SlowHandler(600));
+    ASSERT_TRUE(server.Start());
+
+    auto registry = std::make_shared<MetricsRegistry>();
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.maxConnections = 1;
+    conf.connectionAcquireTimeoutMs = 100;
+    conf.metricsRegistry = registry;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    auto busy = std::async(std::launch::async, [&]() {
+        return client.HeadObject(HeadObjectRequest("bucket", "key"));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto outcome = client.HeadObject(HeadObjectRequest("bucket", "key"));
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100006");
+
+    EXPECT_TRUE(busy.get().isSuccess());
+    EXPECT_EQ(server.RequestCount(), 1);
+
+    EXPECT_EQ(registry->counter("oss_http_pool_timeouts_total")->value(), 1U);
+    auto wait = PoolWait(*registry);
+    EXPECT_EQ(wait.count, 2U);
+    EXPECT_GE(wait.percentile(100), 100000U);
+}
+
+TEST(ConnectionPoolTest, WaitForFreeConnectionTest)
+{
+    LocalServer server(SlowHandler(100));
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.maxConnections = 1;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    //without a timeout the second call queues behind the first
+    auto first = std::async(std::launch::async, [&]() {
+        return client.HeadObject(HeadObjectRequest("bucket", "key"));
+    });
+    auto second = client.HeadObject(HeadObjectRequest("bucket", "key"));
+    EXPECT_TRUE(second.isSuccess());
+    EXPECT_TRUE(first.get().isSuccess());
+    EXPECT_EQ(server.RequestCount(), 2);
+}
+
+TEST(ConnectionPoolTest, ManyThreadsTest)
+{
+    LocalServer server(SlowHandler(0));
+    ASSERT_TRUE(server.Start());
+
+    auto registry = std::make_shared<MetricsRegistry>();
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.maxConnections = 4;
+    conf.metricsRegistry = registry;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    const int threads = 16;
+    const int loops = 20;
+    std::atomic<int> failed(0);
+    std::atomic<int64_t> maxConnections(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back([&]() {
+            for (int j = 0; j < loops; j++) {
+                if (!client.HeadObject(HeadObjectRequest("bucket", "key")).isSuccess()) {
+                    failed++;
+                }
+                int64_t current = GaugeValue(*registry, "oss_http_connections");
+                int64_t seen = maxConnections.load();
+                while (current > seen && !maxConnections.compare_exchange_weak(seen, current)) {
+                }
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_EQ(server.RequestCount(), threads * loops);
+    EXPECT_LE(maxConnections.load(), 4);
+    EXPECT_EQ(GaugeValue(*registry, "oss_http_connections_in_use"), 0);
+    EXPECT_EQ(PoolWait(*registry).count, static_cast<uint64_t>(threads * loops));
+    EXPECT_EQ(registry->counter("oss_http_pool_timeouts_total")->value(), 0U);
+}
+
+static bool WaitFor(const std::function<bool()> &done)
+{
+    for (int i = 0; i < 100 && !done(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return done();
+}
+
+TEST(ConnectionPoolTest, WarmUpTest)
+{
+    std::mutex lock;
+    std::vector<std::string> requests;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &) {
+        std::lock_guard<std::mutex> locker(lock);
+        requests.push_back(req.method + " " + req.path);
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto registry = std::make_shared<MetricsRegistry>();
+    ClientConfiguration conf;
+    conf.maxConnections = 8;
+    conf.warmupConnections = 3;
+    conf.metricsRegistry = registry;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    //the constructor does not wait for the warm-up, a handle is counted before its request is sent
+    //and is still in use until its response has been read
+    ASSERT_TRUE(WaitFor([&]() {
+        std::lock_guard<std::mutex> locker(lock);
+        return requests.size() == 3 && GaugeValue(*registry, "oss_http_connections_in_use") == 0;
+    }));
+    EXPECT_EQ(GaugeValue(*registry, "oss_http_connections"), 3);
+    std::lock_guard<std::mutex> locker(lock);
+    std::vector<std::string> expected(3, "HEAD /");
+    EXPECT_EQ(requests, expected);
+}
+
+TEST(ConnectionPoolTest, CloseIdleTest)
+{
+    LocalServer server(SlowHandler(200));
+    ASSERT_TRUE(server.Start());
+
+    auto registry = std::make_shared<MetricsRegistry>();
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.maxConnections = 4;
+    conf.warmupConnections = 1;
+    conf.idleConnectionTimeoutMs = 200;
+    conf.metricsRegistry = registry;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    std::vector<std::future<ObjectMetaDataOutcome>> results;
+    for (int i = 0; i < 4; i++) {
+        results.push_back(std::async(std::launch::async, [&]() {
+            return client.HeadObject(HeadObjectRequest("bucket", "key"));
+        }));
+    }
+    for (auto &r : results) {
+        EXPECT_TRUE(r.get().isSuccess());
+    }
+    EXPECT_EQ(GaugeValue(*registry, "oss_http_connections"), 4);
+
+    //down to the warm-up size, not below
+    ASSERT_TRUE(WaitFor([&]() { return GaugeValue(*registry, "oss_http_connections") == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(GaugeValue(*registry, "oss_http_connections"), 1);
+    EXPECT_TRUE(client.HeadObject(HeadObjectRequest("bucket", "key")).isSuccess());
+}
+
+}
+}
+#endif
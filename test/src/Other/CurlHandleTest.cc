@@ -0,0 +1,127 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <src/http/CurlHeaderList.h>
+#include "../LocalServer.h"
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static std::vector<std::string> ToVector(const curl_slist *list)
+{
+    std::vector<std::string> values;
+    for (; list != nullptr; list = list->next) {
+        values.push_back(list->data);
+    }
+    return values;
+}
+
+static HeaderCollection RequestHeaders(int extra)
+{
+    HeaderCollection headers;
+    headers["Content-Type"] = "application/octet-stream";
+    headers["Date"] = "Thu, 01 Jan 2026 00:00:00 GMT";
+    headers["Authorization"] = "OSS ak:c2lnbmF0dXJlLXZhbHVlLTAxMjM0NTY3ODk=";
+    headers["x-oss-date"] = "20260101T000000Z";
+    for (int i = 0; i < extra; i++) {
+        headers["x-oss-meta-key" + std::to_string(i)] = "value-" + std::to_string(i);
+    }
+    return headers;
+}
+
+TEST(CurlHandleTest, HeaderListTest)
+{
+    CurlHeaderList list;
+    EXPECT_EQ(list.build(HeaderCollection()), nullptr);
+
+    HeaderCollection headers;
+    headers["Content-Type"] = "text/plain";
+    headers["Empty"] = "";
+    headers["x-oss-meta-a"] = "1";
+    auto values = ToVector(list.build(headers));
+    ASSERT_EQ(values.size(), 2U);
+    EXPECT_NE(std::find(values.begin(), values.end(), "Content-Type: text/plain"), values.end());
+    EXPECT_NE(std::find(values.begin(), values.end(), "x-oss-meta-a: 1"), values.end());
+
+    //the buffers are reused by a longer list and then a shorter one
+    EXPECT_EQ(ToVector(list.build(RequestHeaders(32))).size(), 36U);
+    values = ToVector(list.build(RequestHeaders(0)));
+    ASSERT_EQ(values.size(), 4U);
+    EXPECT_NE(std::find(values.begin(), values.end(), "x-oss-date: 20260101T000000Z"), values.end());
+}
+
+#ifndef _WIN32
+TEST(CurlHandleTest, HandleReuseTest)
+{
+    std::mutex lock;
+    std::vector<std::string> methods;
+    std::vector<bool> withMeta;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        bool meta = false;
+        for (const auto &h : req.headers) {
+            std::string name = h.first;
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            meta = meta || name == "x-oss-meta-reuse";
+        }
+        {
+            std::lock_guard<std::mutex> locker(lock);
+            methods.push_back(req.method);
+            withMeta.push_back(meta);
+        }
+        if (req.method == "DELETE") {
+            resp.status = 204;
+            return;
+        }
+        resp.headers["ETag"] = "\"etag-1\"";
+        if (req.method == "GET") {
+            resp.body = "hello";
+        }
+    });
+    ASSERT_TRUE(server.Start());
+
+    //one handle serves every request
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.maxConnections = 1;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    ObjectMetaData meta;
+    meta.UserMetaData()["reuse"] = "1";
+    auto content = std::make_shared<std::stringstream>("data");
+    EXPECT_TRUE(client.PutObject(PutObjectRequest("bucket", "key", content, meta)).isSuccess());
+    EXPECT_TRUE(client.HeadObject(HeadObjectRequest("bucket", "key")).isSuccess());
+    EXPECT_TRUE(client.DeleteObject(DeleteObjectRequest("bucket", "key")).isSuccess());
+    auto get = client.GetObject(GetObjectRequest("bucket", "key"));
+    ASSERT_TRUE(get.isSuccess());
+    std::stringstream body;
+    body << get.result().Content()->rdbuf();
+    EXPECT_EQ(body.str(), "hello");
+
+    std::vector<std::string> expected = { "PUT", "HEAD", "DELETE", "GET" };
+    EXPECT_EQ(methods, expected);
+    std::vector<bool> expectedMeta = { true, false, false, false };
+    EXPECT_EQ(withMeta, expectedMeta);
+}
+#endif
+
+}
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/AdaptiveRetryStrategy.h>
+#include <alibabacloud/oss/client/EndpointBalancer.h>
+#include "../LocalServer.h"
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static Error StatusError(long status)
+{
+    Error error("ServerError", "");
+    error.setStatus(status);
+    return error;
+}
+
+static void Record(EndpointBalancer &balancer, const std::string &endpoint, long long latencyUs)
+{
+    balancer.onRequestStart(endpoint);
+    balancer.onRequestSuccess(endpoint, latencyUs);
+}
+
+static const EndpointBalancer::EndpointState &StateOf(const std::vector<EndpointBalancer::EndpointState> &states,
+    const std::string &endpoint)
+{
+    for (const auto &state : states) {
+        if (state.endpoint == endpoint) {
+            return state;
+        }
+    }
+    return states.front();
+}
+
+static ClientConfiguration BalancedConf(const std::shared_ptr<EndpointBalancer> &balancer)
+{
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.retryStrategy = std::make_shared<AdaptiveRetryStrategy>(3, 1, 10);
+    conf.endpointBalancer = balancer;
+    return conf;
+}
+
+TEST(EndpointBalancerTest, EndpointFailureTest)
+{
+    EXPECT_TRUE(EndpointBalancer::IsEndpointFailure(StatusError(503)));
+    EXPECT_TRUE(EndpointBalancer::IsEndpointFailure(StatusError(599)));
+    EXPECT_TRUE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_CURL_BASE + 7)));
+    EXPECT_TRUE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_CURL_BASE + 28)));
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(404)));
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(600)));
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_REQUEST_CANCELLED)));
+    //local to the caller: write error, aborted by callback, bad option
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_CURL_BASE + 23)));
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_CURL_BASE + 42)));
+    EXPECT_FALSE(EndpointBalancer::IsEndpointFailure(StatusError(ERROR_CURL_BASE + 43)));
+}
+
+TEST(EndpointBalancerTest, LowerCostWinsTest)
+{
+    EndpointBalancer balancer({ "a", "b" });
+    Record(balancer, "a", 1000);
+    Record(balancer, "b", 50000);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(balancer.pickEndpoint(), "a");
+    }
+
+    //enough requests in flight outweigh the latency
+    for (int i = 0; i < 60; i++) {
+        balancer.onRequestStart("a");
+    }
+    EXPECT_EQ(balancer.pickEndpoint(), "b");
+    EXPECT_EQ(StateOf(balancer.States(), "a").inFlight, 60);
+}
+
+TEST(EndpointBalancerTest, AvoidTest)
+{
+    EndpointBalancer balancer({ "a", "b", "c" });
+    Record(balancer, "a", 1000);
+    Record(balancer, "b", 2000);
+    Record(balancer, "c", 3000);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_NE(balancer.pickEndpoint("a"), "a");
+        EXPECT_EQ(balancer.pickEndpoint(std::vector<std::string>{ "a", "b" }), "c");
+    }
+    //every endpoint avoided, one is still picked
+    EXPECT_FALSE(balancer.pickEndpoint(std::vector<std::string>{ "a", "b", "c" }).empty());
+
+    //the only endpoint is used even when avoided
+    EndpointBalancer single({ "a" });
+    EXPECT_EQ(single.pickEndpoint("a"), "a");
+}
+
+TEST(EndpointBalancerTest, EjectionTest)
+{
+    EndpointBalancer balancer({ "a", "b" }, 2, 100);
+    Record(balancer, "a", 1000);
+    Record(balancer, "b", 50000);
+
+    //client side errors and answers like 404 don't count
+    balancer.onRequestStart("a");
+    balancer.onRequestFailure("a", 1000, StatusError(ERROR_REQUEST_CANCELLED));
+    balancer.onRequestStart("a");
+    balancer.onRequestFailure("a", 1000, StatusError(404));
+    EXPECT_FALSE(StateOf(balancer.States(), "a").ejected);
+    EXPECT_DOUBLE_EQ(StateOf(balancer.States(), "a").errorRate, 0.0);
+
+    for (int i = 0; i < 2; i++) {
+        balancer.onRequestStart("a");
+        balancer.onRequestFailure("a", 1000, StatusError(503));
+    }
+    EXPECT_TRUE(StateOf(balancer.States(), "a").ejected);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(balancer.pickEndpoint(), "b");
+    }
+
+    //back with a clean record once the ejection is over
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(balancer.pickEndpoint(), "a");
+    EXPECT_FALSE(StateOf(balancer.States(), "a").ejected);
+}
+
+TEST(EndpointBalancerTest, AllEjectedTest)
+{
+    EndpointBalancer balancer({ "a", "b" }, 1, 10000);
+    balancer.onRequestStart("a");
+    balancer.onRequestFailure("a", 1000, StatusError(ERROR_CURL_BASE + 7));
+    balancer.onRequestStart("b");
+    balancer.onRequestFailure("b", 1000, StatusError(ERROR_CURL_BASE + 7));
+
+    //requests still go somewhere
+    EXPECT_EQ(balancer.pickEndpoint("a"), "b");
+    EXPECT_EQ(balancer.pickEndpoint("b"), "a");
+}
+
+TEST(EndpointBalancerTest, RoutesToFastEndpointTest)
+{
+    auto handler = [](long delayMs) {
+        return [delayMs](const LocalServer::Request &, LocalServer::Response &resp) {
+            resp.delayMs = delayMs;
+            resp.headers["ETag"] = "\"etag-1\"";
+        };
+    };
+    LocalServer slow(handler(100));
+    LocalServer fast1(handler(0));
+    LocalServer fast2(handler(0));
+    ASSERT_TRUE(slow.Start());
+    ASSERT_TRUE(fast1.Start());
+    ASSERT_TRUE(fast2.Start());
+
+    auto balancer = std::make_shared<EndpointBalancer>(
+        std::vector<std::string>{ slow.Endpoint(), fast1.Endpoint(), fast2.Endpoint() });
+    OssClient client(slow.Endpoint(), "ak", "sk", BalancedConf(balancer));
+    for (int i = 0; i < 30; i++) {
+        EXPECT_TRUE(client.HeadObject("bucket", "key").isSuccess());
+    }
+
+    EXPECT_EQ(slow.RequestCount() + fast1.RequestCount() + fast2.RequestCount(), 30);
+    EXPECT_LE(slow.RequestCount(), 3);
+    EXPECT_GT(StateOf(balancer->States(), slow.Endpoint()).latencyMs, 90.0);
+}
+
+TEST(EndpointBalancerTest, FirstByteLatencyTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+        resp.body = std::string(256 * 1024, 'x');
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto balancer = std::make_shared<EndpointBalancer>(std::vector<std::string>{ server.Endpoint() });
+    OssClient client(server.Endpoint(), "ak", "sk", BalancedConf(balancer));
+    GetObjectRequest request("bucket", "key");
+    //a slow reader makes the attempt long, the endpoint answered at once
+    TransferProgress handler = { [](size_t, int64_t, int64_t, void *) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }, nullptr };
+    request.setTransferProgress(handler);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(client.GetObject(request).isSuccess());
+    auto attemptMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_GE(attemptMs, 100);
+    EXPECT_LT(StateOf(balancer->States(), server.Endpoint()).latencyMs, 50.0);
+}
+
+TEST(EndpointBalancerTest, FailoverTest)
+{
+    LocalServer broken([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 503;
+    });
+    LocalServer healthy([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.body = "data";
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(broken.Start());
+    ASSERT_TRUE(healthy.Start());
+
+    auto balancer = std::make_shared<EndpointBalancer>(
+        std::vector<std::string>{ broken.Endpoint(), healthy.Endpoint() }, 100, 10000);
+    //the broken endpoint looks better until it fails
+    Record(*balancer, broken.Endpoint(), 1000);
+    Record(*balancer, healthy.Endpoint(), 10000000);
+    OssClient client(healthy.Endpoint(), "ak", "sk", BalancedConf(balancer));
+
+    //a POST is retried where it was sent
+    std::shared_ptr<std::iostream> content = std::make_shared<std::stringstream>("append");
+    auto append = client.AppendObject(AppendObjectRequest("bucket", "key", content));
+    EXPECT_FALSE(append.isSuccess());
+    EXPECT_EQ(broken.RequestCount(), 4);
+    EXPECT_EQ(healthy.RequestCount(), 0);
+
+    //a GET fails over to the other endpoint
+    auto get = client.GetObject("bucket", "key");
+    ASSERT_TRUE(get.isSuccess());
+    std::stringstream ss;
+    ss << get.result().Content()->rdbuf();
+    EXPECT_EQ(ss.str(), "data");
+    EXPECT_LE(broken.RequestCount(), 5);
+    EXPECT_EQ(healthy.RequestCount(), 1);
+}
+
+TEST(EndpointBalancerTest, EjectedEndpointSkippedTest)
+{
+    LocalServer broken([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 500;
+    });
+    LocalServer healthy([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(broken.Start());
+    ASSERT_TRUE(healthy.Start());
+
+    auto balancer = std::make_shared<EndpointBalancer>(
+        std::vector<std::string>{ broken.Endpoint(), healthy.Endpoint() }, 3, 10000);
+    OssClient client(healthy.Endpoint(), "ak", "sk", BalancedConf(balancer));
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded(0);
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 5; j++) {
+                if (client.HeadObject("bucket", "key").isSuccess()) {
+                    succeeded++;
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    //every request ends on the healthy endpoint, the broken one only sees the failures which ejected it
+    EXPECT_EQ(succeeded.load(), 40);
+    EXPECT_TRUE(StateOf(balancer->States(), broken.Endpoint()).ejected);
+    EXPECT_LE(broken.RequestCount(), 3 + 8);
+}
+
+TEST(EndpointBalancerTest, OpenCircuitSkippedTest)
+{
+    LocalServer tripped([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    LocalServer healthy([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(tripped.Start());
+    ASSERT_TRUE(healthy.Start());
+
+    auto balancer = std::make_shared<EndpointBalancer>(
+        std::vector<std::string>{ tripped.Endpoint(), healthy.Endpoint() }, 100, 10000);
+    //the balancer prefers the endpoint whose circuit is open
+    Record(*balancer, tripped.Endpoint(), 1000);
+    Record(*balancer, healthy.Endpoint(), 10000000);
+    auto conf = BalancedConf(balancer);
+    auto strategy = std::make_shared<AdaptiveRetryStrategy>(3, 1, 10);
+    strategy->setCircuitBreaker(0.5, 2, 60000, 60000);
+    conf.retryStrategy = strategy;
+    for (int i = 0; i < 2; i++) {
+        strategy->onRequestFailure(tripped.Endpoint(), StatusError(503));
+    }
+    ASSERT_TRUE(strategy->IsCircuitOpen(tripped.Endpoint()));
+    OssClient client(healthy.Endpoint(), "ak", "sk", conf);
+
+    //neither a GET nor the first attempt of a POST fails fast while another endpoint is closed
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(client.HeadObject("bucket", "key").isSuccess());
+    }
+    std::shared_ptr<std::iostream> content = std::make_shared<std::stringstream>("append");
+    EXPECT_TRUE(client.AppendObject(AppendObjectRequest("bucket", "key", content)).isSuccess());
+    EXPECT_EQ(tripped.RequestCount(), 0);
+    EXPECT_EQ(healthy.RequestCount(), 4);
+
+    //with every circuit open the request still fails fast
+    for (int i = 0; i < 6; i++) {
+        strategy->onRequestFailure(healthy.Endpoint(), StatusError(503));
+    }
+    ASSERT_TRUE(strategy->IsCircuitOpen(healthy.Endpoint()));
+    auto outcome = client.HeadObject("bucket", "key");
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ClientError:100003");
+    EXPECT_EQ(healthy.RequestCount(), 4);
+}
+
+}
+}
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/Types.h>
+#include <alibabacloud/oss/http/HttpType.h>
+#include <algorithm>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+using HeaderMap = std::map<std::string, std::string, caseInsensitiveLess>;
+
+static std::vector<std::pair<std::string, std::string>> SampleResponseHeaders()
+{
+    return {
+        { "Server", "AliyunOSS" },
+        { "Date", "Thu, 16 Oct 2026 08:00:00 GMT" },
+        { "Content-Type", "application/octet-stream" },
+        { "Content-Length", "1048576" },
+        { "Connection", "keep-alive" },
+        { "x-oss-request-id", "5F3A1B2C3D4E5F60718293A4" },
+        { "Accept-Ranges", "bytes" },
+        { "ETag", "\"5B3C1A2B3C4D5E6F7A8B9C0D1E2F3A4B\"" },
+        { "Last-Modified", "Wed, 15 Oct 2026 08:00:00 GMT" },
+        { "x-oss-object-type", "Normal" },
+        { "x-oss-hash-crc64ecma", "1234567890123456789" },
+        { "x-oss-storage-class", "Standard" },
+        { "x-oss-meta-author", "someone" },
+        { "Content-MD5", "1B2M2Y8AsgTpgAmY7PhCfg==" },
+    };
+}
+
+TEST(HeaderCollectionTest, CaseInsensitiveTest)
+{
+    HeaderCollection headers;
+    headers["Content-Length"] = "10";
+    headers["content-length"] = "20";
+    EXPECT_EQ(headers.size(), 1U);
+    EXPECT_EQ(headers.begin()->first, "Content-Length");
+    EXPECT_EQ(headers.at("CONTENT-LENGTH"), "20");
+    EXPECT_EQ(headers.count("content-LENGTH"), 1U);
+    EXPECT_EQ(headers.at("ETag"), "");
+    EXPECT_TRUE(headers.find("ETag") == headers.end());
+
+    //insert keeps the existing value, as std::map does
+    auto ret = headers.insert(std::make_pair(std::string("CONTENT-length"), std::string("30")));
+    EXPECT_FALSE(ret.second);
+    EXPECT_EQ(ret.first->second, "20");
+    EXPECT_TRUE(headers.emplace(Http::ETAG, "\"etag\"").second);
+
+    EXPECT_EQ(headers.erase("etag"), 1U);
+    EXPECT_EQ(headers.erase("etag"), 0U);
+    headers.erase(headers.begin());
+    EXPECT_TRUE(headers.empty());
+}
+
+TEST(HeaderCollectionTest, SameOrderAsMapTest)
+{
+    HeaderCollection headers;
+    HeaderMap map;
+    for (auto const &header : SampleResponseHeaders()) {
+        headers[header.first] = header.second;
+        map[header.first] = header.second;
+    }
+    headers["X-OSS-Meta-Author"] = "another";
+    map["X-OSS-Meta-Author"] = "another";
+
+    ASSERT_EQ(headers.size(), map.size());
+    auto it = headers.begin();
+    for (auto const &header : map) {
+        EXPECT_EQ(it->first, header.first);
+        EXPECT_EQ(it->second, header.second);
+        ++it;
+    }
+
+    //converts both ways
+    HeaderCollection fromMap(map.begin(), map.end());
+    EXPECT_TRUE(fromMap == headers);
+    HeaderMap toMap(headers.begin(), headers.end());
+    EXPECT_EQ(toMap, map);
+
+    HeaderCollection list = { { "b", "2" }, { "A", "1" } };
+    EXPECT_EQ(list.begin()->first, "A");
+    EXPECT_TRUE(list != fromMap);
+}
+
+TEST(HeaderCollectionTest, LookupTest)
+{
+    auto source = SampleResponseHeaders();
+    HeaderCollection headers(source.begin(), source.end());
+    for (auto const &header : source) {
+        std::string upper = header.first;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        EXPECT_EQ(headers.at(upper), header.second) << upper;
+        EXPECT_EQ(headers.find(header.first)->first, header.first);
+        //a name sorted next to an existing one, but not equal to it
+        EXPECT_EQ(headers.count(header.first + "-"), 0U);
+        EXPECT_EQ(headers.count(header.first.substr(0, header.first.size() - 1)), 0U);
+    }
+    EXPECT_EQ(headers.count(""), 0U);
+    EXPECT_EQ(headers.count("zzz"), 0U);
+}
+
+TEST(HeaderCollectionTest, LargeCollectionTest)
+{
+    //small collections are scanned, larger ones binary searched
+    HeaderCollection headers;
+    HeaderMap map;
+    for (int i = 40; i > 0; i--) {
+        std::string name = "x-oss-meta-Key-" + std::to_string(i);
+        headers[name] = std::to_string(i);
+        map[name] = std::to_string(i);
+        EXPECT_EQ(headers.size(), map.size());
+        EXPECT_EQ(headers.at("X-OSS-META-KEY-40"), "40");
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        EXPECT_EQ(headers.at(lower), std::to_string(i));
+        EXPECT_FALSE(headers.insert(std::make_pair(name, std::string("other"))).second);
+        EXPECT_EQ(headers.count(name + "-"), 0U);
+    }
+    EXPECT_TRUE(HeaderCollection(map.begin(), map.end()) == headers);
+    EXPECT_EQ(headers.erase("x-oss-meta-key-7"), 1U);
+    EXPECT_EQ(headers.count("x-oss-meta-key-7"), 0U);
+    EXPECT_EQ(headers.at("x-oss-meta-key-8"), "8");
+}
+
+}
+}
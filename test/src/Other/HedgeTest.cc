@@ -0,0 +1,212 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/HedgePolicy.h>
+#include "../LocalServer.h"
+#include <chrono>
+#include <atomic>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+class HedgeTest : public ::testing::Test {
+protected:
+    static std::shared_ptr<OssClient> NewClient(const LocalServer &server, const std::shared_ptr<HedgePolicy> &policy)
+    {
+        ClientConfiguration conf;
+        conf.hedgePolicy = policy;
+        conf.enableCrc64 = false;
+        return std::make_shared<OssClient>(server.Endpoint(), "ak", "sk", conf);
+    }
+
+    static GetObjectRequest RangedGet(int64_t size)
+    {
+        GetObjectRequest request("bucket", "key");
+        request.setRange(0, size - 1);
+        return request;
+    }
+
+    static long ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+};
+
+TEST_F(HedgeTest, HedgePolicyDefaultTest)
+{
+    HedgePolicy policy;
+    EXPECT_EQ(policy.hedgeDelayMs(), 1000L);
+    EXPECT_TRUE(policy.acquireHedge());
+    EXPECT_FALSE(policy.acquireHedge());
+}
+
+TEST_F(HedgeTest, HedgePolicyPercentileTest)
+{
+    HedgePolicy policy(50.0, 5, 1000, 5.0, 64);
+    for (long i = 1; i <= 64; i++) {
+        policy.recordLatency(i);
+    }
+    EXPECT_EQ(policy.hedgeDelayMs(), 32L);
+
+    for (long i = 0; i < 64; i++) {
+        policy.recordLatency(1);
+    }
+    EXPECT_EQ(policy.hedgeDelayMs(), 5L);
+
+    for (long i = 0; i < 64; i++) {
+        policy.recordLatency(5000);
+    }
+    EXPECT_EQ(policy.hedgeDelayMs(), 1000L);
+}
+
+TEST_F(HedgeTest, HedgePolicyBudgetTest)
+{
+    HedgePolicy policy(95.0, 5, 1000, 10.0);
+    EXPECT_TRUE(policy.acquireHedge());
+    EXPECT_FALSE(policy.acquireHedge());
+
+    //10 percent budget, one hedge per 10 requests
+    for (int i = 0; i < 11; i++) {
+        policy.recordLatency(10);
+    }
+    EXPECT_TRUE(policy.acquireHedge());
+    EXPECT_FALSE(policy.acquireHedge());
+}
+
+TEST_F(HedgeTest, SlowRequestIsHedgedTest)
+{
+    std::atomic<int> count(0);
+    LocalServer server([&](const LocalServer::Request &, LocalServer::Response &resp) {
+        if (count++ == 0) {
+            resp.delayMs = 3000;
+        }
+        resp.body = "hedged";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto client = NewClient(server, std::make_shared<HedgePolicy>(95.0, 5, 50));
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client->GetObject(RangedGet(6));
+    auto elapsed = ElapsedMs(start);
+
+    EXPECT_TRUE(outcome.isSuccess());
+    std::string content;
+    *outcome.result().Content() >> content;
+    EXPECT_EQ(content, "hedged");
+    EXPECT_EQ(server.RequestCount(), 2);
+    EXPECT_LT(elapsed, 2000L);
+}
+
+TEST_F(HedgeTest, FastRequestIsNotHedgedTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.body = "fast";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto client = NewClient(server, std::make_shared<HedgePolicy>(95.0, 500, 1000));
+    for (int i = 0; i < 5; i++) {
+        auto outcome = client->GetObject("bucket", "key");
+        EXPECT_TRUE(outcome.isSuccess());
+    }
+    auto hOutcome = client->HeadObject("bucket", "key");
+    EXPECT_TRUE(hOutcome.isSuccess());
+    EXPECT_EQ(server.RequestCount(), 6);
+}
+
+TEST_F(HedgeTest, HedgeBudgetExhaustedTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.delayMs = 100;
+        resp.body = "slow";
+    });
+    ASSERT_TRUE(server.Start());
+
+    //no budget beyond the initial token, only the first request is hedged
+    auto client = NewClient(server, std::make_shared<HedgePolicy>(95.0, 10, 10, 0.0));
+    for (int i = 0; i < 3; i++) {
+        auto outcome = client->GetObject(RangedGet(4));
+        EXPECT_TRUE(outcome.isSuccess());
+    }
+    EXPECT_EQ(server.RequestCount(), 4);
+}
+
+TEST_F(HedgeTest, HedgeableRangeTest)
+{
+    HedgePolicy policy;
+    policy.setMaxHedgeBytes(1024);
+    EXPECT_TRUE(policy.isHedgeableRange("bytes=0-1023"));
+    EXPECT_TRUE(policy.isHedgeableRange("bytes=4096-4096"));
+    EXPECT_FALSE(policy.isHedgeableRange("bytes=0-1024"));
+    EXPECT_FALSE(policy.isHedgeableRange("bytes=100-"));
+    EXPECT_FALSE(policy.isHedgeableRange("bytes=10-5"));
+    EXPECT_FALSE(policy.isHedgeableRange(""));
+}
+
+TEST_F(HedgeTest, LargeGetIsNotHedgedTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.delayMs = 100;
+        resp.body = "slow";
+    });
+    ASSERT_TRUE(server.Start());
+
+    //a whole object and a range above the limit go out once
+    auto policy = std::make_shared<HedgePolicy>(95.0, 10, 10);
+    policy->setMaxHedgeBytes(1024);
+    auto client = NewClient(server, policy);
+    EXPECT_TRUE(client->GetObject("bucket", "key").isSuccess());
+    EXPECT_TRUE(client->GetObject(RangedGet(2048)).isSuccess());
+    EXPECT_EQ(server.RequestCount(), 2);
+}
+
+TEST_F(HedgeTest, PutRequestIsNotHedgedTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.delayMs = 100;
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto client = NewClient(server, std::make_shared<HedgePolicy>(95.0, 10, 10));
+    auto content = std::make_shared<std::stringstream>("data");
+    auto outcome = client->PutObject("bucket", "key", content);
+    EXPECT_TRUE(outcome.isSuccess());
+    EXPECT_EQ(server.RequestCount(), 1);
+}
+
+TEST_F(HedgeTest, ErrorResponseTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 404;
+        resp.headers["Content-Type"] = "application/xml";
+        resp.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><Error><Code>NoSuchKey</Code>"
+            "<Message>The specified key does not exist.</Message><RequestId>id</RequestId></Error>";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto client = NewClient(server, std::make_shared<HedgePolicy>());
+    auto outcome = client->GetObject("bucket", "key");
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "NoSuchKey");
+}
+
+}
+}
+#endif
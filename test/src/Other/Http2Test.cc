@@ -0,0 +1,143 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/RateLimiter.h>
+#include "../LocalH2Server.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static ClientConfiguration Http2Conf(unsigned streams)
+{
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.enableHttp2 = true;
+    conf.maxConnections = streams;
+    return conf;
+}
+
+static std::string ReadAll(const GetObjectOutcome &outcome)
+{
+    std::stringstream ss;
+    ss << outcome.result().Content()->rdbuf();
+    return ss.str();
+}
+
+static void GetInParallel(const OssClient &client, int count, const std::string &expected)
+{
+    std::vector<std::thread> threads;
+    std::atomic<int> matched(0);
+    for (int i = 0; i < count; i++) {
+        threads.emplace_back([&]() {
+            auto outcome = client.GetObject("bucket", "key");
+            if (outcome.isSuccess() && ReadAll(outcome) == expected) {
+                matched++;
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(matched.load(), count);
+}
+
+TEST(Http2Test, MultiplexTest)
+{
+    const std::string body(4096, 'x');
+    LocalH2Server server(body, 300);
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Http2Conf(64));
+    auto start = std::chrono::steady_clock::now();
+    GetInParallel(client, 64, body);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    //every request is a stream of one connection, and they run side by side
+    EXPECT_EQ(server.ConnectionCount(), 1);
+    EXPECT_EQ(server.StreamCount(), 64);
+    EXPECT_GE(server.MaxConcurrentStreams(), 32);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 64 * 300 / 4);
+}
+
+TEST(Http2Test, StreamsCappedByMaxConnectionsTest)
+{
+    const std::string body(1024, 'y');
+    LocalH2Server server(body, 100);
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Http2Conf(4));
+    GetInParallel(client, 16, body);
+
+    EXPECT_EQ(server.ConnectionCount(), 1);
+    EXPECT_EQ(server.StreamCount(), 16);
+    EXPECT_LE(server.MaxConcurrentStreams(), 4);
+}
+
+TEST(Http2Test, ConnectionsPerHostTest)
+{
+    const std::string body(1024, 'z');
+    LocalH2Server server(body, 300);
+    ASSERT_TRUE(server.Start());
+
+    auto conf = Http2Conf(32);
+    conf.http2ConnectionsPerHost = 2;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    GetInParallel(client, 32, body);
+
+    EXPECT_GE(server.ConnectionCount(), 1);
+    EXPECT_LE(server.ConnectionCount(), 2);
+    EXPECT_EQ(server.StreamCount(), 32);
+}
+
+class FixedRateLimiter : public RateLimiter
+{
+public:
+    explicit FixedRateLimiter(int rate) : rate_(rate) {}
+    void setRate(int rate) override { rate_ = rate; }
+    int Rate() const override { return rate_; }
+private:
+    int rate_;
+};
+
+TEST(Http2Test, RateLimitPerStreamTest)
+{
+    const std::string body(1024 * 1024, 'r');
+    LocalH2Server server(body, 0);
+    ASSERT_TRUE(server.Start());
+
+    //each stream is limited on its own, so four of them take as long as one
+    auto conf = Http2Conf(4);
+    conf.recvRateLimiter = std::make_shared<FixedRateLimiter>(512);
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    auto start = std::chrono::steady_clock::now();
+    GetInParallel(client, 4, body);
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(server.ConnectionCount(), 1);
+    EXPECT_GE(elapsedMs, 1800);
+    EXPECT_LT(elapsedMs, 4000);
+}
+
+}
+}
+#endif
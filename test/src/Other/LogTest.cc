@@ -20,6 +20,10 @@
 #include "../Utils.h"
 #include <alibabacloud/oss/OssClient.h>
 #include "src/utils/LogUtils.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace AlibabaCloud {
 namespace OSS {
@@ -101,6 +105,7 @@ TEST_F(LogTest, EnableLogTest)
         TestUtils::WaitForCacheExpire(2);
         outcome = Client->ListBuckets();
     }
+    FlushLog();
     EXPECT_EQ(outcome.isSuccess(), true);
     EXPECT_EQ(LogString.empty(), false);
 }
@@ -112,6 +117,7 @@ TEST_F(LogTest, LogMacroTest)
     LogString = "";
 
     OSS_LOG(LogLevel::LogFatal, "LogTest", "LogMacroTest%s","Fatal");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[FATAL]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestFatal") != nullptr);
@@ -119,6 +125,7 @@ TEST_F(LogTest, LogMacroTest)
 
     LogString = "";
     OSS_LOG(LogLevel::LogError, "LogTest", "LogMacroTest%s", "Error");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[ERROR]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestError") != nullptr);
@@ -126,36 +133,42 @@ TEST_F(LogTest, LogMacroTest)
 
     LogString = "";
     OSS_LOG(LogLevel::LogWarn, "LogTest", "LogMacroTest%s", "Warn");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[WARN]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestWarn") != nullptr);
 
     LogString = "";
     OSS_LOG(LogLevel::LogInfo, "LogTest", "LogMacroTest%s", "Info");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[INFO]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestInfo") != nullptr);
 
     LogString = "";
     OSS_LOG(LogLevel::LogDebug, "LogTest", "LogMacroTest%s", "Debug");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[DEBUG]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestDebug") != nullptr);
 
     LogString = "";
     OSS_LOG(LogLevel::LogTrace, "LogTest", "LogMacroTest%s", "Trace");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[TRACE]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestTrace") != nullptr);
 
     LogString = "";
     OSS_LOG(LogLevel::LogOff, "LogTest", "LogMacroTest%s", "Off");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[OFF]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestOff") != nullptr);
 
     LogString = "";
     OSS_LOG(LogLevel::LogAll, "LogTest", "LogMacroTest%s", "All");
+    FlushLog();
     EXPECT_TRUE(strstr(LogString.c_str(), "[ALL]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "[LogTest]") != nullptr);
     EXPECT_TRUE(strstr(LogString.c_str(), "LogMacroTestAll") != nullptr);
@@ -168,28 +181,117 @@ TEST_F(LogTest, EndofLineTest)
     LogString = "";
 
     OSS_LOG(LogLevel::LogTrace, "LogTest", "LogMacroTest%s\n", "Trace");
+    FlushLog();
     EXPECT_EQ(LogString.c_str()[LogString.size()-1], '\n');
     EXPECT_EQ(LogString.c_str()[LogString.size() - 2], 'e');
     std::cout << LogString;
 
     LogString = "";
     OSS_LOG(LogLevel::LogTrace, "LogTest", "LogMacroTest%s\n\n\n", "Trace");
+    FlushLog();
     EXPECT_EQ(LogString.c_str()[LogString.size()-1], '\n');
     EXPECT_EQ(LogString.c_str()[LogString.size() - 2], 'e');
     std::cout << LogString;
 
     LogString = "";
     OSS_LOG(LogLevel::LogTrace, "LogTest", "LogMacroTest%s", "Trace");
+    FlushLog();
     EXPECT_EQ(LogString.c_str()[LogString.size() - 1], '\n');
     EXPECT_EQ(LogString.c_str()[LogString.size() - 2], 'e');
     std::cout << LogString;
 
     LogString = "";
     OSS_LOG(LogLevel::LogTrace, "LogTest", "");
+    FlushLog();
     EXPECT_EQ(LogString.c_str()[LogString.size() - 1], '\n');
     EXPECT_EQ(LogString.c_str()[LogString.size() - 2], ']');
     std::cout << LogString;
 }
+static std::atomic<int> CallbackCount(0);
+static std::mutex CallbackLock;
+static std::condition_variable CallbackCv;
+static bool CallbackBlocked = false;
 
+static void CountingLogCallback(LogLevel, const std::string &stream)
+{
+    if (stream.find("[LogUtils]") != std::string::npos) {
+        return;
+    }
+    std::unique_lock<std::mutex> lck(CallbackLock);
+    CallbackCv.wait(lck, []() { return !CallbackBlocked; });
+    CallbackCount++;
+}
+
+TEST_F(LogTest, LevelFilterTest)
+{
+    SetLogLevel(LogLevel::LogWarn);
+    SetLogCallback(CountingLogCallback);
+    CallbackCount = 0;
+
+    OSS_LOG(LogLevel::LogDebug, "LogTest", "filtered %d", 1);
+    OSS_LOG(LogLevel::LogInfo, "LogTest", "filtered %d", 2);
+    OSS_LOG(LogLevel::LogWarn, "LogTest", "delivered %d", 3);
+    FlushLog();
+    EXPECT_EQ(CallbackCount, 1);
+
+    SetLogLevel(LogLevel::LogOff);
+    SetLogCallback(nullptr);
+}
+
+TEST_F(LogTest, MultiThreadLogTest)
+{
+    SetLogLevel(LogLevel::LogAll);
+    SetLogCallback(CountingLogCallback);
+    CallbackCount = 0;
+    auto dropped = GetLogDroppedCountInner();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 2000; i++) {
+                OSS_LOG(LogLevel::LogDebug, "LogTest", "thread %d message %d", t, i);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    FlushLog();
+    EXPECT_EQ(static_cast<uint64_t>(CallbackCount) + GetLogDroppedCountInner() - dropped, 8000U);
+
+    SetLogLevel(LogLevel::LogOff);
+    SetLogCallback(nullptr);
+}
+
+TEST_F(LogTest, DropWhenFullTest)
+{
+    SetLogLevel(LogLevel::LogAll);
+    SetLogCallback(CountingLogCallback);
+    CallbackCount = 0;
+    auto dropped = GetLogDroppedCountInner();
+
+    //stall the callback, the ring fills up and the producers keep going
+    {
+        std::lock_guard<std::mutex> lck(CallbackLock);
+        CallbackBlocked = true;
+    }
+    const int total = 4096;
+    for (int i = 0; i < total; i++) {
+        OSS_LOG(LogLevel::LogDebug, "LogTest", "message %d", i);
+    }
+    EXPECT_GT(GetLogDroppedCountInner() - dropped, 0U);
+    {
+        std::lock_guard<std::mutex> lck(CallbackLock);
+        CallbackBlocked = false;
+    }
+    CallbackCv.notify_all();
+
+    FlushLog();
+    EXPECT_EQ(static_cast<uint64_t>(CallbackCount) + GetLogDroppedCountInner() - dropped, static_cast<uint64_t>(total));
+
+    SetLogLevel(LogLevel::LogOff);
+    SetLogCallback(nullptr);
+}
+
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/MetricsRegistry.h>
+#include <alibabacloud/oss/client/RetryStrategy.h>
+#include "../LocalServer.h"
+#include <sstream>
+#include <thread>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static uint64_t CounterValue(const MetricsSnapshot &snapshot, const std::string &name)
+{
+    for (auto const &counter : snapshot.counters) {
+        if (counter.first == name) {
+            return counter.second;
+        }
+    }
+    return static_cast<uint64_t>(-1);
+}
+
+static int64_t GaugeValue(const MetricsSnapshot &snapshot, const std::string &name)
+{
+    for (auto const &gauge : snapshot.gauges) {
+        if (gauge.first == name) {
+            return gauge.second;
+        }
+    }
+    return -1;
+}
+
+TEST(MetricsRegistryTest, CounterTest)
+{
+    MetricsRegistry registry;
+    MetricsCounter *counter = registry.counter("test_total");
+    EXPECT_EQ(registry.counter("test_total"), counter);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([counter]() {
+            for (int i = 0; i < 10000; i++) {
+                counter->add();
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    counter->add(5);
+    EXPECT_EQ(counter->value(), 80005U);
+    EXPECT_EQ(CounterValue(registry.snapshot(), "test_total"), 80005U);
+}
+
+TEST(MetricsRegistryTest, HistogramBucketTest)
+{
+    for (uint64_t v = 0; v < 16; v++) {
+        EXPECT_EQ(MetricsHistogram::BucketIndex(v), v);
+        EXPECT_EQ(MetricsHistogram::BucketUpperBound(v), v);
+    }
+    //every bucket follows the previous one without a gap
+    for (size_t i = 1; i < MetricsHistogram::BucketCount; i++) {
+        uint64_t lower = MetricsHistogram::BucketUpperBound(i - 1) + 1;
+        uint64_t upper = MetricsHistogram::BucketUpperBound(i);
+        EXPECT_EQ(MetricsHistogram::BucketIndex(lower), i);
+        EXPECT_EQ(MetricsHistogram::BucketIndex(upper), i);
+        EXPECT_LE(static_cast<double>(upper - lower), static_cast<double>(lower) / 8.0);
+    }
+    EXPECT_EQ(MetricsHistogram::BucketIndex(UINT64_MAX), MetricsHistogram::BucketCount - 1);
+    EXPECT_EQ(MetricsHistogram::BucketUpperBound(MetricsHistogram::BucketCount - 1), UINT64_MAX);
+}
+
+TEST(MetricsRegistryTest, HistogramPercentileTest)
+{
+    MetricsHistogram histogram;
+    for (uint64_t v = 1; v <= 1000; v++) {
+        histogram.record(v);
+    }
+    HistogramSnapshot snapshot;
+    histogram.snapshot(snapshot);
+    EXPECT_EQ(snapshot.count, 1000U);
+    EXPECT_EQ(snapshot.sum, 500500U);
+    EXPECT_EQ(snapshot.percentile(0), 1U);
+    uint64_t p50 = snapshot.percentile(50);
+    uint64_t p99 = snapshot.percentile(99);
+    EXPECT_GE(p50, 500U);
+    EXPECT_LE(p50, 500U + 500U / 8);
+    EXPECT_GE(p99, 990U);
+    EXPECT_LE(p99, 990U + 990U / 8);
+    EXPECT_GE(snapshot.percentile(100), 1000U);
+}
+
+TEST(MetricsRegistryTest, GaugeTest)
+{
+    MetricsRegistry registry;
+    auto id1 = registry.addGauge("test_gauge", []() { return static_cast<int64_t>(3); });
+    auto id2 = registry.addGauge("test_gauge", []() { return static_cast<int64_t>(4); });
+    EXPECT_EQ(GaugeValue(registry.snapshot(), "test_gauge"), 7);
+    registry.removeGauge(id1);
+    EXPECT_EQ(GaugeValue(registry.snapshot(), "test_gauge"), 4);
+    registry.removeGauge(id2);
+    EXPECT_TRUE(registry.snapshot().gauges.empty());
+}
+
+TEST(MetricsRegistryTest, PrometheusTextTest)
+{
+    MetricsRegistry registry;
+    registry.counter("test_requests_total{method=\"GET\"}")->add(2);
+    registry.counter("test_requests_total{method=\"PUT\"}")->add(1);
+    registry.addGauge("test_in_use", []() { return static_cast<int64_t>(5); });
+    auto histogram = registry.histogram("test_latency_us{method=\"GET\"}");
+    histogram->record(3);
+    histogram->record(3);
+    histogram->record(100);
+
+    PrometheusTextExporter exporter;
+    registry.exportTo(exporter);
+    std::string expected =
+        "# TYPE test_requests_total counter\n"
+        "test_requests_total{method=\"GET\"} 2\n"
+        "test_requests_total{method=\"PUT\"} 1\n"
+        "# TYPE test_in_use gauge\n"
+        "test_in_use 5\n"
+        "# TYPE test_latency_us histogram\n"
+        "test_latency_us_bucket{method=\"GET\",le=\"15\"} 2\n"
+        "test_latency_us_bucket{method=\"GET\",le=\"31\"} 2\n"
+        "test_latency_us_bucket{method=\"GET\",le=\"63\"} 2\n";
+    for (int bit = 7; bit <= PrometheusTextExporter::MaxBoundBit; bit++) {
+        expected.append("test_latency_us_bucket{method=\"GET\",le=\"")
+            .append(std::to_string((static_cast<uint64_t>(1) << bit) - 1)).append("\"} 3\n");
+    }
+    expected.append(
+        "test_latency_us_bucket{method=\"GET\",le=\"+Inf\"} 3\n"
+        "test_latency_us_sum{method=\"GET\"} 106\n"
+        "test_latency_us_count{method=\"GET\"} 3\n");
+    EXPECT_EQ(exporter.Text(), expected);
+}
+
+TEST(MetricsRegistryTest, PrometheusBoundsTest)
+{
+    MetricsRegistry registry;
+    auto histogram = registry.histogram("test_size_bytes");
+    PrometheusTextExporter first;
+    registry.exportTo(first);
+    histogram->record(1000);
+    histogram->record(1023);
+    histogram->record(1024);
+    histogram->record(static_cast<uint64_t>(1) << 40);
+    PrometheusTextExporter second;
+    registry.exportTo(second);
+
+    //the same series whether the buckets are empty or not
+    auto series = [](const std::string &text) {
+        std::vector<std::string> names;
+        std::stringstream ss(text);
+        std::string line;
+        while (std::getline(ss, line)) {
+            names.push_back(line.substr(0, line.rfind(' ')));
+        }
+        return names;
+    };
+    EXPECT_EQ(series(first.Text()), series(second.Text()));
+    EXPECT_NE(second.Text().find("test_size_bytes_bucket{le=\"511\"} 0\n"), std::string::npos);
+    EXPECT_NE(second.Text().find("test_size_bytes_bucket{le=\"1023\"} 2\n"), std::string::npos);
+    EXPECT_NE(second.Text().find("test_size_bytes_bucket{le=\"2047\"} 3\n"), std::string::npos);
+    EXPECT_NE(second.Text().find("test_size_bytes_bucket{le=\"68719476735\"} 3\n"), std::string::npos);
+    EXPECT_NE(second.Text().find("test_size_bytes_bucket{le=\"+Inf\"} 4\n"), std::string::npos);
+}
+
+#ifndef _WIN32
+class NoDelayRetryStrategy : public RetryStrategy
+{
+public:
+    bool shouldRetry(const Error &error, long attemptedRetries) const override
+    {
+        return attemptedRetries < 2 && error.Status() >= 500 && error.Status() < 600;
+    }
+    long calcDealyTimeMs(const Error &, long) const override { return 0; }
+};
+
+TEST(MetricsRegistryTest, ClientMetricsTest)
+{
+    LocalServer server([](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (req.path.find("missing") != std::string::npos) {
+            resp.status = 404;
+        }
+        else if (req.path.find("busy") != std::string::npos) {
+            resp.status = 503;
+        }
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto registry = std::make_shared<MetricsRegistry>();
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.metricsRegistry = registry;
+    conf.retryStrategy = std::make_shared<NoDelayRetryStrategy>();
+    {
+        OssClient client(server.Endpoint(), "ak", "sk", conf);
+        EXPECT_TRUE(client.HeadObject(HeadObjectRequest("bucket", "present")).isSuccess());
+        EXPECT_FALSE(client.HeadObject(HeadObjectRequest("bucket", "missing")).isSuccess());
+        EXPECT_FALSE(client.HeadObject(HeadObjectRequest("bucket", "busy")).isSuccess());
+        auto content = std::make_shared<std::stringstream>(std::string(100, 'x'));
+        EXPECT_TRUE(client.PutObject(PutObjectRequest("bucket", "present", content)).isSuccess());
+
+        auto snapshot = registry->snapshot();
+        EXPECT_EQ(CounterValue(snapshot, "oss_requests_total{method=\"HEAD\"}"), 3U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_request_errors_total{method=\"HEAD\"}"), 2U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_retries_total{method=\"HEAD\"}"), 2U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_requests_total{method=\"PUT\"}"), 1U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_transferred_bytes_total{method=\"PUT\"}"), 100U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_requests_total{method=\"GET\"}"), 0U);
+        EXPECT_EQ(CounterValue(snapshot, "oss_crc64_mismatch_total"), 0U);
+        EXPECT_GE(GaugeValue(snapshot, "oss_http_connections"), 1);
+        EXPECT_EQ(GaugeValue(snapshot, "oss_http_connections_in_use"), 0);
+        EXPECT_EQ(GaugeValue(snapshot, "oss_executor_queue_depth"), 0);
+
+        for (auto const &histogram : snapshot.histograms) {
+            if (histogram.name == "oss_request_latency_us{method=\"HEAD\"}") {
+                EXPECT_EQ(histogram.count, 3U);
+                EXPECT_GT(histogram.sum, 0U);
+            }
+        }
+    }
+
+    //the gauges go with the client
+    EXPECT_TRUE(registry->snapshot().gauges.empty());
+}
+#endif
+
+}
+}
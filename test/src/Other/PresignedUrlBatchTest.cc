@@ -0,0 +1,87 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <cstring>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static std::vector<std::string> Keys()
+{
+    return std::vector<std::string>{ "key", "dir/sub/object.txt", "with space+plus&amp", "\xe4\xb8\xad\xe6\x96\x87", "~-_.", "a=b?c" };
+}
+
+static void ExpectSameAsSingle(const OssClient &client, const std::string &bucket, int64_t expires, Http::Method method)
+{
+    auto keys = Keys();
+    auto outcome = client.GeneratePresignedUrls(bucket, keys, expires, method);
+    ASSERT_TRUE(outcome.isSuccess());
+    const auto &list = outcome.result();
+    ASSERT_EQ(list.Count(), keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto single = client.GeneratePresignedUrl(bucket, keys[i], expires, method);
+        ASSERT_TRUE(single.isSuccess());
+        EXPECT_EQ(list.Url(i), single.result());
+        EXPECT_EQ(list.UrlLength(i), std::strlen(list.UrlData(i)));
+    }
+}
+
+TEST(PresignedUrlBatchTest, SameAsSingleTest)
+{
+    OssClient client("oss-cn-hangzhou.aliyuncs.com", "ak", "sk", ClientConfiguration());
+    ExpectSameAsSingle(client, "bucket", 1700000000, Http::Method::Get);
+    ExpectSameAsSingle(client, "bucket", 1700000000, Http::Method::Put);
+}
+
+TEST(PresignedUrlBatchTest, SecurityTokenTest)
+{
+    OssClient client("https://oss-cn-hangzhou.aliyuncs.com", "ak", "sk", "token/with+chars=", ClientConfiguration());
+    ExpectSameAsSingle(client, "bucket", 1700000000, Http::Method::Get);
+    auto outcome = client.GeneratePresignedUrls("bucket", Keys(), 1700000000);
+    ASSERT_TRUE(outcome.isSuccess());
+    EXPECT_NE(outcome.result().Url(0).find("&security-token=token%2Fwith%2Bchars%3D"), std::string::npos);
+}
+
+TEST(PresignedUrlBatchTest, IpAndCnameEndpointTest)
+{
+    OssClient ipClient("http://127.0.0.1:8080", "ak", "sk", ClientConfiguration());
+    ExpectSameAsSingle(ipClient, "bucket", 1700000000, Http::Method::Get);
+
+    ClientConfiguration conf;
+    conf.isCname = true;
+    OssClient cnameClient("http://cdn.example.com", "ak", "sk", conf);
+    ExpectSameAsSingle(cnameClient, "bucket", 1700000000, Http::Method::Get);
+}
+
+TEST(PresignedUrlBatchTest, InvalidInputTest)
+{
+    OssClient client("oss-cn-hangzhou.aliyuncs.com", "ak", "sk", ClientConfiguration());
+    auto outcome = client.GeneratePresignedUrls("Invalid_Bucket", Keys(), 1700000000);
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(outcome.error().Code(), "ValidateError");
+
+    outcome = client.GeneratePresignedUrls("bucket", std::vector<std::string>{ "key", "/key" }, 1700000000);
+    EXPECT_FALSE(outcome.isSuccess());
+
+    outcome = client.GeneratePresignedUrls("bucket", std::vector<std::string>(), 1700000000);
+    ASSERT_TRUE(outcome.isSuccess());
+    EXPECT_EQ(outcome.result().Count(), 0U);
+}
+
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include "../LocalServer.h"
+
+namespace AlibabaCloud {
+namespace OSS {
+
+static ClientConfiguration Conf()
+{
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    return conf;
+}
+
+TEST(ResponseHeaderTest, TrimmedValuesTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+        resp.headers["x-oss-meta-padded"] = "\t value with spaces \t";
+        resp.headers["x-oss-meta-empty"] = "";
+        resp.headers["x-oss-meta-colon"] = "a:b: c";
+        resp.body = "hello world";
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject("bucket", "key");
+    ASSERT_TRUE(outcome.isSuccess());
+    const auto &meta = outcome.result().Metadata();
+    EXPECT_EQ(meta.ETag(), "etag-1");
+    EXPECT_EQ(meta.ContentLength(), 11);
+    EXPECT_EQ(meta.UserMetaData().at("padded"), "value with spaces");
+    EXPECT_EQ(meta.UserMetaData().at("empty"), "");
+    EXPECT_EQ(meta.UserMetaData().at("colon"), "a:b: c");
+}
+
+struct ProgressTotal
+{
+    int64_t transferred = 0;
+    int64_t total = 0;
+};
+
+TEST(ResponseHeaderTest, ContentLengthAsTotalTest)
+{
+    const std::string body(100000, 'x');
+    LocalServer server([&](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.headers["ETag"] = "\"etag-1\"";
+        resp.body = body;
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    ProgressTotal progress;
+    GetObjectRequest request("bucket", "key");
+    TransferProgress handler = { [](size_t, int64_t transferred, int64_t total, void *userData) {
+        auto p = static_cast<ProgressTotal *>(userData);
+        p->transferred = transferred;
+        p->total = total;
+    }, &progress };
+    request.setTransferProgress(handler);
+    auto outcome = client.GetObject(request);
+    ASSERT_TRUE(outcome.isSuccess());
+    EXPECT_EQ(progress.transferred, static_cast<int64_t>(body.size()));
+    EXPECT_EQ(progress.total, static_cast<int64_t>(body.size()));
+}
+
+}
+}
+#endif
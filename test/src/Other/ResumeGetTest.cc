@@ -0,0 +1,263 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/RetryStrategy.h>
+#include <src/utils/Crc64.h>
+#include "../LocalServer.h"
+#include <sstream>
+#include <mutex>
+#include <atomic>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+class ResumeGetTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        for (int i = 0; i < 100000; i++) {
+            content_.push_back(static_cast<char>('a' + i % 26));
+        }
+        std::string data(content_);
+        crc64_ = std::to_string(CRC64::CalcCRC(0, (void *)data.c_str(), data.size()));
+    }
+
+    //serves the object, the first "truncate" responses are cut in the middle
+    void Serve(const LocalServer::Request &req, LocalServer::Response &resp, int truncate, const std::string &etag)
+    {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> locker(lock_);
+            requests_.push_back(req);
+            index = requests_.size();
+        }
+        resp.headers["ETag"] = etag;
+        resp.headers["x-oss-hash-crc64ecma"] = crc64_;
+
+        auto it = req.headers.find("Range");
+        if (it != req.headers.end()) {
+            auto match = req.headers.find("If-Match");
+            if (match != req.headers.end() && match->second != etag) {
+                resp.status = 412;
+                resp.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><Error><Code>PreconditionFailed</Code></Error>";
+                return;
+            }
+            size_t start = std::stoul(it->second.substr(6));
+            resp.status = 206;
+            resp.body = content_.substr(start);
+            resp.headers["Content-Range"] = "bytes " + std::to_string(start) + "-" +
+                std::to_string(content_.size() - 1) + "/" + std::to_string(content_.size());
+        }
+        else {
+            resp.body = content_;
+        }
+        if (static_cast<int>(index) <= truncate) {
+            resp.truncateAt = static_cast<long>(resp.body.size() / 3);
+        }
+    }
+
+    static ClientConfiguration Conf()
+    {
+        ClientConfiguration conf;
+        conf.retryStrategy = std::make_shared<FastRetry>();
+        return conf;
+    }
+
+    class FastRetry : public RetryStrategy
+    {
+    public:
+        bool shouldRetry(const Error &error, long attemptedRetries) const override
+        {
+            return attemptedRetries < 3 && error.Status() >= ERROR_CURL_BASE;
+        }
+        long calcDealyTimeMs(const Error &, long) const override { return 1; }
+    };
+
+    std::string content_;
+    std::string crc64_;
+    std::mutex lock_;
+    std::vector<LocalServer::Request> requests_;
+};
+
+TEST_F(ResumeGetTest, ResumeFromReceivedByteTest)
+{
+    LocalServer server([this](const LocalServer::Request &req, LocalServer::Response &resp) {
+        Serve(req, resp, 2, "\"etag-1\"");
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject("bucket", "key");
+    ASSERT_TRUE(outcome.isSuccess());
+
+    std::stringstream ss;
+    ss << outcome.result().Content()->rdbuf();
+    EXPECT_EQ(ss.str(), content_);
+    EXPECT_EQ(outcome.result().Metadata().ContentLength(), static_cast<int64_t>(content_.size()));
+
+    //100000 bytes, cut at 1/3 of each response
+    ASSERT_EQ(requests_.size(), 3U);
+    EXPECT_EQ(requests_[0].headers.count("Range"), 0U);
+    EXPECT_EQ(requests_[1].headers["Range"], "bytes=33333-");
+    EXPECT_EQ(requests_[1].headers["If-Match"], "\"etag-1\"");
+    EXPECT_EQ(requests_[2].headers["Range"], "bytes=55555-");
+}
+
+TEST_F(ResumeGetTest, ResumeToUserStreamTest)
+{
+    LocalServer server([this](const LocalServer::Request &req, LocalServer::Response &resp) {
+        Serve(req, resp, 1, "\"etag-1\"");
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto stream = std::make_shared<std::stringstream>();
+    *stream << "prefix";
+    int created = 0;
+    GetObjectRequest request("bucket", "key");
+    request.setResponseStreamFactory([&]() { created++; return stream; });
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject(request);
+    ASSERT_TRUE(outcome.isSuccess());
+    EXPECT_EQ(created, 1);
+    EXPECT_EQ(stream->str(), "prefix" + content_);
+}
+
+TEST_F(ResumeGetTest, ObjectChangedRestartTest)
+{
+    std::atomic<int> count(0);
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        //the etag changes after the first response
+        Serve(req, resp, 1, count++ == 0 ? "\"etag-1\"" : "\"etag-2\"");
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject("bucket", "key");
+    ASSERT_TRUE(outcome.isSuccess());
+
+    std::stringstream ss;
+    ss << outcome.result().Content()->rdbuf();
+    EXPECT_EQ(ss.str(), content_);
+    ASSERT_EQ(requests_.size(), 3U);
+    EXPECT_EQ(requests_[1].headers.count("Range"), 1U);
+    EXPECT_EQ(requests_[2].headers.count("Range"), 0U);
+}
+
+TEST_F(ResumeGetTest, RangeIgnoredRestartTest)
+{
+    int count = 0;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        requests_.push_back(req);
+        resp.headers["ETag"] = "\"etag-1\"";
+        resp.headers["x-oss-hash-crc64ecma"] = crc64_;
+        resp.body = content_;
+        if (count++ == 0) {
+            resp.truncateAt = 1000;
+        }
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject("bucket", "key");
+    ASSERT_TRUE(outcome.isSuccess());
+
+    std::stringstream ss;
+    ss << outcome.result().Content()->rdbuf();
+    EXPECT_EQ(ss.str(), content_);
+    //the whole object of the second response is kept, not downloaded again
+    EXPECT_EQ(requests_.size(), 2U);
+}
+
+TEST_F(ResumeGetTest, RangeIgnoredThenTruncatedTest)
+{
+    int count = 0;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        requests_.push_back(req);
+        resp.headers["ETag"] = "\"etag-1\"";
+        resp.headers["x-oss-hash-crc64ecma"] = crc64_;
+        resp.body = content_;
+        if (count == 0) {
+            resp.truncateAt = 1000;
+        }
+        else if (count == 1) {
+            resp.truncateAt = 5000;
+        }
+        else if (req.headers.count("Range") != 0) {
+            size_t start = std::stoul(req.headers.at("Range").substr(6));
+            resp.status = 206;
+            resp.body = content_.substr(start);
+            resp.headers["Content-Range"] = "bytes " + std::to_string(start) + "-" +
+                std::to_string(content_.size() - 1) + "/" + std::to_string(content_.size());
+        }
+        count++;
+    });
+    ASSERT_TRUE(server.Start());
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject("bucket", "key");
+    ASSERT_TRUE(outcome.isSuccess());
+
+    std::stringstream ss;
+    ss << outcome.result().Content()->rdbuf();
+    EXPECT_EQ(ss.str(), content_);
+    ASSERT_EQ(requests_.size(), 3U);
+    EXPECT_EQ(requests_[1].headers.at("Range"), "bytes=1000-");
+    EXPECT_EQ(requests_[2].headers.at("Range"), "bytes=5000-");
+}
+
+TEST_F(ResumeGetTest, UserRangeIsNotResumedTest)
+{
+    LocalServer server([this](const LocalServer::Request &req, LocalServer::Response &resp) {
+        Serve(req, resp, 1, "\"etag-1\"");
+    });
+    ASSERT_TRUE(server.Start());
+
+    GetObjectRequest request("bucket", "key");
+    request.setRange(0, 999);
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject(request);
+    ASSERT_TRUE(outcome.isSuccess());
+    ASSERT_EQ(requests_.size(), 2U);
+    EXPECT_EQ(requests_[1].headers["Range"], "bytes=0-999");
+    EXPECT_EQ(requests_[1].headers.count("If-Match"), 0U);
+}
+
+TEST_F(ResumeGetTest, FinalFailureRewindTest)
+{
+    LocalServer server([this](const LocalServer::Request &req, LocalServer::Response &resp) {
+        Serve(req, resp, 100, "\"etag-1\"");
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto stream = std::make_shared<std::stringstream>();
+    *stream << "prefix";
+    GetObjectRequest request("bucket", "key");
+    request.setResponseStreamFactory([&]() { return stream; });
+
+    OssClient client(server.Endpoint(), "ak", "sk", Conf());
+    auto outcome = client.GetObject(request);
+    EXPECT_FALSE(outcome.isSuccess());
+    EXPECT_EQ(requests_.size(), 4U);
+    EXPECT_EQ(static_cast<int64_t>(stream->tellp()), 6);
+}
+
+}
+}
+#endif
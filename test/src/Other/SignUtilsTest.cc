@@ -0,0 +1,143 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <src/utils/SignUtils.h>
+#include <src/utils/Utils.h>
+#include <alibabacloud/oss/http/HttpType.h>
+#include <sstream>
+#include <set>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+//the stringstream based canonicalizer SignUtils used to be
+static std::string ReferenceBuild(const std::string &method, const std::string &resource, const std::string &date,
+    const HeaderCollection &headers, const ParameterCollection &parameters)
+{
+    static const std::set<std::string> toSign =
+    {
+        "acl", "location", "bucketInfo", "stat", "referer", "cors", "website", "restore",
+        "logging", "symlink", "qos", "uploadId", "uploads", "partNumber",
+        "response-content-type", "response-content-language", "response-expires",
+        "response-cache-control", "response-content-disposition", "response-content-encoding",
+        "append", "position", "lifecycle", "delete", "live", "status", "comp", "vod",
+        "startTime", "endTime", "x-oss-process", "security-token", "objectMeta"
+    };
+    std::stringstream ss;
+    ss << method << "\n";
+    if (headers.find(Http::CONTENT_MD5) != headers.end()) {
+        ss << headers.at(Http::CONTENT_MD5);
+    }
+    ss << "\n";
+    if (headers.find(Http::CONTENT_TYPE) != headers.end()) {
+        ss << headers.at(Http::CONTENT_TYPE);
+    }
+    ss << "\n" << date << "\n";
+    for (const auto &header : headers) {
+        std::string lower = Trim(ToLower(header.first.c_str()).c_str());
+        if (lower.compare(0, 6, "x-oss-", 6) == 0) {
+            ss << lower << ":" << Trim(header.second.c_str()) << "\n";
+        }
+    }
+    ss << resource;
+    char separator = '?';
+    for (auto const& param : parameters) {
+        if (toSign.find(param.first) == toSign.end()) {
+            continue;
+        }
+        ss << separator << param.first;
+        if (!param.second.empty()) {
+            ss << "=" << param.second;
+        }
+        separator = '&';
+    }
+    return ss.str();
+}
+
+static HeaderCollection SampleHeaders()
+{
+    HeaderCollection headers;
+    headers[Http::CONTENT_MD5] = "eB5eJF1ptWaXm4bijSPyxw==";
+    headers[Http::CONTENT_TYPE] = "text/html";
+    headers[Http::DATE] = "Thu, 17 Nov 2005 18:49:58 GMT";
+    headers["X-OSS-Meta-Author"] = " foo@bar.com ";
+    headers["x-oss-magic"] = "abracadabra";
+    headers["x-oss"] = "not an oss header";
+    headers["X-Oss-Security-Token"] = "token";
+    headers["Host"] = "bucket.oss-cn-hangzhou.aliyuncs.com";
+    return headers;
+}
+
+static ParameterCollection SampleParameters()
+{
+    ParameterCollection parameters;
+    parameters["acl"] = "";
+    parameters["uploadId"] = "0004B9895DBBB6EC98E36";
+    parameters["partNumber"] = "1";
+    parameters["response-content-type"] = "text/plain";
+    parameters["max-keys"] = "100";
+    parameters["x-oss-process"] = "image/resize,w_100";
+    parameters["Acl"] = "";
+    return parameters;
+}
+
+TEST(SignUtilsTest, CanonicalStringTest)
+{
+    SignUtils signUtils("1.0");
+    auto headers = SampleHeaders();
+    auto parameters = SampleParameters();
+    signUtils.build("PUT", "/bucket/key", "Thu, 17 Nov 2005 18:49:58 GMT", headers, parameters);
+    EXPECT_EQ(signUtils.CanonicalString(),
+        "PUT\neB5eJF1ptWaXm4bijSPyxw==\ntext/html\nThu, 17 Nov 2005 18:49:58 GMT\n"
+        "x-oss-magic:abracadabra\nx-oss-meta-author:foo@bar.com\nx-oss-security-token:token\n"
+        "/bucket/key?acl&partNumber=1&response-content-type=text/plain&uploadId=0004B9895DBBB6EC98E36"
+        "&x-oss-process=image/resize,w_100");
+    EXPECT_EQ(signUtils.CanonicalString(),
+        ReferenceBuild("PUT", "/bucket/key", "Thu, 17 Nov 2005 18:49:58 GMT", headers, parameters));
+}
+
+TEST(SignUtilsTest, SignableParametersTest)
+{
+    const char *names[] = {
+        "acl", "location", "bucketInfo", "stat", "referer", "cors", "website", "restore",
+        "logging", "symlink", "qos", "uploadId", "uploads", "partNumber",
+        "response-content-type", "response-content-language", "response-expires",
+        "response-cache-control", "response-content-disposition", "response-content-encoding",
+        "append", "position", "lifecycle", "delete", "live", "status", "comp", "vod",
+        "startTime", "endTime", "x-oss-process", "security-token", "objectMeta",
+        "", "a", "zzz", "ACL", "statu", "statuss", "uploadid", "prefix", "marker", "max-keys"
+    };
+    HeaderCollection headers;
+    for (auto name : names) {
+        ParameterCollection parameters;
+        parameters[name] = "v";
+        SignUtils signUtils("1.0");
+        signUtils.build("GET", "/bucket/", "", headers, parameters);
+        EXPECT_EQ(signUtils.CanonicalString(), ReferenceBuild("GET", "/bucket/", "", headers, parameters)) << name;
+    }
+}
+
+TEST(SignUtilsTest, EmptyTest)
+{
+    SignUtils signUtils("1.0");
+    signUtils.build("GET", "/", "", HeaderCollection(), ParameterCollection());
+    EXPECT_EQ(signUtils.CanonicalString(), "GET\n\n\n\n/");
+}
+
+}
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <src/auth/HmacSha1Signer.h>
+#include <openssl/hmac.h>
+#include <openssl/evp.h>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <alibabacloud/oss/OssClient.h>
+#include "../LocalServer.h"
+#include <mutex>
+#endif
+
+namespace AlibabaCloud {
+namespace OSS {
+
+//the one-shot HMAC the signer used to call
+static std::string OneShotSign(const std::string &src, const std::string &secret)
+{
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int mdLen = EVP_MAX_MD_SIZE;
+    HMAC(EVP_sha1(), secret.c_str(), static_cast<int>(secret.size()),
+        reinterpret_cast<const unsigned char*>(src.c_str()), src.size(), md, &mdLen);
+    char encodedData[100];
+    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encodedData), md, mdLen);
+    return encodedData;
+}
+
+TEST(SignerTest, HmacSha1VectorTest)
+{
+    HmacSha1Signer signer;
+    //RFC 2202, test case 2 and 6
+    EXPECT_EQ(signer.generate("what do ya want for nothing?", "Jefe"), "7/zfauXrL6LSdBbV8YTfnCWafHk=");
+    EXPECT_EQ(signer.generate("Test Using Larger Than Block-Size Key - Hash Key First", std::string(80, '\xaa')),
+        "qkrl4VJy0A6VcFY3zoo7Ve1AIRI=");
+    EXPECT_EQ(signer.generate("", "Jefe"), "");
+}
+
+TEST(SignerTest, KeySwitchTest)
+{
+    HmacSha1Signer signer;
+    std::vector<std::string> secrets;
+    for (int i = 0; i < 7; i++) {
+        secrets.push_back("secret-" + std::to_string(i) + std::string(i * 11, 'k'));
+    }
+    for (int round = 0; round < 3; round++) {
+        for (const auto &secret : secrets) {
+            std::string src = "GET\n\n\nThu, 01 Jan 2026 00:00:00 GMT\n/bucket/" + secret;
+            EXPECT_EQ(signer.generate(src, secret), OneShotSign(src, secret));
+        }
+    }
+}
+
+TEST(SignerTest, MultiThreadTest)
+{
+    HmacSha1Signer signer;
+    std::vector<std::thread> threads;
+    std::vector<int> mismatch(8, 0);
+    for (int t = 0; t < 8; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::string secret = "secret-" + std::to_string(t % 3);
+            for (int i = 0; i < 500; i++) {
+                std::string src = "PUT\n\n\n" + std::to_string(i);
+                if (signer.generate(src, secret) != OneShotSign(src, secret)) {
+                    mismatch[t]++;
+                }
+            }
+        }));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (auto m : mismatch) {
+        EXPECT_EQ(m, 0);
+    }
+}
+
+#ifndef _WIN32
+TEST(SignerTest, SignatureCacheTest)
+{
+    std::mutex lock;
+    std::vector<std::pair<std::string, std::string>> signatures;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        std::lock_guard<std::mutex> locker(lock);
+        signatures.push_back(std::make_pair(req.headers.at("Date"), req.headers.at("Authorization")));
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableSignatureCache = true;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(client.HeadObject("bucket", i % 2 ? "key-1" : "key-2").isSuccess());
+    }
+
+    ASSERT_EQ(signatures.size(), 10U);
+    for (size_t i = 0; i < signatures.size(); i++) {
+        std::string src = "HEAD\n\napplication/xml\n" + signatures[i].first + "\n/bucket/" + (i % 2 ? "key-1" : "key-2");
+        EXPECT_EQ(signatures[i].second, "OSS ak:" + OneShotSign(src, "sk"));
+    }
+}
+
+class RotatingCredentialsProvider : public CredentialsProvider
+{
+public:
+    RotatingCredentialsProvider() : snapshot_(std::make_shared<const Credentials>("ak", "sk-1")) {}
+    virtual Credentials getCredentials() override { return *snapshot_; }
+    virtual std::shared_ptr<const Credentials> getCredentialsSnapshot() override { return snapshot_; }
+    void rotate(const std::string &secret) { snapshot_ = std::make_shared<const Credentials>("ak", secret); }
+private:
+    std::shared_ptr<const Credentials> snapshot_;
+};
+
+//hands out a new snapshot on each call, as the default getCredentialsSnapshot does
+class CopyingCredentialsProvider : public CredentialsProvider
+{
+public:
+    CopyingCredentialsProvider() : credentials_("ak", "sk-1") {}
+    virtual Credentials getCredentials() override { return credentials_; }
+    void rotate(const std::string &secret) { credentials_ = Credentials("ak", secret); }
+private:
+    Credentials credentials_;
+};
+
+template<typename Provider>
+static void RunKeyRotation()
+{
+    std::mutex lock;
+    std::vector<std::pair<std::string, std::string>> signatures;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        std::lock_guard<std::mutex> locker(lock);
+        signatures.push_back(std::make_pair(req.headers.at("Date"), req.headers.at("Authorization")));
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableSignatureCache = true;
+    auto provider = std::make_shared<Provider>();
+    OssClient client(server.Endpoint(), provider, conf);
+    const std::string secrets[] = { "sk-1", "sk-2", "sk-2", "sk-1", "sk-1" };
+    for (int i = 0; i < 5; i++) {
+        provider->rotate(secrets[i]);
+        EXPECT_TRUE(client.HeadObject("bucket", "key").isSuccess());
+    }
+
+    //the same key id and usually the same second, the new secret must still be used
+    ASSERT_EQ(signatures.size(), 5U);
+    for (size_t i = 0; i < signatures.size(); i++) {
+        std::string src = "HEAD\n\napplication/xml\n" + signatures[i].first + "\n/bucket/key";
+        EXPECT_EQ(signatures[i].second, "OSS ak:" + OneShotSign(src, secrets[i]));
+    }
+}
+
+TEST(SignerTest, SignatureCacheKeyRotationTest)
+{
+    RunKeyRotation<RotatingCredentialsProvider>();
+    RunKeyRotation<CopyingCredentialsProvider>();
+}
+#endif
+
+}
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/TraceSampler.h>
+#include <alibabacloud/oss/client/Error.h>
+#include <src/utils/Utils.h>
+#include "../LocalServer.h"
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+class RecordingTraceSampler : public TraceSampler
+{
+public:
+    RecordingTraceSampler(double sampleRate, long latencyThresholdMs, long minStatusCode) :
+        TraceSampler(sampleRate, latencyThresholdMs, minStatusCode)
+    {}
+
+    void emit(const Sample &sample, const std::string &trace) override
+    {
+        std::lock_guard<std::mutex> locker(lock);
+        samples.push_back(sample);
+        traces.push_back(trace);
+    }
+
+    std::mutex lock;
+    std::vector<Sample> samples;
+    std::vector<std::string> traces;
+};
+
+static std::shared_ptr<OssClient> NewClient(const LocalServer &server, const std::shared_ptr<TraceSampler> &sampler)
+{
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.traceSampler = sampler;
+    return std::make_shared<OssClient>(server.Endpoint(), "ak", "sk", conf);
+}
+
+TEST(TraceSamplerTest, SampleRateTest)
+{
+    TraceSampler none(0.0);
+    TraceSampler all(1.0);
+    TraceSampler quarter(0.25);
+    int captured = 0;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_FALSE(none.shouldCapture());
+        EXPECT_TRUE(all.shouldCapture());
+        captured += quarter.shouldCapture() ? 1 : 0;
+    }
+    EXPECT_EQ(captured, 25);
+}
+
+TEST(TraceSamplerTest, ShouldEmitTest)
+{
+    TraceSampler sampler(1.0, 100, 500);
+    TraceSampler::Sample sample;
+    sample.method = Http::Get;
+    sample.statusCode = 200;
+    sample.latencyMs = 10;
+    EXPECT_FALSE(sampler.shouldEmit(sample));
+    sample.latencyMs = 100;
+    EXPECT_TRUE(sampler.shouldEmit(sample));
+    sample.latencyMs = 10;
+    sample.statusCode = 503;
+    EXPECT_TRUE(sampler.shouldEmit(sample));
+    sample.statusCode = ERROR_CURL_BASE + 28;
+    EXPECT_TRUE(sampler.shouldEmit(sample));
+
+    TraceSampler statusOnly(1.0, -1, 404);
+    sample.statusCode = 200;
+    sample.latencyMs = 100000;
+    EXPECT_FALSE(statusOnly.shouldEmit(sample));
+}
+
+TEST(TraceSamplerTest, EmitOnStatusTest)
+{
+    LocalServer server([](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (req.path.find("missing") != std::string::npos) {
+            resp.status = 404;
+        }
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto sampler = std::make_shared<RecordingTraceSampler>(1.0, -1, 400);
+    auto client = NewClient(server, sampler);
+    EXPECT_TRUE(client->HeadObject(HeadObjectRequest("bucket", "present")).isSuccess());
+    EXPECT_FALSE(client->HeadObject(HeadObjectRequest("bucket", "missing")).isSuccess());
+
+    ASSERT_EQ(sampler->samples.size(), 1U);
+    EXPECT_EQ(sampler->samples[0].statusCode, 404);
+    EXPECT_EQ(sampler->samples[0].method, Http::Head);
+    EXPECT_NE(sampler->samples[0].url.find("missing"), std::string::npos);
+
+    const std::string &trace = sampler->traces[0];
+    EXPECT_NE(trace.find("> HEAD /bucket/missing"), std::string::npos);
+    EXPECT_NE(trace.find("< HTTP/1.1 404 "), std::string::npos);
+    EXPECT_NE(trace.find("Authorization: ***"), std::string::npos);
+    EXPECT_EQ(trace.find("OSS ak:"), std::string::npos);
+    EXPECT_EQ(trace.find('\r'), std::string::npos);
+}
+
+TEST(TraceSamplerTest, EmitOnLatencyTest)
+{
+    LocalServer server([](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (req.path.find("slow") != std::string::npos) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto sampler = std::make_shared<RecordingTraceSampler>(1.0, 150, 0);
+    auto client = NewClient(server, sampler);
+    EXPECT_TRUE(client->HeadObject(HeadObjectRequest("bucket", "fast")).isSuccess());
+    EXPECT_TRUE(client->HeadObject(HeadObjectRequest("bucket", "slow")).isSuccess());
+
+    ASSERT_EQ(sampler->samples.size(), 1U);
+    EXPECT_GE(sampler->samples[0].latencyMs, 150L);
+    EXPECT_NE(sampler->traces[0].find("> HEAD /bucket/slow"), std::string::npos);
+}
+
+TEST(TraceSamplerTest, PresignedUrlMaskedTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 404;
+    });
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    auto sampler = std::make_shared<RecordingTraceSampler>(1.0, -1, 400);
+    conf.traceSampler = sampler;
+    OssClient client(server.Endpoint(), "presign-ak", "presign-sk", "presign-token", conf);
+    auto url = client.GeneratePresignedUrl("bucket", "key", 4102444800);
+    ASSERT_TRUE(url.isSuccess());
+    auto signature = UrlDecode(url.result().substr(url.result().find("Signature=") + 10));
+    EXPECT_FALSE(client.GetObjectByUrl(url.result()).isSuccess());
+
+    ASSERT_EQ(sampler->samples.size(), 1U);
+    for (auto const &text : { sampler->samples[0].url, sampler->traces[0] }) {
+        EXPECT_NE(text.find("Signature=***"), std::string::npos) << text;
+        EXPECT_NE(text.find("OSSAccessKeyId=***"), std::string::npos) << text;
+        EXPECT_NE(text.find("security-token=***"), std::string::npos) << text;
+        EXPECT_NE(text.find("Expires=4102444800"), std::string::npos) << text;
+        EXPECT_EQ(text.find("presign-ak"), std::string::npos) << text;
+        EXPECT_EQ(text.find("presign-token"), std::string::npos) << text;
+        EXPECT_EQ(text.find(signature), std::string::npos) << text;
+    }
+    EXPECT_NE(sampler->traces[0].find("> GET /bucket/key?"), std::string::npos);
+}
+
+static std::atomic<int> TraceRecords(0);
+static std::atomic<size_t> LongestTraceRecord(0);
+
+static void TraceLogCallback(LogLevel, const std::string &stream)
+{
+    if (stream.find("[TraceSampler]") == std::string::npos) {
+        return;
+    }
+    TraceRecords++;
+    if (stream.size() > LongestTraceRecord) {
+        LongestTraceRecord = stream.size();
+    }
+}
+
+TEST(TraceSamplerTest, EmitRecordsTest)
+{
+    std::string trace;
+    for (int i = 0; trace.size() < 8 * 1024; i++) {
+        trace.append("< x-oss-meta-key").append(std::to_string(i)).append(": ").append(100, 'v').append("\n");
+    }
+    trace.append("> ").append(5000, 'l').append("\n");
+    TraceSampler::Sample sample;
+    sample.method = Http::Get;
+    sample.url = "http://bucket.oss-cn-hangzhou.aliyuncs.com/key";
+    sample.statusCode = 503;
+    sample.latencyMs = 10;
+
+    SetLogLevel(LogLevel::LogWarn);
+    SetLogCallback(TraceLogCallback);
+    TraceRecords = 0;
+    LongestTraceRecord = 0;
+    TraceSampler().emit(sample, trace);
+    FlushLog();
+    SetLogLevel(LogLevel::LogOff);
+    SetLogCallback(nullptr);
+
+    //the summary, then the 13KB of lines in records of at most 2KB
+    EXPECT_GE(TraceRecords, 8);
+    EXPECT_LE(TraceRecords, 9);
+    EXPECT_LE(LongestTraceRecord, 2200U);
+}
+
+TEST(TraceSamplerTest, NotSampledTest)
+{
+    LocalServer server([](const LocalServer::Request &, LocalServer::Response &resp) {
+        resp.status = 404;
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto sampler = std::make_shared<RecordingTraceSampler>(0.0, 0, 400);
+    auto client = NewClient(server, sampler);
+    EXPECT_FALSE(client->HeadObject(HeadObjectRequest("bucket", "missing")).isSuccess());
+    EXPECT_TRUE(sampler->samples.empty());
+}
+
+}
+}
+#endif
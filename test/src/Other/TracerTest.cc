@@ -0,0 +1,252 @@
+/*
+ * Copyright 2009-2017 Alibaba Cloud All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <alibabacloud/oss/OssClient.h>
+#include <alibabacloud/oss/client/Tracer.h>
+#include <alibabacloud/oss/client/RetryStrategy.h>
+#include "../LocalServer.h"
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <mutex>
+
+namespace AlibabaCloud {
+namespace OSS {
+
+TEST(TracerTest, TraceParentTest)
+{
+    SpanContext context;
+    EXPECT_FALSE(context.isValid());
+    EXPECT_TRUE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", context));
+    EXPECT_EQ(context.traceId, "4bf92f3577b34da6a3ce929d0e0e4736");
+    EXPECT_EQ(context.spanId, "00f067aa0ba902b7");
+    EXPECT_EQ(context.traceFlags, 1);
+    EXPECT_TRUE(context.isValid());
+    EXPECT_EQ(context.toTraceParent(), "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+
+    //later versions may carry more fields
+    EXPECT_TRUE(SpanContext::FromTraceParent("01-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00-extra", context));
+    EXPECT_EQ(context.traceFlags, 0);
+
+    SpanContext untouched;
+    EXPECT_FALSE(SpanContext::FromTraceParent("", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("00-00000000000000000000000000000000-00f067aa0ba902b7-01", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-extra", untouched));
+    EXPECT_FALSE(SpanContext::FromTraceParent("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", untouched));
+    EXPECT_FALSE(untouched.isValid());
+}
+
+#ifndef _WIN32
+struct RecordedSpan
+{
+    std::string name;
+    SpanContext parent;
+    SpanContext context;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    std::map<std::string, std::string> attributes;
+    bool ended;
+};
+
+class RecordingTracer : public Tracer
+{
+public:
+    class RecordingSpan : public Span
+    {
+    public:
+        RecordingSpan(RecordingTracer *tracer, size_t index) : tracer_(tracer), index_(index) {}
+        const SpanContext &context() const override { return context_; }
+        void setAttribute(const std::string &key, const std::string &value) override
+        {
+            std::lock_guard<std::mutex> locker(tracer_->lock);
+            tracer_->spans[index_].attributes[key] = value;
+        }
+        void end(std::chrono::steady_clock::time_point endTime) override
+        {
+            std::lock_guard<std::mutex> locker(tracer_->lock);
+            tracer_->spans[index_].end = endTime;
+            tracer_->spans[index_].ended = true;
+        }
+        SpanContext context_;
+    private:
+        RecordingTracer *tracer_;
+        size_t index_;
+    };
+
+    explicit RecordingTracer(bool propagate) : Tracer(propagate), nextId(1) {}
+
+    std::shared_ptr<Span> startSpan(const std::string &name, const SpanContext &parent,
+        std::chrono::steady_clock::time_point startTime) override
+    {
+        std::lock_guard<std::mutex> locker(lock);
+        char id[17];
+        snprintf(id, sizeof(id), "%016x", nextId++);
+        RecordedSpan recorded;
+        recorded.name = name;
+        recorded.parent = parent;
+        recorded.context.traceId = parent.isValid() ? parent.traceId : "0af7651916cd43dd8448eb211c80319c";
+        recorded.context.spanId = id;
+        recorded.context.traceFlags = 1;
+        recorded.start = startTime;
+        recorded.ended = false;
+        spans.push_back(recorded);
+        auto span = std::make_shared<RecordingSpan>(this, spans.size() - 1);
+        span->context_ = recorded.context;
+        return span;
+    }
+
+    std::vector<const RecordedSpan *> named(const std::string &name)
+    {
+        std::vector<const RecordedSpan *> result;
+        for (auto const &span : spans) {
+            if (span.name == name) {
+                result.push_back(&span);
+            }
+        }
+        return result;
+    }
+
+    std::mutex lock;
+    std::vector<RecordedSpan> spans;
+    unsigned nextId;
+};
+
+class NoDelayRetryStrategy : public RetryStrategy
+{
+public:
+    bool shouldRetry(const Error &error, long attemptedRetries) const override
+    {
+        return attemptedRetries < 2 && error.Status() >= 500 && error.Status() < 600;
+    }
+    long calcDealyTimeMs(const Error &, long) const override { return 0; }
+};
+
+TEST(TracerTest, RequestSpansTest)
+{
+    std::mutex lock;
+    std::string traceParent;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        std::lock_guard<std::mutex> locker(lock);
+        auto it = req.headers.find("traceparent");
+        traceParent = it == req.headers.end() ? "" : it->second;
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto tracer = std::make_shared<RecordingTracer>(true);
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.tracer = tracer;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+
+    HeadObjectRequest request("bucket", "key");
+    SpanContext parent;
+    ASSERT_TRUE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", parent));
+    request.setTraceContext(parent);
+    EXPECT_TRUE(client.HeadObject(request).isSuccess());
+
+    auto requests = tracer->named("oss.request");
+    auto attempts = tracer->named("oss.attempt");
+    ASSERT_EQ(requests.size(), 1U);
+    ASSERT_EQ(attempts.size(), 1U);
+    EXPECT_EQ(requests[0]->parent.spanId, parent.spanId);
+    EXPECT_EQ(requests[0]->context.traceId, parent.traceId);
+    EXPECT_EQ(requests[0]->attributes.at("http.method"), "HEAD");
+    EXPECT_EQ(requests[0]->attributes.at("http.status_code"), "200");
+    EXPECT_EQ(requests[0]->attributes.at("oss.attempts"), "1");
+    EXPECT_EQ(attempts[0]->parent.spanId, requests[0]->context.spanId);
+    EXPECT_EQ(attempts[0]->attributes.at("oss.attempt"), "0");
+    EXPECT_EQ(traceParent, attempts[0]->context.toTraceParent());
+
+    for (auto name : { "oss.sign", "oss.pool_wait", "oss.transfer" }) {
+        auto phases = tracer->named(name);
+        ASSERT_EQ(phases.size(), 1U) << name;
+        EXPECT_EQ(phases[0]->parent.spanId, attempts[0]->context.spanId) << name;
+        EXPECT_TRUE(phases[0]->ended) << name;
+        EXPECT_GE(phases[0]->start, attempts[0]->start) << name;
+        EXPECT_LE(phases[0]->end, attempts[0]->end) << name;
+    }
+    for (auto const &span : tracer->spans) {
+        EXPECT_TRUE(span.ended) << span.name;
+        EXPECT_LE(span.start, span.end) << span.name;
+    }
+}
+
+TEST(TracerTest, RetrySpansTest)
+{
+    std::atomic<int> count(0);
+    std::string traceParent;
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        if (count++ < 2) {
+            resp.status = 503;
+        }
+        if (req.headers.count("traceparent")) {
+            traceParent = req.headers.at("traceparent");
+        }
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    auto tracer = std::make_shared<RecordingTracer>(false);
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    conf.tracer = tracer;
+    conf.retryStrategy = std::make_shared<NoDelayRetryStrategy>();
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    EXPECT_TRUE(client.HeadObject(HeadObjectRequest("bucket", "key")).isSuccess());
+
+    auto requests = tracer->named("oss.request");
+    auto attempts = tracer->named("oss.attempt");
+    ASSERT_EQ(requests.size(), 1U);
+    ASSERT_EQ(attempts.size(), 3U);
+    EXPECT_EQ(tracer->named("oss.retry_wait").size(), 2U);
+    EXPECT_EQ(tracer->named("oss.transfer").size(), 3U);
+    EXPECT_FALSE(requests[0]->parent.isValid());
+    EXPECT_EQ(requests[0]->attributes.at("oss.attempts"), "3");
+    EXPECT_EQ(attempts[0]->attributes.at("http.status_code"), "503");
+    EXPECT_EQ(attempts[0]->attributes.at("error.code"), "ServerError:503");
+    EXPECT_EQ(attempts[2]->attributes.at("oss.attempt"), "2");
+    EXPECT_EQ(attempts[2]->attributes.at("http.status_code"), "200");
+    EXPECT_TRUE(traceParent.empty());
+}
+
+TEST(TracerTest, NoTracerTest)
+{
+    std::string traceParent = "unset";
+    LocalServer server([&](const LocalServer::Request &req, LocalServer::Response &resp) {
+        traceParent = req.headers.count("traceparent") ? req.headers.at("traceparent") : "";
+        resp.headers["ETag"] = "\"etag-1\"";
+    });
+    ASSERT_TRUE(server.Start());
+
+    ClientConfiguration conf;
+    conf.enableCrc64 = false;
+    OssClient client(server.Endpoint(), "ak", "sk", conf);
+    HeadObjectRequest request("bucket", "key");
+    SpanContext parent;
+    ASSERT_TRUE(SpanContext::FromTraceParent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", parent));
+    request.setTraceContext(parent);
+    EXPECT_TRUE(client.HeadObject(request).isSuccess());
+    EXPECT_TRUE(traceParent.empty());
+}
+#endif
+
+}
+}
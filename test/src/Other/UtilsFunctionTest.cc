@@ -20,6 +20,9 @@
 #include "../Config.h"
 #include "../Utils.h"
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <openssl/evp.h>
 #include "src/utils/FileSystemUtils.h"
 
 namespace AlibabaCloud {
@@ -94,6 +97,50 @@ TEST_F(UtilsFunctionTest, UrlDecodeTest)
     EXPECT_TRUE((i == urlPat.size()));
 }
 
+static std::string ReferenceUrlEncode(const std::string &src)
+{
+    std::stringstream dest;
+    static const char *hex = "0123456789ABCDEF";
+    for (size_t i = 0; i < src.size(); i++) {
+        unsigned char c = src[i];
+        if (isalnum(c) || (c == '-') || (c == '_') || (c == '.') || (c == '~')) {
+            dest << c;
+        } else {
+            dest << '%' << hex[c >> 4] << hex[c & 15];
+        }
+    }
+    return dest.str();
+}
+
+TEST_F(UtilsFunctionTest, UrlEncodeAllBytesTest)
+{
+    //every byte value at every offset of a 16 bytes block
+    std::string all;
+    for (int c = 0; c < 256; c++) {
+        all.push_back(static_cast<char>(c));
+    }
+    for (size_t shift = 0; shift < 17; shift++) {
+        std::string src = std::string(shift, 'a') + all + std::string(40, 'Z') + all;
+        EXPECT_EQ(UrlEncode(src), ReferenceUrlEncode(src));
+        EXPECT_EQ(UrlDecode(UrlEncode(src)), src);
+    }
+
+    std::string dest("prefix/");
+    UrlEncode("a b", 3, dest);
+    EXPECT_EQ(dest, "prefix/a%20b");
+    EXPECT_EQ(UrlEncode(""), "");
+}
+
+TEST_F(UtilsFunctionTest, UrlDecodeMalformedTest)
+{
+    EXPECT_EQ(UrlDecode("%"), "%");
+    EXPECT_EQ(UrlDecode("abc%4"), "abc%4");
+    EXPECT_EQ(UrlDecode("%zz%41"), "%zzA");
+    EXPECT_EQ(UrlDecode("100%"), "100%");
+    EXPECT_EQ(UrlDecode("%e4%B8%ad"), "\xe4\xb8\xad");
+    EXPECT_EQ(UrlDecode(std::string("a%00b", 5)), std::string("a\0b", 3));
+}
+
 TEST_F(UtilsFunctionTest, ToStorageClassNameTest)
 {
     EXPECT_STREQ(ToStorageClassName(StorageClass::Standard), "Standard");
@@ -245,13 +292,132 @@ TEST_F(UtilsFunctionTest, ToGmtTimeTest)
 
 TEST_F(UtilsFunctionTest, LookupMimeTypeTest)
 {
-    EXPECT_STREQ(LookupMimeType("name.html").c_str(), "text/html");
-    EXPECT_STREQ(LookupMimeType("test.mp3").c_str(), "audio/mpeg");
-    EXPECT_STREQ(LookupMimeType("test.mp3.unkonw").c_str(), "audio/mpeg");
-    EXPECT_STREQ(LookupMimeType("test.mp3.unkonw.unkonw").c_str(), "application/octet-stream");
-    EXPECT_STREQ(LookupMimeType("unkonw").c_str(), "application/octet-stream");
-    EXPECT_STREQ(LookupMimeType("name.Html").c_str(), "text/html");
-    EXPECT_STREQ(LookupMimeType("test.Mp3.unkonw").c_str(), "audio/mpeg");
+    EXPECT_STREQ(LookupMimeType("name.html"), "text/html");
+    EXPECT_STREQ(LookupMimeType("test.mp3"), "audio/mpeg");
+    EXPECT_STREQ(LookupMimeType("test.mp3.unkonw"), "audio/mpeg");
+    EXPECT_STREQ(LookupMimeType("test.mp3.unkonw.unkonw"), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("unkonw"), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("name.Html"), "text/html");
+    EXPECT_STREQ(LookupMimeType("test.Mp3.unkonw"), "audio/mpeg");
+}
+
+TEST_F(UtilsFunctionTest, LookupMimeTypeTableTest)
+{
+    static const std::vector<std::pair<std::string, std::string>> table =
+    {
+        {"html", "text/html"},
+        {"htm", "text/html"},
+        {"shtml", "text/html"},
+        {"css", "text/css"},
+        {"xml", "text/xml"},
+        {"gif", "image/gif"},
+        {"jpeg", "image/jpeg"},
+        {"jpg", "image/jpeg"},
+        {"js", "application/x-javascript"},
+        {"atom", "application/atom+xml"},
+        {"rss", "application/rss+xml"},
+        {"mml", "text/mathml"},
+        {"txt", "text/plain"},
+        {"jad", "text/vnd.sun.j2me.app-descriptor"},
+        {"wml", "text/vnd.wap.wml"},
+        {"htc", "text/x-component"},
+        {"png", "image/png"},
+        {"tif", "image/tiff"},
+        {"tiff", "image/tiff"},
+        {"wbmp", "image/vnd.wap.wbmp"},
+        {"ico", "image/x-icon"},
+        {"jng", "image/x-jng"},
+        {"bmp", "image/x-ms-bmp"},
+        {"svg", "image/svg+xml"},
+        {"svgz", "image/svg+xml"},
+        {"webp", "image/webp"},
+        {"jar", "application/java-archive"},
+        {"war", "application/java-archive"},
+        {"ear", "application/java-archive"},
+        {"hqx", "application/mac-binhex40"},
+        {"doc", "application/msword"},
+        {"pdf", "application/pdf"},
+        {"ps", "application/postscript"},
+        {"eps", "application/postscript"},
+        {"ai", "application/postscript"},
+        {"rtf", "application/rtf"},
+        {"xls", "application/vnd.ms-excel"},
+        {"ppt", "application/vnd.ms-powerpoint"},
+        {"wmlc", "application/vnd.wap.wmlc"},
+        {"kml", "application/vnd.google-earth.kml+xml"},
+        {"kmz", "application/vnd.google-earth.kmz"},
+        {"7z", "application/x-7z-compressed"},
+        {"cco", "application/x-cocoa"},
+        {"jardiff", "application/x-java-archive-diff"},
+        {"jnlp", "application/x-java-jnlp-file"},
+        {"run", "application/x-makeself"},
+        {"pl", "application/x-perl"},
+        {"pm", "application/x-perl"},
+        {"prc", "application/x-pilot"},
+        {"pdb", "application/x-pilot"},
+        {"rar", "application/x-rar-compressed"},
+        {"rpm", "application/x-redhat-package-manager"},
+        {"sea", "application/x-sea"},
+        {"swf", "application/x-shockwave-flash"},
+        {"sit", "application/x-stuffit"},
+        {"tcl", "application/x-tcl"},
+        {"tk", "application/x-tcl"},
+        {"der", "application/x-x509-ca-cert"},
+        {"pem", "application/x-x509-ca-cert"},
+        {"crt", "application/x-x509-ca-cert"},
+        {"xpi", "application/x-xpinstall"},
+        {"xhtml", "application/xhtml+xml"},
+        {"zip", "application/zip"},
+        {"wgz", "application/x-nokia-widget"},
+        {"bin", "application/octet-stream"},
+        {"exe", "application/octet-stream"},
+        {"dll", "application/octet-stream"},
+        {"deb", "application/octet-stream"},
+        {"dmg", "application/octet-stream"},
+        {"eot", "application/octet-stream"},
+        {"iso", "application/octet-stream"},
+        {"img", "application/octet-stream"},
+        {"msi", "application/octet-stream"},
+        {"msp", "application/octet-stream"},
+        {"msm", "application/octet-stream"},
+        {"mid", "audio/midi"},
+        {"midi", "audio/midi"},
+        {"kar", "audio/midi"},
+        {"mp3", "audio/mpeg"},
+        {"ogg", "audio/ogg"},
+        {"m4a", "audio/x-m4a"},
+        {"ra", "audio/x-realaudio"},
+        {"3gpp", "video/3gpp"},
+        {"3gp", "video/3gpp"},
+        {"mp4", "video/mp4"},
+        {"mpeg", "video/mpeg"},
+        {"mpg", "video/mpeg"},
+        {"mov", "video/quicktime"},
+        {"webm", "video/webm"},
+        {"flv", "video/x-flv"},
+        {"m4v", "video/x-m4v"},
+        {"mng", "video/x-mng"},
+        {"asx", "video/x-ms-asf"},
+        {"asf", "video/x-ms-asf"},
+        {"wmv", "video/x-ms-wmv"},
+        {"avi", "video/x-msvideo"},
+        {"ts", "video/MP2T"},
+        {"m3u8", "application/x-mpegURL"},
+        {"apk", "application/vnd.android.package-archive"},
+    };
+    for (auto const &entry : table) {
+        EXPECT_STREQ(LookupMimeType("dir/file." + entry.first), entry.second.c_str()) << entry.first;
+        EXPECT_STREQ(LookupMimeType("FILE." + ToUpper(entry.first.c_str())), entry.second.c_str()) << entry.first;
+        EXPECT_STREQ(LookupMimeType("file." + entry.first + ".unknown"), entry.second.c_str()) << entry.first;
+    }
+
+    EXPECT_STREQ(LookupMimeType(".html"), "text/html");
+    EXPECT_STREQ(LookupMimeType("file.htm"), "text/html");
+    EXPECT_STREQ(LookupMimeType("file.htmlx"), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("file.ht"), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("file."), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("."), "application/octet-stream");
+    EXPECT_STREQ(LookupMimeType("file.\xe4\xb8\xad"), "application/octet-stream");
 }
 
 struct Md5TestData {
@@ -466,6 +632,61 @@ TEST_F(UtilsFunctionTest, Base64EncodeUrlSafeTest)
 
 }
 
+TEST_F(UtilsFunctionTest, Base64DecodeTest)
+{
+    std::vector<std::string> ori = { "abc" , "abcd" , "abcde", "" };
+    std::vector<std::string> pat = { "YWJj" , "YWJjZA==" , "YWJjZGU=", ""};
+    std::vector<std::string> urlSafePat = { "YWJj" , "YWJjZA" , "YWJjZGU", ""};
+
+    for (size_t i = 0; i < ori.size(); i++) {
+        EXPECT_EQ(Base64Decode(pat[i]), ori[i]);
+        EXPECT_EQ(Base64DecodeUrlSafe(urlSafePat[i]), ori[i]);
+        EXPECT_EQ(Base64DecodeUrlSafe(pat[i]), ori[i]);
+    }
+
+    const unsigned char buff[] = { 0x14, 0xFB, 0x9C, 0x03, 0xD9, 0x7E };
+    EXPECT_EQ(Base64DecodeUrlSafe("FPucA9l-"), std::string((const char *)buff, sizeof(buff)));
+    EXPECT_EQ(Base64Decode("FPucA9l+"), std::string((const char *)buff, sizeof(buff)));
+
+    //not valid
+    std::string dest("keep");
+    EXPECT_FALSE(Base64Decode("YWJjZA", 6, dest));
+    EXPECT_FALSE(Base64Decode("FPucA9l-", 8, dest));
+    EXPECT_FALSE(Base64DecodeUrlSafe("FPucA9l+", 8, dest));
+    EXPECT_FALSE(Base64Decode("YW=j", 4, dest));
+    EXPECT_FALSE(Base64Decode("Y===", 4, dest));
+    EXPECT_FALSE(Base64DecodeUrlSafe("YWJjZ", 5, dest));
+    EXPECT_EQ(dest, "keep");
+    EXPECT_TRUE(Base64Decode("YWJj", 4, dest));
+    EXPECT_EQ(dest, "keepabc");
+}
+
+TEST_F(UtilsFunctionTest, Base64AllLengthsTest)
+{
+    //every length around the 12 bytes steps of the vector path
+    std::string src;
+    for (int len = 0; len < 200; len++) {
+        std::string expected(4 * ((src.size() + 2) / 3) + 1, '\0');
+        int n = EVP_EncodeBlock(reinterpret_cast<unsigned char *>(&expected[0]),
+            reinterpret_cast<const unsigned char *>(src.data()), static_cast<int>(src.size()));
+        expected.resize(n);
+
+        auto encoded = Base64Encode(src);
+        EXPECT_EQ(encoded, expected);
+        EXPECT_EQ(Base64Decode(encoded), src);
+
+        auto urlSafe = Base64EncodeUrlSafe(src);
+        std::string urlSafeExpected = expected;
+        while (!urlSafeExpected.empty() && *urlSafeExpected.rbegin() == '=') urlSafeExpected.pop_back();
+        std::replace(urlSafeExpected.begin(), urlSafeExpected.end(), '+', '-');
+        std::replace(urlSafeExpected.begin(), urlSafeExpected.end(), '/', '_');
+        EXPECT_EQ(urlSafe, urlSafeExpected);
+        EXPECT_EQ(Base64DecodeUrlSafe(urlSafe), src);
+
+        src.push_back(static_cast<char>(len * 37 + 11));
+    }
+}
+
 TEST_F(UtilsFunctionTest, StringReplaceTest)
 {
     std::string test = "1234abcdABCD1234";
@@ -474,5 +695,29 @@ TEST_F(UtilsFunctionTest, StringReplaceTest)
     EXPECT_EQ(test, "1234AABCD1234");
 }
 
+TEST_F(UtilsFunctionTest, CurrentGmtTimeTest)
+{
+    for (int i = 0; i < 3; i++) {
+        std::time_t before = std::time(nullptr);
+        std::string date = CurrentGmtTime();
+        std::time_t after = std::time(nullptr);
+        EXPECT_TRUE(date == ToGmtTime(before) || date == ToGmtTime(after)) << date;
+        EXPECT_EQ(date.size(), 29U);
+        EXPECT_EQ(&CurrentGmtTime(), &CurrentGmtTime());
+    }
+
+    std::time_t t = 0;
+    EXPECT_EQ(ToGmtTime(t), "Thu, 01 Jan 1970 00:00:00 GMT");
+}
+
+TEST_F(UtilsFunctionTest, MaskUrlCredentialsTest)
+{
+    EXPECT_EQ(MaskUrlCredentials("http://bucket.host/key"), "http://bucket.host/key");
+    EXPECT_EQ(MaskUrlCredentials("http://bucket.host/key?OSSAccessKeyId=ak&Expires=1&Signature=c2ln%3D&security-token=tk#frag"),
+        "http://bucket.host/key?OSSAccessKeyId=***&Expires=1&Signature=***&security-token=***#frag");
+    EXPECT_EQ(MaskUrlCredentials("GET /key?acl&signature=sig HTTP/1.1"), "GET /key?acl&signature=*** HTTP/1.1");
+    EXPECT_EQ(MaskUrlCredentials("/key?x-oss-signature=sig&&Signatures=keep&"), "/key?x-oss-signature=***&&Signatures=keep&");
+}
+
 }
 }
\ No newline at end of file